@@ -0,0 +1,19 @@
+#include "benchmark.h"
+
+int main(const int argc, char** argv)
+{
+    Bench::ObjImportBenchmarks();
+    Bench::GlbImportBenchmarks();
+    Bench::MeshOptimizationBenchmarks();
+    Bench::ClusterCullingBenchmarks();
+    Bench::LodGenerationBenchmarks();
+    Bench::VertexQuantizationBenchmarks();
+    Bench::TextureCompressionBenchmarks();
+    Bench::TextureProcessingBenchmarks();
+    Bench::SceneBenchmarks();
+
+    // The first argument overrides where the results go
+    Bench::WriteJson(argc > 1 ? argv[1] : "bench_results.json");
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include "benchmark.h"
+
+#include <chrono>
+#include <cstdio>
+
+#include "../source/geometry/obj_parser.h"
+#include "../source/geometry/vertex_welding.h"
+#include "../source/utility/mapped_file.h"
+
+namespace
+{
+    std::vector<Bench::Result> printedResults;
+}
+
+double Bench::Result::GetAverageMilliseconds() const
+{
+    return iterations > 0 ? totalMilliseconds / iterations : 0.0;
+}
+
+double Bench::Result::GetMegabytesPerSecond() const
+{
+    double averageSeconds = GetAverageMilliseconds() / 1000.0;
+    return averageSeconds > 0.0 ? bytesPerIteration / (1024.0 * 1024.0) / averageSeconds : 0.0;
+}
+
+Bench::Result Bench::Measure(const std::string& name, const int iterations, const std::function<void()>& function,
+                             const double bytesPerIteration)
+{
+    function();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        function();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    return { name, iterations, elapsed.count(), bytesPerIteration };
+}
+
+void Bench::Print(const Result& result)
+{
+    printedResults.push_back(result);
+
+    if (result.bytesPerIteration > 0.0)
+        std::printf("%-48s %10.3f ms %10.1f MB/s\n", result.name.c_str(), result.GetAverageMilliseconds(), result.GetMegabytesPerSecond());
+    else
+        std::printf("%-48s %10.3f ms\n", result.name.c_str(), result.GetAverageMilliseconds());
+}
+
+bool Bench::WriteJson(const std::string& path)
+{
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr)
+    {
+        std::printf("ERROR::BENCH::JSON_NOT_WRITTEN %s\n", path.c_str());
+        return false;
+    }
+
+    std::fprintf(file, "[\n");
+    for (std::size_t i = 0; i < printedResults.size(); ++i)
+    {
+        const Result& result = printedResults[i];
+
+        std::string name;
+        for (char character : result.name)
+        {
+            if (character == '"' || character == '\\')
+                name += '\\';
+            name += character;
+        }
+
+        std::fprintf(file, "    { \"name\": \"%s\", \"iterations\": %d, \"averageMilliseconds\": %.6f, \"megabytesPerSecond\": %.3f }%s\n",
+                     name.c_str(), result.iterations, result.GetAverageMilliseconds(), result.GetMegabytesPerSecond(),
+                     i + 1 < printedResults.size() ? "," : "");
+    }
+    std::fprintf(file, "]\n");
+    std::fclose(file);
+
+    std::printf("BENCH::JSON_WRITTEN %s, %zu results\n", path.c_str(), printedResults.size());
+    return true;
+}
+
+Bench::WeldedMesh Bench::LoadWeldedMesh(const char* path)
+{
+    Utility::MappedFile file(path);
+    if (!file.IsOpen())
+    {
+        std::printf("ERROR::BENCH::ASSET_NOT_FOUND %s\n", path);
+        return {};
+    }
+
+    Geometry::ObjData data = Geometry::ObjParser::Parse(file.View());
+    Geometry::VertexWelder welder(data.positions.size());
+    WeldedMesh mesh;
+
+    for (unsigned int face = 0; face < data.GetFaceCount(); ++face)
+    {
+        unsigned int fanStartIndex = 0;
+        unsigned int previousIndex = 0;
+
+        for (unsigned int i = data.faceOffsets[face]; i < data.faceOffsets[face + 1]; ++i)
+        {
+            const Geometry::ObjCorner& corner = data.corners[i];
+            unsigned int index = welder.Add({
+                corner.position >= 0 ? data.positions[corner.position] : glm::vec3(0.0f),
+                corner.normal >= 0 ? data.normals[corner.normal] : glm::vec3(0.0f),
+                corner.textureCoordinates >= 0 ? data.textureCoordinates[corner.textureCoordinates] : glm::vec2(0.0f),
+                -1
+            });
+
+            if (i == data.faceOffsets[face])
+                fanStartIndex = index;
+            else if (i >= data.faceOffsets[face] + 2)
+                mesh.indices.insert(mesh.indices.end(), { fanStartIndex, previousIndex, index });
+
+            previousIndex = index;
+        }
+    }
+
+    mesh.vertices = std::move(welder.vertices);
+    return mesh;
+}
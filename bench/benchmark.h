@@ -0,0 +1,48 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../source/geometry/geometry_structs.h"
+
+namespace Bench
+{
+    struct Result
+    {
+        std::string name;
+        int iterations;
+        double totalMilliseconds;
+        double bytesPerIteration;
+
+        double GetAverageMilliseconds() const;
+        double GetMegabytesPerSecond() const;
+    };
+
+    // Runs function once to warm caches, then times the given number of iterations
+    Result Measure(const std::string& name, int iterations, const std::function<void()>& function, double bytesPerIteration = 0.0);
+    // Prints the result and keeps it for WriteJson
+    void Print(const Result& result);
+    // Every printed result as a JSON array, so runs can be compared over time
+    bool WriteJson(const std::string& path);
+
+    struct WeldedMesh
+    {
+        std::vector<Geometry::Vertex> vertices;
+        std::vector<unsigned int> indices;
+    };
+
+    // Welded and triangulated like Model::ImportObj, without materials or the optimization passes. Empty when
+    // the file is missing
+    WeldedMesh LoadWeldedMesh(const char* path);
+
+    void ObjImportBenchmarks();
+    void GlbImportBenchmarks();
+    void SceneBenchmarks();
+    void MeshOptimizationBenchmarks();
+    void ClusterCullingBenchmarks();
+    void LodGenerationBenchmarks();
+    void VertexQuantizationBenchmarks();
+    void TextureCompressionBenchmarks();
+    void TextureProcessingBenchmarks();
+}
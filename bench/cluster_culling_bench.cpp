@@ -0,0 +1,92 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../source/geometry/cluster_culler.h"
+#include "../source/geometry/mesh_optimization.h"
+#include "../source/geometry/meshlet.h"
+
+namespace
+{
+    struct CameraPose
+    {
+        const char* name;
+        // Camera position and target in units of the mesh's bounding radius, relative to its centre
+        glm::vec3 position;
+        glm::vec3 target;
+    };
+
+    // Fixed so the culled counts can be compared between runs
+    constexpr CameraPose CAMERA_POSES[] = {
+        { "front, whole mesh", glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f) },
+        { "side, whole mesh", glm::vec3(3.0f, 0.5f, 0.0f), glm::vec3(0.0f) },
+        { "close to the surface", glm::vec3(0.0f, 0.2f, 1.3f), glm::vec3(0.0f, 0.2f, 0.0f) },
+        { "edge of the view", glm::vec3(2.0f, 0.0f, 2.0f), glm::vec3(2.0f, 0.0f, 0.0f) },
+        { "looking away", glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f, 0.0f, 6.0f) },
+    };
+}
+
+void Bench::ClusterCullingBenchmarks()
+{
+    std::printf("Cluster culling, %u vertices and %u triangles per meshlet\n", Geometry::Meshlets::MAX_VERTICES,
+                Geometry::Meshlets::MAX_TRIANGLES);
+
+    for (const char* path : { "assets/models/planet/planet.obj", "assets/shapes/ico_sphere.obj", "assets/shapes/suzanne.obj" })
+    {
+        Bench::WeldedMesh mesh = Bench::LoadWeldedMesh(path);
+        if (mesh.vertices.empty())
+            continue;
+
+        // Meshlets are cut from the optimized order, as they are for loaded models
+        Geometry::MeshOptimization::Optimize(mesh.vertices, mesh.indices);
+        std::vector<Geometry::Meshlet> meshlets = Geometry::Meshlets::Build(mesh.vertices, mesh.indices);
+        Geometry::MeshletBounds bounds = Geometry::Meshlets::ComputeBounds(meshlets, mesh.vertices, mesh.indices);
+
+        glm::vec3 minimum = mesh.vertices.front().position, maximum = minimum;
+        for (const Geometry::Vertex& vertex : mesh.vertices)
+        {
+            minimum = glm::min(minimum, vertex.position);
+            maximum = glm::max(maximum, vertex.position);
+        }
+        glm::vec3 center = (minimum + maximum) * 0.5f;
+        float radius = glm::length(maximum - center);
+
+        // Cones too wide to cull with are disabled by a cutoff of one, padding lanes included
+        std::size_t coneCount = std::count_if(bounds.coneCutoff.begin(), bounds.coneCutoff.begin() + meshlets.size(),
+                                              [](float cutoff) { return cutoff < 1.0f; });
+        float radiusSum = 0.0f;
+        for (std::size_t i = 0; i < meshlets.size(); ++i)
+            radiusSum += bounds.radius[i];
+
+        std::printf("%s, %zu meshlets from %zu triangles, %zu with a cone, average radius %.3f of the mesh's\n", path,
+                    meshlets.size(), mesh.indices.size() / 3, coneCount, radiusSum / static_cast<float>(meshlets.size()) / radius);
+
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.01f * radius, 100.0f * radius);
+        std::vector<unsigned char> visibility;
+        Geometry::ClusterCuller culler;
+
+        for (const CameraPose& pose : CAMERA_POSES)
+        {
+            culler.SetView(glm::lookAt(center + pose.position * radius, center + pose.target * radius, glm::vec3(0.0f, 1.0f, 0.0f)), projection);
+            culler.ResetStats();
+
+            std::size_t visibleCount = culler.Cull(bounds, meshlets.size(), glm::mat4(1.0f), visibility);
+            Geometry::ClusterCullingStats stats = culler.GetStats();
+
+            std::printf("    %-44s %4zu visible, %4zu off screen, %4zu back-facing\n", pose.name, visibleCount,
+                        stats.frustumCulledCount, stats.backfaceCulledCount);
+        }
+
+        culler.SetView(glm::lookAt(center + CAMERA_POSES[0].position * radius, center, glm::vec3(0.0f, 1.0f, 0.0f)), projection);
+        Bench::Print(Bench::Measure(std::string(path) + " cull x1000", 10, [&]
+        {
+            for (int i = 0; i < 1000; ++i)
+                culler.Cull(bounds, meshlets.size(), glm::mat4(1.0f), visibility);
+        }));
+    }
+}
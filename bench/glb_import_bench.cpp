@@ -0,0 +1,111 @@
+#include "benchmark.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../source/geometry/glb_importer.h"
+#include "../source/utility/mapped_file.h"
+
+namespace
+{
+    void AppendUint32(std::string& data, const std::uint32_t value)
+    {
+        char bytes[sizeof(value)];
+        std::memcpy(bytes, &value, sizeof(value));
+        data.append(bytes, sizeof(bytes));
+    }
+
+    // Interleaved positions, normals and texture coordinates in one buffer view, 32-bit indices in another
+    std::string CreateGlb(const Bench::WeldedMesh& mesh)
+    {
+        constexpr std::size_t VERTEX_STRIDE = 8 * sizeof(float);
+
+        std::string bin;
+        for (const Geometry::Vertex& vertex : mesh.vertices)
+        {
+            float attributes[] = { vertex.position.x, vertex.position.y, vertex.position.z,
+                                   vertex.normal.x, vertex.normal.y, vertex.normal.z,
+                                   vertex.textureCoordinates.x, 1.0f - vertex.textureCoordinates.y };
+            bin.append(reinterpret_cast<const char*>(attributes), sizeof(attributes));
+        }
+        std::size_t indexOffset = bin.size();
+        bin.append(reinterpret_cast<const char*>(mesh.indices.data()), mesh.indices.size() * sizeof(unsigned int));
+
+        std::string vertexCount = std::to_string(mesh.vertices.size());
+        std::string json = "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}],"
+            "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},\"indices\":3}]}],"
+            "\"buffers\":[{\"byteLength\":" + std::to_string(bin.size()) + "}],"
+            "\"bufferViews\":[{\"buffer\":0,\"byteLength\":" + std::to_string(indexOffset) + ",\"byteStride\":" + std::to_string(VERTEX_STRIDE) + "},"
+            "{\"buffer\":0,\"byteOffset\":" + std::to_string(indexOffset) + ",\"byteLength\":" + std::to_string(bin.size() - indexOffset) + "}],"
+            "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":" + vertexCount + ",\"type\":\"VEC3\"},"
+            "{\"bufferView\":0,\"byteOffset\":12,\"componentType\":5126,\"count\":" + vertexCount + ",\"type\":\"VEC3\"},"
+            "{\"bufferView\":0,\"byteOffset\":24,\"componentType\":5126,\"count\":" + vertexCount + ",\"type\":\"VEC2\"},"
+            "{\"bufferView\":1,\"componentType\":5125,\"count\":" + std::to_string(mesh.indices.size()) + ",\"type\":\"SCALAR\"}]}";
+
+        // Chunks are padded to 4 bytes, JSON with spaces
+        json.append((4 - json.size() % 4) % 4, ' ');
+        bin.append((4 - bin.size() % 4) % 4, '\0');
+
+        std::string glb;
+        AppendUint32(glb, Geometry::GlbImporter::MAGIC);
+        AppendUint32(glb, Geometry::GlbImporter::VERSION);
+        AppendUint32(glb, static_cast<std::uint32_t>(12 + 8 + json.size() + 8 + bin.size()));
+        AppendUint32(glb, static_cast<std::uint32_t>(json.size()));
+        AppendUint32(glb, Geometry::GlbImporter::JSON_CHUNK);
+        glb += json;
+        AppendUint32(glb, static_cast<std::uint32_t>(bin.size()));
+        AppendUint32(glb, Geometry::GlbImporter::BIN_CHUNK);
+        glb += bin;
+
+        return glb;
+    }
+}
+
+void Bench::GlbImportBenchmarks()
+{
+    for (const char* path : { "assets/models/planet/planet.obj", "assets/models/rock/rock.obj", "assets/models/floor/floor.obj" })
+    {
+        Bench::WeldedMesh mesh = Bench::LoadWeldedMesh(path);
+        if (mesh.vertices.empty())
+            continue;
+
+        // The same mesh as binary glTF, written next to the temporary files so the importer maps a real file
+        std::string glbPath = (std::filesystem::temp_directory_path() / "mars_engine_bench.glb").string();
+        {
+            std::ofstream glbFile(glbPath, std::ios::binary | std::ios::trunc);
+            std::string glb = CreateGlb(mesh);
+            glbFile.write(glb.data(), static_cast<std::streamsize>(glb.size()));
+        }
+
+        // Normals come back normalized and texture coordinates round-trip through the flip between the two conventions
+        Geometry::ModelData imported = Geometry::GlbImporter::Read(glbPath.c_str());
+        bool isIdentical = imported.vertices.size() == mesh.vertices.size() && imported.indices == mesh.indices;
+        for (std::size_t i = 0; isIdentical && i < mesh.vertices.size(); ++i)
+        {
+            isIdentical = imported.vertices[i].position == mesh.vertices[i].position
+                       && glm::length(imported.vertices[i].normal - glm::normalize(mesh.vertices[i].normal)) <= 1e-6f
+                       && glm::length(imported.vertices[i].textureCoordinates - mesh.vertices[i].textureCoordinates) <= 1e-6f;
+        }
+
+        Utility::MappedFile objFile(path);
+        auto glbSize = static_cast<double>(std::filesystem::file_size(glbPath));
+        std::printf("%s, %zu vertices, %zu KB as OBJ, %zu KB as GLB, %s\n", path, mesh.vertices.size(), objFile.Size() / 1024,
+                    static_cast<std::size_t>(glbSize) / 1024, isIdentical ? "GLB matches OBJ" : "GLB DIFFERS FROM OBJ");
+
+        Bench::Print(Bench::Measure(std::string(path) + " OBJ parse and weld", 10, [path]
+        {
+            Bench::LoadWeldedMesh(path);
+        }, static_cast<double>(objFile.Size())));
+        Bench::Print(Bench::Measure(std::string(path) + " GLB read", 10, [&glbPath]
+        {
+            Geometry::GlbImporter::Read(glbPath.c_str());
+        }, glbSize));
+
+        std::filesystem::remove(glbPath);
+    }
+}
@@ -0,0 +1,39 @@
+#include "benchmark.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../source/geometry/mesh_optimization.h"
+#include "../source/geometry/mesh_simplification.h"
+
+void Bench::LodGenerationBenchmarks()
+{
+    std::printf("Level of detail generation, up to %zu levels\n", Geometry::MeshSimplification::MAX_LOD_COUNT);
+
+    for (const char* path : { "assets/shapes/ico_sphere.obj", "assets/shapes/suzanne.obj", "assets/models/planet/planet.obj",
+                              "assets/models/rock/rock.obj" })
+    {
+        Bench::WeldedMesh mesh = Bench::LoadWeldedMesh(path);
+        if (mesh.vertices.empty())
+            continue;
+
+        // Levels are generated from the optimized order, as they are for loaded models
+        Geometry::MeshOptimization::Optimize(mesh.vertices, mesh.indices);
+        std::size_t fullDetailIndexCount = mesh.indices.size();
+
+        std::vector<unsigned int> indices = mesh.indices;
+        std::vector<Geometry::MeshLod> lods = Geometry::MeshSimplification::GenerateLods(mesh.vertices, indices);
+
+        std::printf("%s, %zu vertices\n", path, mesh.vertices.size());
+        for (std::size_t level = 0; level < lods.size(); ++level)
+            std::printf("%-48s %8u triangles, error %.5f\n", ("    level " + std::to_string(level)).c_str(),
+                        lods[level].indexCount / 3, lods[level].error);
+
+        Bench::Print(Bench::Measure(std::string(path) + " generate", 3, [&]
+        {
+            indices.resize(fullDetailIndexCount);
+            Geometry::MeshSimplification::GenerateLods(mesh.vertices, indices);
+        }));
+    }
+}
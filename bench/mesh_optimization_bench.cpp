@@ -0,0 +1,45 @@
+#include "benchmark.h"
+
+#include <cstdio>
+#include <string>
+
+#include "../source/geometry/mesh_optimization.h"
+
+namespace
+{
+    // Asteroids SpaceScene draws per frame with one instanced draw
+    constexpr double ASTEROID_INSTANCE_COUNT = 200000.0;
+}
+
+void Bench::MeshOptimizationBenchmarks()
+{
+    std::printf("Mesh optimization, vertex shader runs for %.0f instances\n", ASTEROID_INSTANCE_COUNT);
+
+    for (const char* path : { "assets/shapes/suzanne.obj", "assets/shapes/ico_sphere.obj", "assets/models/rock/rock.obj" })
+    {
+        Bench::WeldedMesh imported = Bench::LoadWeldedMesh(path);
+        if (imported.vertices.empty())
+            continue;
+
+        Bench::WeldedMesh optimized;
+
+        Bench::Print(Bench::Measure(std::string(path) + " optimize", 10, [&imported, &optimized]
+        {
+            optimized = imported;
+            Geometry::MeshOptimization::Optimize(optimized.vertices, optimized.indices);
+        }));
+
+        Geometry::VertexCacheStatistics before = Geometry::MeshOptimization::AnalyzeVertexCache(imported.indices, imported.vertices.size());
+        Geometry::VertexCacheStatistics after = Geometry::MeshOptimization::AnalyzeVertexCache(optimized.indices, optimized.vertices.size());
+
+        double triangleCount = static_cast<double>(imported.indices.size() / 3);
+        double shaderRunsBefore = before.acmr * triangleCount * ASTEROID_INSTANCE_COUNT;
+        double shaderRunsAfter = after.acmr * triangleCount * ASTEROID_INSTANCE_COUNT;
+
+        std::printf("%-48s %5.3f -> %5.3f\n", "    ACMR", before.acmr, after.acmr);
+        std::printf("%-48s %5.3f -> %5.3f\n", "    ATVR", before.atvr, after.atvr);
+        std::printf("%-48s %10.1fM\n", "    vertex shader runs before", shaderRunsBefore / 1.0e6);
+        std::printf("%-48s %10.1fM\n", "    vertex shader runs after", shaderRunsAfter / 1.0e6);
+        std::printf("%-48s %10.2fx\n", "    reduction", shaderRunsBefore / shaderRunsAfter);
+    }
+}
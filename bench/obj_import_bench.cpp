@@ -0,0 +1,102 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../source/geometry/obj_parser.h"
+#include "../source/utility/mapped_file.h"
+#include "../source/utility/thread_pool.h"
+
+namespace
+{
+    // Grid of quads standing in for a production-sized model
+    std::string CreateGridObj(const int size)
+    {
+        std::string obj;
+        obj.reserve(static_cast<std::size_t>(size) * size * 80);
+
+        for (int z = 0; z <= size; ++z)
+            for (int x = 0; x <= size; ++x)
+                obj += "v " + std::to_string(x * 0.01f) + " 0.000000 " + std::to_string(z * 0.01f) + "\n";
+
+        obj += "vn 0.0000 1.0000 0.0000\nvt 0.000000 0.000000\n";
+
+        for (int z = 0; z < size; ++z)
+        {
+            for (int x = 0; x < size; ++x)
+            {
+                int corner = z * (size + 1) + x + 1;
+                obj += "f " + std::to_string(corner) + "/1/1 " + std::to_string(corner + 1) + "/1/1 "
+                     + std::to_string(corner + size + 2) + "/1/1 " + std::to_string(corner + size + 1) + "/1/1\n";
+            }
+        }
+
+        return obj;
+    }
+
+    void MeasureThreadScaling(const std::string& name, const std::string_view source, const int iterations)
+    {
+        std::vector<unsigned int> threadCounts;
+        unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned int threadCount = 1; threadCount < maxThreads; threadCount *= 2)
+            threadCounts.push_back(threadCount);
+        threadCounts.push_back(maxThreads);
+
+        double singleThreadedMilliseconds = 0.0;
+
+        for (unsigned int threadCount : threadCounts)
+        {
+            Bench::Result result;
+
+            if (threadCount == 1)
+            {
+                result = Bench::Measure(name + " x1", iterations, [source]
+                {
+                    Geometry::ObjParser::Parse(source);
+                }, static_cast<double>(source.size()));
+                singleThreadedMilliseconds = result.GetAverageMilliseconds();
+            }
+            else
+            {
+                // The calling thread parses a chunk as well, so the pool gets one worker less
+                Utility::ThreadPool threadPool(threadCount - 1);
+                result = Bench::Measure(name + " x" + std::to_string(threadCount), iterations, [source, &threadPool, threadCount]
+                {
+                    Geometry::ObjParser::ParseParallel(source, threadPool, threadCount);
+                }, static_cast<double>(source.size()));
+            }
+
+            Bench::Print(result);
+            std::printf("%-48s %10.2fx\n", "    speedup", singleThreadedMilliseconds / result.GetAverageMilliseconds());
+        }
+    }
+}
+
+void Bench::ObjImportBenchmarks()
+{
+    std::printf("OBJ import thread scaling\n");
+
+    for (const char* path : { "assets/shapes/ico_sphere.obj", "assets/shapes/suzanne.obj" })
+    {
+        Utility::MappedFile file(path);
+        if (!file.IsOpen())
+        {
+            std::printf("ERROR::BENCH::ASSET_NOT_FOUND %s\n", path);
+            continue;
+        }
+
+        MeasureThreadScaling(path, file.View(), 20);
+
+        // Tokenizing plus what Model::ImportObj does with the tokens, fan triangulation and welding
+        Bench::Print(Bench::Measure(std::string(path) + " parse, triangulate and weld", 20, [path]
+        {
+            Bench::LoadWeldedMesh(path);
+        }, static_cast<double>(file.Size())));
+    }
+
+    std::string grid = CreateGridObj(700);
+    MeasureThreadScaling("synthetic grid (490k quads)", grid, 3);
+}
@@ -0,0 +1,141 @@
+#include "benchmark.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../source/scenes/scene_layout.h"
+#include "../source/shading/lighting/view_space.h"
+#include "../source/shading/uniform_name.h"
+
+namespace
+{
+    // ResourceManager's material and point light limits
+    constexpr int MATERIAL_COUNT = 64;
+    constexpr int POINT_LIGHT_COUNT = 64;
+
+    constexpr int FRAMES_PER_ITERATION = 1000;
+
+    void MaterialLookupBenchmarks(std::mt19937& randomEngine)
+    {
+        std::vector<std::string> materialNames;
+        for (int i = 0; i < MATERIAL_COUNT; ++i)
+            materialNames.push_back("Material." + std::to_string(i));
+
+        // usemtl groups of a large model, resolved the way Model::ImportObj does
+        std::uniform_int_distribution materialDist(0, MATERIAL_COUNT - 1);
+        std::vector<std::string_view> groupNames(100000);
+        for (std::string_view& groupName : groupNames)
+            groupName = materialNames[materialDist(randomEngine)];
+
+        std::vector<int> groupMaterialIndices;
+        Bench::Print(Bench::Measure("material lookup, 100k usemtl groups", 20, [&]
+        {
+            std::unordered_map<std::string_view, int> materialIndices;
+            for (int i = 0; i < MATERIAL_COUNT; ++i)
+                materialIndices.emplace(materialNames[i], i);
+
+            groupMaterialIndices.clear();
+            for (std::string_view groupName : groupNames)
+            {
+                auto material = materialIndices.find(groupName);
+                groupMaterialIndices.push_back(material != materialIndices.end() ? material->second : -1);
+            }
+        }));
+
+        // Uniform names ResourceManager::ApplyMaterials hashes for every material and shader
+        std::uint64_t nameHashes = 0;
+        Bench::Print(Bench::Measure("material uniform names, 64 materials", 1000, [&nameHashes]
+        {
+            constexpr Shading::UniformName materials = "materials";
+            for (unsigned int i = 0; i < MATERIAL_COUNT; ++i)
+            {
+                Shading::UniformName material = materials[i];
+                for (const char* field : { "ambientColor", "diffuseColor", "specularColor", "emissiveColor", "shininess",
+                                           "diffuseMap", "hasDiffuseMap", "specularMap", "hasSpecularMap" })
+                    nameHashes ^= material.Member(field).GetHash();
+            }
+        }));
+    }
+
+    void LightBenchmarks(std::mt19937& randomEngine)
+    {
+        std::uniform_real_distribution positionDist(-50.0f, 50.0f);
+        std::vector<Shading::Lighting::PointLight> pointLights(POINT_LIGHT_COUNT);
+        for (Shading::Lighting::PointLight& pointLight : pointLights)
+            pointLight.position = glm::vec4(positionDist(randomEngine), positionDist(randomEngine), positionDist(randomEngine), 1.0f);
+
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 5.0f, 40.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        Shading::Lighting::DirectionalLight directionalLight
+        {
+            glm::vec4(0.33f, -1.0f, 0.3f, 0.0f),
+            glm::vec4(glm::vec3(0.2f), 1.0f),
+            glm::vec4(1.0f),
+            glm::vec4(1.0f)
+        };
+
+        // LightManager::GetViewSpacePointLights copies the lights and transforms the active ones every frame
+        Bench::Print(Bench::Measure("64 point lights to view space, 1000 frames", 20, [&]
+        {
+            for (int frame = 0; frame < FRAMES_PER_ITERATION; ++frame)
+            {
+                std::vector<Shading::Lighting::PointLight> viewSpacePointLights = pointLights;
+                Shading::Lighting::ViewSpace::TransformPointLights(viewSpacePointLights, view);
+            }
+        }, static_cast<double>(FRAMES_PER_ITERATION * POINT_LIGHT_COUNT * sizeof(Shading::Lighting::PointLight))));
+
+        Bench::Print(Bench::Measure("directional light to view space, 1000 frames", 20, [&]
+        {
+            for (int frame = 0; frame < FRAMES_PER_ITERATION; ++frame)
+                Shading::Lighting::ViewSpace::TransformDirectionalLight(directionalLight, view);
+        }));
+    }
+
+    void AsteroidBenchmarks(std::mt19937& randomEngine)
+    {
+        // The space scene's ring
+        Bench::Print(Bench::Measure("asteroid ring matrices, 200k instances", 5, [&randomEngine]
+        {
+            SceneLayout::CreateAsteroidRing(200000, 120.0f, 50.0f, randomEngine);
+        }, static_cast<double>(200000 * sizeof(glm::mat4))));
+    }
+
+    void TransparentSortBenchmarks(std::mt19937& randomEngine)
+    {
+        std::uniform_real_distribution positionDist(-100.0f, 100.0f);
+        glm::vec3 cameraPosition(0.0f, 2.0f, 10.0f);
+
+        for (int objectCount : { 2, 100, 10000 })
+        {
+            std::vector<glm::vec3> positions(objectCount);
+            for (glm::vec3& position : positions)
+                position = glm::vec3(positionDist(randomEngine), positionDist(randomEngine), positionDist(randomEngine));
+
+            std::vector<glm::vec3> sorted;
+            int iterations = objectCount < 1000 ? 10000 : 100;
+            Bench::Print(Bench::Measure("transparent sort, " + std::to_string(objectCount) + " objects", iterations, [&]
+            {
+                SceneLayout::SortBackToFront(positions, cameraPosition, sorted);
+            }));
+        }
+    }
+}
+
+void Bench::SceneBenchmarks()
+{
+    std::printf("Per-frame scene work\n");
+
+    // Fixed seed, so every run measures the same data
+    std::mt19937 randomEngine(1234);
+
+    MaterialLookupBenchmarks(randomEngine);
+    LightBenchmarks(randomEngine);
+    AsteroidBenchmarks(randomEngine);
+    TransparentSortBenchmarks(randomEngine);
+}
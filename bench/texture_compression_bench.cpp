@@ -0,0 +1,221 @@
+#include "benchmark.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "stb_image.h"
+#include "../source/assets/texture_compression.h"
+#include "../source/utility/thread_pool.h"
+
+using Assets::BlockFormat;
+using Assets::CompressionQuality;
+
+namespace
+{
+    struct Image
+    {
+        std::vector<unsigned char> pixels;
+        int width = 0, height = 0, components = 0;
+    };
+
+    Image LoadImage(const char* path, const int desiredComponents)
+    {
+        Image image;
+        unsigned char* pixels = stbi_load(path, &image.width, &image.height, &image.components, desiredComponents);
+        if (pixels == nullptr)
+            return image;
+
+        if (desiredComponents != 0)
+            image.components = desiredComponents;
+
+        image.pixels.assign(pixels, pixels + static_cast<std::size_t>(image.width) * image.height * image.components);
+        stbi_image_free(pixels);
+
+        return image;
+    }
+
+    void DecodeColorBlock(const unsigned char* block, unsigned char* pixels, const int stride)
+    {
+        std::uint16_t colors[2];
+        std::uint32_t indices;
+        std::memcpy(colors, block, sizeof(colors));
+        std::memcpy(&indices, block + 4, sizeof(indices));
+
+        int palette[4][3];
+        for (int endpoint = 0; endpoint < 2; ++endpoint)
+        {
+            int red = colors[endpoint] >> 11 & 31, green = colors[endpoint] >> 5 & 63, blue = colors[endpoint] & 31;
+            palette[endpoint][0] = red << 3 | red >> 2;
+            palette[endpoint][1] = green << 2 | green >> 4;
+            palette[endpoint][2] = blue << 3 | blue >> 2;
+        }
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            palette[2][channel] = (2 * palette[0][channel] + palette[1][channel]) / 3;
+            palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel]) / 3;
+        }
+
+        for (int i = 0; i < 16; ++i)
+            for (int channel = 0; channel < 3; ++channel)
+                pixels[(i / 4) * stride + (i % 4) * 4 + channel] = static_cast<unsigned char>(palette[indices >> (2 * i) & 3][channel]);
+    }
+
+    void DecodeChannelBlock(const unsigned char* block, unsigned char* pixels, const int stride)
+    {
+        int values[8] = { block[0], block[1] };
+        for (int i = 1; i < 7; ++i)
+            values[i + 1] = block[0] > block[1] ? ((7 - i) * block[0] + i * block[1]) / 7 : ((6 - i) * block[0] + i * block[1]) / 6;
+
+        std::uint64_t indices = 0;
+        for (int i = 0; i < 6; ++i)
+            indices |= static_cast<std::uint64_t>(block[2 + i]) << (8 * i);
+
+        for (int i = 0; i < 16; ++i)
+            pixels[(i / 4) * stride + (i % 4) * 4] = static_cast<unsigned char>(values[indices >> (3 * i) & 7]);
+    }
+
+    // Root mean square error over the channels the format stores, in 8-bit units
+    double GetEncodingError(const Image& source, const std::vector<unsigned char>& encoded, const BlockFormat format)
+    {
+        int blocksX = (source.width + 3) / 4, blocksY = (source.height + 3) / 4;
+        std::size_t blockBytes = Assets::BlockCompression::GetBlockBytes(format);
+        double squaredError = 0.0;
+        std::size_t sampleCount = 0;
+
+        for (int blockY = 0; blockY < blocksY; ++blockY)
+        {
+            for (int blockX = 0; blockX < blocksX; ++blockX)
+            {
+                const unsigned char* block = encoded.data() + (static_cast<std::size_t>(blockY) * blocksX + blockX) * blockBytes;
+                unsigned char decoded[64] = {};
+
+                if (format == BlockFormat::BC1)
+                    DecodeColorBlock(block, decoded, 16);
+                else if (format == BlockFormat::BC3)
+                {
+                    DecodeChannelBlock(block, decoded + 3, 16);
+                    DecodeColorBlock(block + 8, decoded, 16);
+                }
+                else
+                {
+                    DecodeChannelBlock(block, decoded, 16);
+                    DecodeChannelBlock(block + 8, decoded + 1, 16);
+                }
+
+                int channelCount = format == BlockFormat::BC1 ? 3 : format == BlockFormat::BC3 ? 4 : 2;
+                for (int i = 0; i < 16; ++i)
+                {
+                    int x = blockX * 4 + i % 4, y = blockY * 4 + i / 4;
+                    if (x >= source.width || y >= source.height)
+                        continue;
+
+                    for (int channel = 0; channel < channelCount; ++channel)
+                    {
+                        double difference = decoded[i * 4 + channel] - source.pixels[(static_cast<std::size_t>(y) * source.width + x) * 4 + channel];
+                        squaredError += difference * difference;
+                        ++sampleCount;
+                    }
+                }
+            }
+        }
+
+        return sampleCount > 0 ? std::sqrt(squaredError / static_cast<double>(sampleCount)) : 0.0;
+    }
+
+    const char* GetQualityName(const CompressionQuality quality)
+    {
+        switch (quality)
+        {
+            case CompressionQuality::Fast:      return "fast";
+            case CompressionQuality::Balanced:  return "balanced";
+            default:                            return "high";
+        }
+    }
+}
+
+void Bench::TextureCompressionBenchmarks()
+{
+    std::printf("Texture block compression\n");
+
+    const char* encodePath = "assets/models/floor/diffuse.jpg";
+    Image image = LoadImage(encodePath, 4);
+    if (image.pixels.empty())
+    {
+        std::printf("ERROR::BENCH::ASSET_NOT_FOUND %s\n", encodePath);
+        return;
+    }
+
+    auto inputBytes = static_cast<double>(image.pixels.size());
+    Utility::ThreadPool& threadPool = Utility::ThreadPool::GetShared();
+
+    for (BlockFormat format : { BlockFormat::BC1, BlockFormat::BC3, BlockFormat::BC5 })
+    {
+        std::vector<unsigned char> encoded(Assets::BlockCompression::GetEncodedSize(image.width, image.height, format));
+        std::string formatName = Assets::BlockCompression::GetFormatName(format);
+
+        for (CompressionQuality quality : { CompressionQuality::Fast, CompressionQuality::Balanced, CompressionQuality::High })
+        {
+            std::string name = formatName + " " + GetQualityName(quality);
+
+            Result singleThreaded = Measure(name + " x1", 2, [&]
+            {
+                Assets::BlockCompression::EncodeImage(image.pixels.data(), image.width, image.height, format, quality, encoded.data(), nullptr);
+            }, inputBytes);
+            Print(singleThreaded);
+
+            Result threaded = Measure(name + " x" + std::to_string(threadPool.GetThreadCount() + 1), 2, [&]
+            {
+                Assets::BlockCompression::EncodeImage(image.pixels.data(), image.width, image.height, format, quality, encoded.data(), &threadPool);
+            }, inputBytes);
+            Print(threaded);
+
+            std::printf("%-48s %10.2f\n", "    rmse", GetEncodingError(image, encoded, format));
+        }
+    }
+
+    /*
+     * VRAM taken by the full mip chain of the engine's textures, uncompressed against block compressed
+     */
+    std::printf("Texture memory saved by block compression\n");
+
+    std::size_t totalUncompressed = 0, totalCompressed = 0;
+    for (const char* path : { "assets/models/floor/diffuse.jpg", "assets/models/planet/mars.png", "assets/models/rock/rock.png",
+                              "assets/textures/container2.png", "assets/textures/window.png", "assets/textures/ocean_mountains/back.jpg" })
+    {
+        Image source = LoadImage(path, 0);
+        if (source.pixels.empty())
+        {
+            std::printf("ERROR::BENCH::ASSET_NOT_FOUND %s\n", path);
+            continue;
+        }
+
+        std::optional<BlockFormat> format = Assets::BlockCompression::ChooseFormat(source.components, source.pixels.data(), source.width, source.height);
+        if (!format)
+            continue;
+
+        Assets::ProcessedImage processed = Assets::TextureProcessing::ProcessImage(source.pixels.data(), source.width, source.height,
+                                                                                   source.components, { false, false, true, true }, &threadPool);
+        Assets::CompressedImage compressed = Assets::BlockCompression::EncodeMipChain(processed, *format, CompressionQuality::Balanced, &threadPool);
+
+        std::size_t uncompressedBytes = 0;
+        for (const Assets::ImageLevel& level : compressed.levels)
+            uncompressedBytes += static_cast<std::size_t>(level.width) * level.height * source.components;
+
+        totalUncompressed += uncompressedBytes;
+        totalCompressed += compressed.data.size();
+
+        std::printf("%-48s %s %8zu KB -> %6zu KB (%.1fx)\n", path, Assets::BlockCompression::GetFormatName(*format),
+                    uncompressedBytes / 1024, compressed.data.size() / 1024,
+                    static_cast<double>(uncompressedBytes) / static_cast<double>(compressed.data.size()));
+    }
+
+    if (totalCompressed > 0)
+    {
+        std::printf("%-48s     %8zu KB -> %6zu KB, %zu KB saved\n", "total", totalUncompressed / 1024, totalCompressed / 1024,
+                    (totalUncompressed - totalCompressed) / 1024);
+    }
+}
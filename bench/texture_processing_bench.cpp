@@ -0,0 +1,105 @@
+#include "benchmark.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "stb_image.h"
+#include "../source/assets/texture_processing.h"
+#include "../source/utility/thread_pool.h"
+
+namespace
+{
+    float ToLinear(const unsigned char value)
+    {
+        float encoded = value / 255.0f;
+        return encoded <= 0.04045f ? encoded / 12.92f : std::pow((encoded + 0.055f) / 1.055f, 2.4f);
+    }
+
+    // Mean linear intensity of an RGBA8 sRGB image, gamma-correct filtering keeps it stable down the mip chain
+    double GetMeanIntensity(const unsigned char* pixels, const int width, const int height)
+    {
+        double sum = 0.0;
+        std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+        for (std::size_t i = 0; i < pixelCount * 4; ++i)
+        {
+            if (i % 4 != 3)
+                sum += ToLinear(pixels[i]);
+        }
+
+        return sum / static_cast<double>(pixelCount * 3);
+    }
+
+    void MeasureScaling(const std::string& name, const int iterations, const double bytes, const std::function<void(Utility::ThreadPool*)>& function)
+    {
+        Utility::ThreadPool& threadPool = Utility::ThreadPool::GetShared();
+
+        Bench::Result singleThreaded = Bench::Measure(name + " x1", iterations, [&] { function(nullptr); }, bytes);
+        Bench::Print(singleThreaded);
+
+        Bench::Result threaded = Bench::Measure(name + " x" + std::to_string(threadPool.GetThreadCount() + 1), iterations,
+                                                [&] { function(&threadPool); }, bytes);
+        Bench::Print(threaded);
+
+        std::printf("%-48s %9.2fx\n", "    speedup", singleThreaded.GetAverageMilliseconds() / threaded.GetAverageMilliseconds());
+    }
+}
+
+void Bench::TextureProcessingBenchmarks()
+{
+    std::printf("Texture processing\n");
+
+    const char* path = "assets/models/floor/diffuse.jpg";
+    int width, height, components;
+    unsigned char* pixels = stbi_load(path, &width, &height, &components, 3);
+    if (pixels == nullptr)
+    {
+        std::printf("ERROR::BENCH::ASSET_NOT_FOUND %s\n", path);
+        return;
+    }
+
+    std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+    std::vector<unsigned char> rgba(pixelCount * 4);
+    std::vector<unsigned char> scratch(rgba.size());
+
+    MeasureScaling("RGB to RGBA + flip", 5, static_cast<double>(pixelCount * 3), [&](Utility::ThreadPool* threadPool)
+    {
+        Assets::TextureProcessing::ConvertToRGBA(pixels, width, height, 3, true, rgba.data(), threadPool);
+    });
+
+    // A diagonal alpha ramp so every premultiply path does real work
+    for (std::size_t i = 0; i < pixelCount; ++i)
+        rgba[i * 4 + 3] = static_cast<unsigned char>((i % width + i / width) & 255);
+
+    for (bool isSRGB : { false, true })
+    {
+        MeasureScaling(std::string("premultiply alpha ") + (isSRGB ? "srgb" : "linear"), 5, static_cast<double>(rgba.size()),
+                       [&](Utility::ThreadPool* threadPool)
+        {
+            scratch = rgba;
+            Assets::TextureProcessing::PremultiplyAlpha(scratch.data(), width, height, isSRGB, threadPool);
+        });
+    }
+
+    for (bool isSRGB : { false, true })
+    {
+        MeasureScaling(std::string("downsample ") + (isSRGB ? "srgb" : "linear"), 5, static_cast<double>(rgba.size()),
+                       [&](Utility::ThreadPool* threadPool)
+        {
+            Assets::TextureProcessing::Downsample(rgba.data(), width, height, isSRGB, false, scratch.data(), threadPool);
+        });
+    }
+
+    Assets::ProcessedImage processed;
+    MeasureScaling("full srgb mip chain", 3, static_cast<double>(pixelCount * 3), [&](Utility::ThreadPool* threadPool)
+    {
+        processed = Assets::TextureProcessing::ProcessImage(pixels, width, height, 3, { true, false, true, true }, threadPool);
+    });
+    stbi_image_free(pixels);
+
+    const Assets::ImageLevel& first = processed.levels.front();
+    const Assets::ImageLevel& last = processed.levels.back();
+    std::printf("%-48s %10.4f\n", "    level 0 mean linear intensity", GetMeanIntensity(processed.pixels.data() + first.offset, first.width, first.height));
+    std::printf("%-48s %10.4f\n", "    1x1 level linear intensity", GetMeanIntensity(processed.pixels.data() + last.offset, last.width, last.height));
+}
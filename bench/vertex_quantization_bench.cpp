@@ -0,0 +1,40 @@
+#include "benchmark.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../source/geometry/vertex_quantization.h"
+
+void Bench::VertexQuantizationBenchmarks()
+{
+    std::printf("Vertex quantization, %zu bytes per vertex against %zu\n", sizeof(Geometry::QuantizedVertex), sizeof(Geometry::Vertex));
+
+    for (const char* path : { "assets/shapes/ico_sphere.obj", "assets/shapes/suzanne.obj", "assets/models/planet/planet.obj",
+                              "assets/models/rock/rock.obj", "assets/models/floor/floor.obj" })
+    {
+        Bench::WeldedMesh mesh = Bench::LoadWeldedMesh(path);
+        if (mesh.vertices.empty())
+            continue;
+
+        Geometry::PositionQuantization quantization = Geometry::VertexQuantization::GetPositionQuantization(mesh.vertices);
+        std::vector<Geometry::QuantizedVertex> quantizedVertices = Geometry::VertexQuantization::Quantize(mesh.vertices, quantization);
+        Geometry::QuantizationError error = Geometry::VertexQuantization::MeasureError(mesh.vertices, quantizedVertices, quantization);
+
+        float diagonal = glm::length(quantization.scale);
+        float relativePositionError = diagonal > 0.0f ? error.position / diagonal : 0.0f;
+        bool isWithinLimits = Geometry::VertexQuantization::IsWithinLimits(error, quantization);
+
+        std::printf("%s, %zu vertices, %zu KB -> %zu KB\n", path, mesh.vertices.size(),
+                    mesh.vertices.size() * sizeof(Geometry::Vertex) / 1024, quantizedVertices.size() * sizeof(Geometry::QuantizedVertex) / 1024);
+        std::printf("%-48s %.3g of the bounding box diagonal\n", "    position error", relativePositionError);
+        std::printf("%-48s %.4f degrees\n", "    normal error", error.normalDegrees);
+        std::printf("%-48s %.3g\n", "    texture coordinate error", error.textureCoordinates);
+        std::printf("%-48s %s\n", "    precision", isWithinLimits ? "within limits" : "out of limits, loads with full vertices");
+
+        Bench::Print(Bench::Measure(std::string(path) + " quantize", 20, [&]
+        {
+            quantizedVertices = Geometry::VertexQuantization::Quantize(mesh.vertices, quantization);
+        }, static_cast<double>(mesh.vertices.size() * sizeof(Geometry::Vertex))));
+    }
+}
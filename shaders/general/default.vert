@@ -3,27 +3,45 @@ layout (location = 0) in vec3 position;
 layout (location = 1) in vec3 normal;
 layout (location = 2) in vec2 textureCoordinates;
 layout (location = 3) in int materialIndex;
+#ifdef INSTANCED
+layout (location = 4) in mat4 instanceMatrix;
+#endif
 
 layout (std140) uniform Matrices
 {
     mat4 view;
     mat4 projection;
 };
+#ifndef INSTANCED
 uniform mat4 model;
 uniform mat4 lightSpaceMatrix;
+#endif
+uniform int materialOffset;
 
 out vec3 VertexNormal;
 out vec3 FragmentPosition;
+#ifndef INSTANCED
 out vec4 FragmentPositionLightSpace;
+#endif
 out vec2 TextureCoordinates;
 flat out int MaterialIndex;
 
+#include "../include/vertex_decoding.glsl"
+
 void main()
 {
-    gl_Position = projection * view * model * vec4(position, 1.0);
-    FragmentPosition = vec3(view * model * vec4(position, 1.0));
-    FragmentPositionLightSpace = lightSpaceMatrix * vec4(model * vec4(position, 1.0));
-    VertexNormal = mat3(transpose(inverse(view * model))) * normal;
+    vec3 vertexPosition = DecodePosition();
+    int vertexMaterialIndex = DecodeMaterialIndex();
+#ifdef INSTANCED
+    mat4 modelMatrix = instanceMatrix;
+#else
+    mat4 modelMatrix = model;
+    FragmentPositionLightSpace = lightSpaceMatrix * vec4(model * vec4(vertexPosition, 1.0));
+#endif
+
+    gl_Position = projection * view * modelMatrix * vec4(vertexPosition, 1.0);
+    FragmentPosition = vec3(view * modelMatrix * vec4(vertexPosition, 1.0));
+    VertexNormal = mat3(transpose(inverse(view * modelMatrix))) * DecodeNormal();
     TextureCoordinates = textureCoordinates;
-    MaterialIndex = materialIndex;
-}
\ No newline at end of file
+    MaterialIndex = vertexMaterialIndex >= 0 ? vertexMaterialIndex + materialOffset : -1;
+}
@@ -0,0 +1,68 @@
+// Materials as ResourceManager::ApplyMaterials sets them. Needs TextureCoordinates and MaterialIndex declared,
+// MAX_MATERIALS comes from ResourceManager
+struct Material {
+    vec3 ambientColor;
+
+    vec3 diffuseColor;
+    sampler2D diffuseMap;
+    bool hasDiffuseMap;
+
+    vec3 specularColor;
+    sampler2D specularMap;
+    bool hasSpecularMap;
+
+    vec3 emissiveColor;
+    sampler2D emissiveMap;
+    bool hasEmissiveMap;
+
+    float shininess;
+};
+uniform Material materials[MAX_MATERIALS];
+
+struct Surface {
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+    float shininess;
+};
+
+vec3 GetDiffuse()
+{
+    vec3 result = vec3(0.5);
+
+    if (MaterialIndex >= 0)
+    {
+        if (materials[MaterialIndex].hasDiffuseMap)
+            result = vec3(texture(materials[MaterialIndex].diffuseMap, TextureCoordinates));
+        else
+            result = materials[MaterialIndex].diffuseColor;
+    }
+
+    return result;
+}
+
+Surface CalculateSurface()
+{
+    Surface surface;
+
+    surface.ambient = vec3(1.0);
+    surface.diffuse = GetDiffuse();
+    surface.specular = vec3(0.5);
+    surface.shininess = 250.0;
+
+    if (MaterialIndex >= 0)
+    {
+        surface.ambient = materials[MaterialIndex].ambientColor;
+
+        if (materials[MaterialIndex].hasSpecularMap)
+            surface.specular = vec3(texture(materials[MaterialIndex].specularMap, TextureCoordinates));
+        else
+            surface.specular = materials[MaterialIndex].specularColor;
+
+        surface.shininess = materials[MaterialIndex].shininess;
+    }
+
+    surface.ambient = surface.ambient * surface.diffuse;
+
+    return surface;
+}
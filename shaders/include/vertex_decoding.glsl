@@ -0,0 +1,36 @@
+// Quantized meshes store positions as fractions of their bounding box, normals octahedral encoded and
+// materials as ranges of vertices, x is the range's first vertex and y its material. Needs the position, normal
+// and materialIndex attributes declared. MAX_MATERIAL_RANGES comes from ResourceManager
+uniform bool isVertexQuantized;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+uniform int materialRangeCount;
+uniform ivec2 materialRanges[MAX_MATERIAL_RANGES];
+
+vec3 DecodePosition()
+{
+    return isVertexQuantized ? positionOffset + positionScale * position : position;
+}
+
+vec3 DecodeNormal()
+{
+    if (!isVertexQuantized)
+        return normal;
+
+    vec3 decoded = vec3(normal.xy, 1.0 - abs(normal.x) - abs(normal.y));
+    float fold = max(-decoded.z, 0.0);
+    decoded.x += decoded.x >= 0.0 ? -fold : fold;
+    decoded.y += decoded.y >= 0.0 ? -fold : fold;
+    return normalize(decoded);
+}
+
+int DecodeMaterialIndex()
+{
+    if (!isVertexQuantized)
+        return materialIndex;
+
+    int decoded = -1;
+    for (int i = 0; i < materialRangeCount && materialRanges[i].x <= gl_VertexID; ++i)
+        decoded = materialRanges[i].y;
+    return decoded;
+}
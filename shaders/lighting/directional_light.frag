@@ -1,30 +1,4 @@
 #version 330 core
-struct Material {
-    vec3 ambientColor;
-
-    vec3 diffuseColor;
-    sampler2D diffuseMap;
-    bool hasDiffuseMap;
-
-    vec3 specularColor;
-    sampler2D specularMap;
-    bool hasSpecularMap;
-
-    vec3 emissiveColor;
-    sampler2D emissiveMap;
-    bool hasEmissiveMap;
-
-    float shininess;
-};
-#define MAX_MATERIALS 64
-uniform Material materials[MAX_MATERIALS];
-
-struct Surface {
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-    float shininess;
-};
 
 struct DirectionalLight {
     vec4 direction;
@@ -43,7 +17,8 @@ in vec4 FragmentPositionLightSpace;
 in vec2 TextureCoordinates;
 flat in int MaterialIndex;
 
-Surface CalculateSurface();
+#include "../include/material.glsl"
+
 float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir);
 
 void main()
@@ -68,37 +43,6 @@ void main()
     FragmentColor = vec4(lighting, 1.0);
 }
 
-Surface CalculateSurface()
-{
-    Surface surface;
-
-    surface.ambient = vec3(1.0);
-    surface.diffuse = vec3(0.5);
-    surface.specular = vec3(0.5);
-    surface.shininess = 250.0;
-
-    if (MaterialIndex >= 0)
-    {
-        surface.ambient = materials[MaterialIndex].ambientColor;
-
-        if (materials[MaterialIndex].hasDiffuseMap)
-            surface.diffuse = vec3(texture(materials[MaterialIndex].diffuseMap, TextureCoordinates));
-        else
-            surface.diffuse = materials[MaterialIndex].diffuseColor;
-
-        if (materials[MaterialIndex].hasSpecularMap)
-            surface.specular = vec3(texture(materials[MaterialIndex].specularMap, TextureCoordinates));
-        else
-            surface.specular = materials[MaterialIndex].specularColor;
-
-        surface.shininess = materials[MaterialIndex].shininess;
-    }
-
-    surface.ambient = surface.ambient * surface.diffuse;
-
-    return surface;
-}
-
 float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
 {
     float shadow = 0.0;
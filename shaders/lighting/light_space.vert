@@ -3,8 +3,12 @@ layout (location = 0) in vec3 position;
 
 uniform mat4 lightSpaceMatrix;
 uniform mat4 model;
+uniform bool isVertexQuantized;
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
 
 void main()
 {
-    gl_Position = lightSpaceMatrix * model * vec4(position, 1.0);
+    vec3 vertexPosition = isVertexQuantized ? positionOffset + positionScale * position : position;
+    gl_Position = lightSpaceMatrix * model * vec4(vertexPosition, 1.0);
 }
\ No newline at end of file
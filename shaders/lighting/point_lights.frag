@@ -1,31 +1,6 @@
 #version 330 core
-struct Material {
-    vec3 ambientColor;
-
-    vec3 diffuseColor;
-    sampler2D diffuseMap;
-    bool hasDiffuseMap;
-
-    vec3 specularColor;
-    sampler2D specularMap;
-    bool hasSpecularMap;
-
-    vec3 emissiveColor;
-    sampler2D emissiveMap;
-    bool hasEmissiveMap;
-
-    float shininess;
-};
-#define MAX_MATERIALS 64
-uniform Material materials[MAX_MATERIALS];
-
-struct Surface {
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-    float shininess;
-};
 
+// Mirrored by Shading::Lighting::PointLight, checked against it whenever the program links
 struct PointLight {
     vec4 position;
 
@@ -36,10 +11,8 @@ struct PointLight {
     float constant;
     float linear;
     float quadratic;
-    float PADDING;
 };
 
-#define MAX_POINT_LIGHTS 64
 layout (std140) uniform PointLights
 {
     PointLight pointLights[MAX_POINT_LIGHTS];
@@ -53,8 +26,14 @@ in vec3 FragmentPosition;
 in vec2 TextureCoordinates;
 flat in int MaterialIndex;
 
+#include "../include/material.glsl"
+
+// The light count bucket of a variant, a constant loop bound the compiler can unroll. MAX_POINT_LIGHTS otherwise
+#ifndef POINT_LIGHT_COUNT
+#define POINT_LIGHT_COUNT MAX_POINT_LIGHTS
+#endif
+
 vec3 CalculatePointLight(PointLight light, Surface surface, vec3 normal, vec3 viewDirection);
-Surface CalculateSurface();
 
 void main()
 {
@@ -64,9 +43,13 @@ void main()
 
     vec3 result = vec3(0.0);
 
-    int lightCount = min(numPointLights, MAX_POINT_LIGHTS);
-    for(int i = 0; i < lightCount; i++)
-    result += CalculatePointLight(pointLights[i], surface, normal, viewDirection);
+    for (int i = 0; i < POINT_LIGHT_COUNT; i++)
+    {
+        if (i >= numPointLights)
+            break;
+
+        result += CalculatePointLight(pointLights[i], surface, normal, viewDirection);
+    }
 
     FragmentColor = vec4(result, 1.0);
 }
@@ -88,34 +71,3 @@ vec3 CalculatePointLight(PointLight light, Surface surface, vec3 normal, vec3 vi
 
     return (ambient + diffuse + specular) * attenuation;
 }
-
-Surface CalculateSurface()
-{
-    Surface surface;
-
-    surface.ambient = vec3(1.0);
-    surface.diffuse = vec3(0.5);
-    surface.specular = vec3(0.5);
-    surface.shininess = 250.0;
-
-    if (MaterialIndex >= 0)
-    {
-        surface.ambient = materials[MaterialIndex].ambientColor;
-
-        if (materials[MaterialIndex].hasDiffuseMap)
-            surface.diffuse = vec3(texture(materials[MaterialIndex].diffuseMap, TextureCoordinates));
-        else
-            surface.diffuse = materials[MaterialIndex].diffuseColor;
-
-        if (materials[MaterialIndex].hasSpecularMap)
-            surface.specular = vec3(texture(materials[MaterialIndex].specularMap, TextureCoordinates));
-        else
-            surface.specular = materials[MaterialIndex].specularColor;
-
-        surface.shininess = materials[MaterialIndex].shininess;
-    }
-
-    surface.ambient = surface.ambient * surface.diffuse;
-
-    return surface;
-}
\ No newline at end of file
@@ -0,0 +1,346 @@
+#include "asset_pack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+#include "../utility/atomic_file.h"
+#include "../utility/hash.h"
+
+using Assets::AssetPack;
+using Assets::AssetFile;
+
+namespace
+{
+    constexpr char PACK_MAGIC[4] = { 'M', 'P', 'A', 'K' };
+    constexpr std::uint32_t PACK_VERSION = 1;
+    // Cache line aligned, which also covers the vertex, index and block data of baked caches inside the pack
+    constexpr std::uint64_t PAYLOAD_ALIGNMENT = 64;
+
+    struct PackHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t entryCount;
+        std::uint64_t entriesOffset;
+        std::uint64_t pathsOffset;
+        std::uint64_t pathsSize;
+    };
+
+    std::uint64_t AlignOffset(const std::uint64_t offset)
+    {
+        return (offset + PAYLOAD_ALIGNMENT - 1) & ~(PAYLOAD_ALIGNMENT - 1);
+    }
+}
+
+bool AssetPack::Mount(const char* packPath)
+{
+    // Running from loose files is normal during development, so a missing pack is not an error
+    Utility::MappedFile file(packPath);
+    if (!file.IsOpen())
+        return false;
+
+    PackHeader header;
+    if (file.Size() < sizeof(PackHeader))
+    {
+        std::cout << "ERROR::ASSET_PACK::INVALID " << packPath << std::endl;
+        return false;
+    }
+
+    std::memcpy(&header, file.Data(), sizeof(PackHeader));
+    if (std::memcmp(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 || header.version != PACK_VERSION
+        || header.entriesOffset % alignof(Entry) != 0 || header.entriesOffset + header.entryCount * sizeof(Entry) > file.Size()
+        || header.pathsOffset + header.pathsSize > file.Size())
+    {
+        std::cout << "ERROR::ASSET_PACK::INVALID " << packPath << std::endl;
+        return false;
+    }
+
+    std::span<const Entry> entries { reinterpret_cast<const Entry*>(file.Data() + header.entriesOffset), header.entryCount };
+    for (const Entry& entry : entries)
+    {
+        if (entry.offset + entry.size > file.Size() || static_cast<std::uint64_t>(entry.pathOffset) + entry.pathLength > header.pathsSize)
+        {
+            std::cout << "ERROR::ASSET_PACK::INVALID " << packPath << std::endl;
+            return false;
+        }
+    }
+
+    mFile = std::move(file);
+    mEntries = entries;
+    mPaths = mFile.View().substr(header.pathsOffset, header.pathsSize);
+
+    std::cout << "ASSET_PACK::MOUNTED " << packPath << ", " << mEntries.size() << " files, "
+              << (IsDevelopmentMode() ? "loose files take precedence" : "loose files are only a fallback") << std::endl;
+
+    return true;
+}
+
+bool AssetPack::IsMounted() const
+{
+    return mFile.IsOpen();
+}
+
+std::size_t AssetPack::GetFileCount() const
+{
+    return mEntries.size();
+}
+
+std::optional<std::string_view> AssetPack::Find(const std::string_view path) const
+{
+    const Entry* entry = FindEntry(path);
+    if (entry == nullptr)
+        return std::nullopt;
+
+    return mFile.View().substr(entry->offset, entry->size);
+}
+
+std::optional<std::int64_t> AssetPack::GetModifiedTime(const std::string_view path) const
+{
+    const Entry* entry = FindEntry(path);
+    if (entry == nullptr)
+        return std::nullopt;
+
+    return entry->modifiedTime;
+}
+
+bool AssetPack::Build(const std::string& packPath, const std::string& root, const std::vector<std::string>& directories)
+{
+    /*
+     * Collect files by their relative path, leaving out half-written cache files
+     */
+    struct PackedFile
+    {
+        std::filesystem::path sourcePath;
+        std::string path;
+        Entry entry;
+    };
+
+    std::vector<PackedFile> files;
+    for (const std::string& directory : directories)
+    {
+        std::error_code error;
+        auto options = std::filesystem::directory_options::follow_directory_symlink;
+        for (auto iterator = std::filesystem::recursive_directory_iterator(std::filesystem::path(root) / directory, options, error);
+             !error && iterator != std::filesystem::recursive_directory_iterator(); iterator.increment(error))
+        {
+            if (!iterator->is_regular_file() || iterator->path().extension() == ".tmp")
+                continue;
+
+            std::string path = NormalizePath(iterator->path().lexically_relative(root).generic_string());
+            Entry entry {};
+            entry.pathHash = Utility::Hash64(path);
+            entry.size = iterator->file_size();
+            entry.modifiedTime = iterator->last_write_time().time_since_epoch().count();
+
+            files.push_back({ iterator->path(), std::move(path), entry });
+        }
+
+        if (error)
+        {
+            std::cout << "ERROR::ASSET_PACK::DIRECTORY_NOT_READ " << directory << std::endl;
+            return false;
+        }
+    }
+
+    std::sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b)
+    {
+        return a.entry.pathHash != b.entry.pathHash ? a.entry.pathHash < b.entry.pathHash : a.path < b.path;
+    });
+
+    /*
+     * Header, table of contents and path strings first, then every payload on its own aligned offset
+     */
+    PackHeader header {};
+    std::memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.version = PACK_VERSION;
+    header.entryCount = files.size();
+    header.entriesOffset = sizeof(PackHeader);
+    header.pathsOffset = header.entriesOffset + files.size() * sizeof(Entry);
+
+    std::string paths;
+    for (PackedFile& file : files)
+    {
+        file.entry.pathOffset = static_cast<std::uint32_t>(paths.size());
+        file.entry.pathLength = static_cast<std::uint32_t>(file.path.size());
+        paths += file.path;
+    }
+    header.pathsSize = paths.size();
+
+    std::uint64_t offset = header.pathsOffset + header.pathsSize;
+    for (PackedFile& file : files)
+    {
+        file.entry.offset = AlignOffset(offset);
+        offset = file.entry.offset + file.entry.size;
+    }
+
+    // A failed build never replaces a working pack
+    bool isWritten = Utility::WriteFileAtomically(packPath, [&](std::ofstream& packFile)
+    {
+        packFile.write(reinterpret_cast<const char*>(&header), sizeof(PackHeader));
+        for (const PackedFile& file : files)
+            packFile.write(reinterpret_cast<const char*>(&file.entry), sizeof(Entry));
+        packFile.write(paths.data(), static_cast<std::streamsize>(paths.size()));
+
+        for (const PackedFile& file : files)
+        {
+            Utility::MappedFile source(file.sourcePath.string().c_str());
+            if (!source.IsOpen() || source.Size() != file.entry.size)
+            {
+                std::cout << "ERROR::ASSET_PACK::FILE_NOT_READ " << file.path << std::endl;
+                return false;
+            }
+
+            packFile.seekp(static_cast<std::streamoff>(file.entry.offset));
+            packFile.write(source.Data(), static_cast<std::streamsize>(source.Size()));
+        }
+
+        return true;
+    });
+
+    if (!isWritten)
+    {
+        std::cout << "ERROR::ASSET_PACK::WRITE_FAILED " << packPath << std::endl;
+        return false;
+    }
+
+    std::cout << "ASSET_PACK::BUILT " << packPath << ", " << files.size() << " files, "
+              << static_cast<double>(offset) / (1024.0 * 1024.0) << " MB" << std::endl;
+
+    return true;
+}
+
+AssetPack& AssetPack::GetShared()
+{
+    static AssetPack sharedPack;
+    return sharedPack;
+}
+
+bool AssetPack::IsDevelopmentMode()
+{
+#ifdef NDEBUG
+    return false;
+#else
+    return true;
+#endif
+}
+
+const AssetPack::Entry* AssetPack::FindEntry(const std::string_view path) const
+{
+    if (mEntries.empty())
+        return nullptr;
+
+    std::string normalizedPath = NormalizePath(path);
+    std::uint64_t pathHash = Utility::Hash64(normalizedPath);
+
+    // Entries sharing a hash sit next to each other, the stored path tells them apart
+    auto entry = std::lower_bound(mEntries.begin(), mEntries.end(), pathHash, [](const Entry& candidate, const std::uint64_t hash)
+    {
+        return candidate.pathHash < hash;
+    });
+
+    for (; entry != mEntries.end() && entry->pathHash == pathHash; ++entry)
+    {
+        if (mPaths.substr(entry->pathOffset, entry->pathLength) == normalizedPath)
+            return &*entry;
+    }
+
+    return nullptr;
+}
+
+std::string AssetPack::NormalizePath(const std::string_view path)
+{
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+AssetFile::AssetFile(const std::string& path)
+{
+    auto openLoose = [&]
+    {
+        Utility::MappedFile looseFile(path.c_str());
+        if (!looseFile.IsOpen())
+            return false;
+
+        mLooseFile = std::move(looseFile);
+        mView = mLooseFile.View();
+        mIsOpen = true;
+        return true;
+    };
+
+    auto openPacked = [&]
+    {
+        std::optional<std::string_view> packedFile = AssetPack::GetShared().Find(path);
+        if (!packedFile)
+            return false;
+
+        mView = *packedFile;
+        mIsOpen = mIsPacked = true;
+        return true;
+    };
+
+    if (AssetPack::IsDevelopmentMode())
+        openLoose() || openPacked();
+    else
+        openPacked() || openLoose();
+}
+
+AssetFile::AssetFile(AssetFile&& other) noexcept
+    : mLooseFile(std::move(other.mLooseFile)), mView(std::exchange(other.mView, {})),
+      mIsOpen(std::exchange(other.mIsOpen, false)), mIsPacked(std::exchange(other.mIsPacked, false)) {}
+
+AssetFile& AssetFile::operator=(AssetFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        mLooseFile = std::move(other.mLooseFile);
+        mView = std::exchange(other.mView, {});
+        mIsOpen = std::exchange(other.mIsOpen, false);
+        mIsPacked = std::exchange(other.mIsPacked, false);
+    }
+
+    return *this;
+}
+
+bool AssetFile::IsOpen() const
+{
+    return mIsOpen;
+}
+
+bool AssetFile::IsPacked() const
+{
+    return mIsPacked;
+}
+
+const char* AssetFile::Data() const
+{
+    return mView.data();
+}
+
+std::size_t AssetFile::Size() const
+{
+    return mView.size();
+}
+
+std::string_view AssetFile::View() const
+{
+    return mView;
+}
+
+std::int64_t AssetFile::GetModifiedTime(const std::string& path)
+{
+    auto getLooseTime = [&]() -> std::optional<std::int64_t>
+    {
+        std::error_code error;
+        std::int64_t modifiedTime = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+        return error ? std::nullopt : std::optional(modifiedTime);
+    };
+
+    std::optional<std::int64_t> modifiedTime = AssetPack::IsDevelopmentMode() ? getLooseTime() : AssetPack::GetShared().GetModifiedTime(path);
+    if (!modifiedTime)
+        modifiedTime = AssetPack::IsDevelopmentMode() ? AssetPack::GetShared().GetModifiedTime(path) : getLooseTime();
+
+    return modifiedTime.value_or(0);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../utility/mapped_file.h"
+
+namespace Assets
+{
+    /*
+     * Every asset and shader in one memory-mapped file. The table of contents is sorted by path hash and
+     * searched in place, and payloads are aligned, so files inside the pack are used straight from the
+     * mapping. Opening the pack costs one open, each asset after that only its page faults
+     */
+    class AssetPack
+    {
+    public:
+        // Maps the pack, its files are then found by the same relative paths the loose files have
+        bool Mount(const char* packPath);
+        bool IsMounted() const;
+        std::size_t GetFileCount() const;
+
+        std::optional<std::string_view> Find(std::string_view path) const;
+        std::optional<std::int64_t> GetModifiedTime(std::string_view path) const;
+
+        // Packs every file below the directories, stored by their path relative to root
+        static bool Build(const std::string& packPath, const std::string& root, const std::vector<std::string>& directories);
+
+        // Engine-wide pack AssetFile reads from
+        static AssetPack& GetShared();
+        // Debug builds prefer loose files over the pack, so edited assets show up without rebuilding it
+        static bool IsDevelopmentMode();
+
+    private:
+        struct Entry
+        {
+            std::uint64_t pathHash;
+            std::uint64_t offset;
+            std::uint64_t size;
+            std::int64_t modifiedTime;
+            std::uint32_t pathOffset;
+            std::uint32_t pathLength;
+        };
+
+        const Entry* FindEntry(std::string_view path) const;
+        static std::string NormalizePath(std::string_view path);
+
+        Utility::MappedFile mFile;
+        std::span<const Entry> mEntries;
+        std::string_view mPaths;
+    };
+
+    // A whole asset file, mapped from disk or viewed inside the mounted pack, zero-copy either way
+    class AssetFile
+    {
+    public:
+        AssetFile() = default;
+        explicit AssetFile(const std::string& path);
+
+        AssetFile(const AssetFile&) = delete;
+        AssetFile& operator=(const AssetFile&) = delete;
+        AssetFile(AssetFile&& other) noexcept;
+        AssetFile& operator=(AssetFile&& other) noexcept;
+
+        bool IsOpen() const;
+        bool IsPacked() const;
+        const char* Data() const;
+        std::size_t Size() const;
+        std::string_view View() const;
+
+        // Of the copy a constructor with the same path would open, zero when there is none
+        static std::int64_t GetModifiedTime(const std::string& path);
+
+    private:
+        Utility::MappedFile mLooseFile;
+        std::string_view mView;
+        bool mIsOpen = false;
+        bool mIsPacked = false;
+    };
+}
@@ -0,0 +1,110 @@
+#include "texture_cache.h"
+
+#include <filesystem>
+
+using Assets::TextureCache;
+
+TextureCache::TextureCache(TextureLoader& textureLoader) : mTextureLoader(textureLoader) {}
+
+unsigned int TextureCache::AcquireTexture(const std::string &path, const bool isSRGB)
+{
+    return Acquire(MakeKey({ path }, GLenum(), GLenum(), GL_REPEAT, isSRGB, false), [&]
+    {
+        return mTextureLoader.LoadTexture(path, isSRGB);
+    });
+}
+
+unsigned int TextureCache::AcquireStreamedTexture(const std::string& path, const bool isSRGB)
+{
+    return Acquire(MakeKey({ path }, GLenum(), GLenum(), GL_REPEAT, isSRGB, true), [&]
+    {
+        return mTextureLoader.LoadStreamedTexture(path, isSRGB);
+    });
+}
+
+unsigned int TextureCache::AcquireTexture(const char* texturePath, const GLenum internalFormat, const GLenum outputFormat, const GLenum wrapFormat)
+{
+    return Acquire(MakeKey({ texturePath }, internalFormat, outputFormat, wrapFormat, false, false), [&]
+    {
+        return mTextureLoader.LoadTexture(texturePath, internalFormat, outputFormat, wrapFormat);
+    });
+}
+
+unsigned int TextureCache::AcquireCubemap(const std::vector<std::string>& faces, const GLenum internalFormat, const GLenum format)
+{
+    return Acquire(MakeKey(faces, internalFormat, format, GL_CLAMP_TO_EDGE, false, false), [&]
+    {
+        return mTextureLoader.LoadCubemap(faces, internalFormat, format);
+    });
+}
+
+void TextureCache::Release(const unsigned int texture)
+{
+    auto textureKey = mTextureKeys.find(texture);
+    if (textureKey == mTextureKeys.end())
+        return;
+
+    auto entry = mEntries.find(textureKey->second);
+    if (--entry->second.referenceCount > 0)
+        return;
+
+    mTextureLoader.DeleteTexture(texture);
+    mEntries.erase(entry);
+    mTextureKeys.erase(textureKey);
+}
+
+Assets::TextureCacheStats TextureCache::GetStats() const
+{
+    TextureCacheStats stats { mHits, mMisses, mEntries.size(), 0, 0 };
+    for (const auto& [key, entry] : mEntries)
+    {
+        TextureMemory memory = mTextureLoader.GetMemory(entry.texture);
+        stats.residentBytes += memory.residentBytes;
+        stats.uncompressedBytes += memory.uncompressedBytes;
+    }
+
+    return stats;
+}
+
+unsigned int TextureCache::Acquire(const std::string& key, const std::function<unsigned int()>& load)
+{
+    auto entry = mEntries.find(key);
+    if (entry != mEntries.end())
+    {
+        ++mHits;
+        ++entry->second.referenceCount;
+        return entry->second.texture;
+    }
+
+    ++mMisses;
+    unsigned int texture = load();
+    mEntries.emplace(key, CacheEntry { texture, 1 });
+    mTextureKeys.emplace(texture, key);
+
+    return texture;
+}
+
+std::string TextureCache::MakeKey(const std::vector<std::string>& paths, const GLenum internalFormat, const GLenum format,
+                                  const GLenum wrapFormat, const bool isSRGB, const bool isStreamed) const
+{
+    std::string key;
+    for (const std::string& path : paths)
+        key += GetCanonicalPath(path) + '\n';
+
+    key += std::to_string(internalFormat) + ':' + std::to_string(format) + ':' + std::to_string(wrapFormat) + ':'
+        + (isSRGB ? "srgb" : "linear") + (mTextureLoader.GetFlipVertically() ? ":flipped" : "")
+        + (mTextureLoader.GetPremultiplyAlpha() ? ":premultiplied" : "") + (isStreamed ? ":streamed" : "");
+
+    if (mTextureLoader.IsCompressionEnabled())
+        key += ":bc" + std::to_string(static_cast<int>(mTextureLoader.GetCompressionQuality()));
+
+    return key;
+}
+
+std::string TextureCache::GetCanonicalPath(const std::string& path)
+{
+    std::error_code error;
+    std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(path, error);
+
+    return error ? std::filesystem::path(path).lexically_normal().string() : canonicalPath.string();
+}
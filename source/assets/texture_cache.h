@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "texture_loader.h"
+
+namespace Assets
+{
+    struct TextureCacheStats
+    {
+        unsigned int hits, misses;
+        std::size_t textureCount;
+        std::size_t residentBytes;
+        std::size_t uncompressedBytes;
+    };
+
+    /*
+     * Shares textures between materials and scenes. Entries are keyed by canonical path plus every
+     * setting that changes the uploaded data, so a texture is decoded and uploaded once and deleted
+     * when its last reference is released
+     */
+    class TextureCache
+    {
+    public:
+        explicit TextureCache(TextureLoader& textureLoader);
+
+        unsigned int AcquireTexture(const std::string& path, bool isSRGB);
+        unsigned int AcquireStreamedTexture(const std::string& path, bool isSRGB);
+        unsigned int AcquireTexture(const char* texturePath, GLenum internalFormat, GLenum outputFormat, GLenum wrapFormat);
+        unsigned int AcquireCubemap(const std::vector<std::string>& faces, GLenum internalFormat, GLenum format);
+        void Release(unsigned int texture);
+
+        TextureCacheStats GetStats() const;
+
+    private:
+        struct CacheEntry
+        {
+            unsigned int texture;
+            unsigned int referenceCount;
+        };
+
+        unsigned int Acquire(const std::string& key, const std::function<unsigned int()>& load);
+        std::string MakeKey(const std::vector<std::string>& paths, GLenum internalFormat, GLenum format, GLenum wrapFormat, bool isSRGB,
+                            bool isStreamed) const;
+        static std::string GetCanonicalPath(const std::string& path);
+
+        TextureLoader& mTextureLoader;
+        std::unordered_map<std::string, CacheEntry> mEntries;
+        std::unordered_map<unsigned int, std::string> mTextureKeys;
+        unsigned int mHits = 0;
+        unsigned int mMisses = 0;
+    };
+}
@@ -0,0 +1,666 @@
+#include "texture_compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BLOCK_COMPRESSION_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "../utility/atomic_file.h"
+#include "../utility/hash.h"
+#include "../utility/thread_pool.h"
+
+using Assets::BlockFormat;
+using Assets::CompressionQuality;
+
+namespace
+{
+    constexpr int BLOCK_DIMENSION = 4;
+    constexpr int BLOCK_PIXELS = BLOCK_DIMENSION * BLOCK_DIMENSION;
+
+    constexpr char CACHE_MAGIC[4] = { 'M', 'T', 'E', 'X' };
+    constexpr std::uint32_t CACHE_VERSION = 2;
+    constexpr std::uint64_t PAYLOAD_ALIGNMENT = 16;
+
+    struct CacheHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t format;
+        std::uint32_t quality;
+        std::uint32_t components;
+        std::uint32_t flags;
+        std::uint32_t levelCount;
+        std::uint32_t padding;
+        std::int64_t sourceModifiedTime;
+        std::uint64_t sourceHash;
+    };
+
+    struct CacheLevel
+    {
+        std::int32_t width, height;
+        std::uint64_t offset, size;
+    };
+
+    enum CacheFlags : std::uint32_t
+    {
+        FlipVertically = 1,
+        HasMipmaps = 2,
+        PremultiplyAlpha = 4,
+        SRGB = 8
+    };
+
+    // One 4x4 block as structure of arrays, so every channel loads straight into SIMD registers
+    struct BlockPixels
+    {
+        alignas(16) float channels[4][BLOCK_PIXELS];
+    };
+
+    struct ColorEndpoints
+    {
+        float colors[2][3];
+    };
+
+    void LoadBlock(const unsigned char* pixels, const int width, const int height, const int blockX, const int blockY, BlockPixels& block)
+    {
+        // Edge blocks repeat the last row and column of the image
+        for (int y = 0; y < BLOCK_DIMENSION; ++y)
+        {
+            int sourceY = std::min(blockY * BLOCK_DIMENSION + y, height - 1);
+
+            for (int x = 0; x < BLOCK_DIMENSION; ++x)
+            {
+                int sourceX = std::min(blockX * BLOCK_DIMENSION + x, width - 1);
+                const unsigned char* pixel = pixels + 4 * (static_cast<std::size_t>(sourceY) * width + sourceX);
+
+                for (int channel = 0; channel < 4; ++channel)
+                    block.channels[channel][y * BLOCK_DIMENSION + x] = pixel[channel];
+            }
+        }
+    }
+
+    void GetRange(const float* values, float& minValue, float& maxValue)
+    {
+#ifdef BLOCK_COMPRESSION_SSE2
+        __m128 minimum = _mm_load_ps(values);
+        __m128 maximum = minimum;
+        for (int i = 4; i < BLOCK_PIXELS; i += 4)
+        {
+            __m128 value = _mm_load_ps(values + i);
+            minimum = _mm_min_ps(minimum, value);
+            maximum = _mm_max_ps(maximum, value);
+        }
+
+        minimum = _mm_min_ps(minimum, _mm_shuffle_ps(minimum, minimum, _MM_SHUFFLE(1, 0, 3, 2)));
+        minimum = _mm_min_ps(minimum, _mm_shuffle_ps(minimum, minimum, _MM_SHUFFLE(2, 3, 0, 1)));
+        maximum = _mm_max_ps(maximum, _mm_shuffle_ps(maximum, maximum, _MM_SHUFFLE(1, 0, 3, 2)));
+        maximum = _mm_max_ps(maximum, _mm_shuffle_ps(maximum, maximum, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        minValue = _mm_cvtss_f32(minimum);
+        maxValue = _mm_cvtss_f32(maximum);
+#else
+        minValue = *std::min_element(values, values + BLOCK_PIXELS);
+        maxValue = *std::max_element(values, values + BLOCK_PIXELS);
+#endif
+    }
+
+    /*
+     * Projects every pixel onto the line from origin along axis and snaps it to one of stepCount evenly spaced
+     * palette entries. The palette of both BC1 and BC4 lies on that line, so the nearest step by projection is
+     * also the nearest palette entry
+     */
+    void ComputeSteps(const float* const* channels, const int channelCount, const float* origin, const float* axis,
+                      const int stepCount, int* steps)
+    {
+        float lengthSquared = 0.0f;
+        for (int channel = 0; channel < channelCount; ++channel)
+            lengthSquared += axis[channel] * axis[channel];
+
+        float scale = lengthSquared > 0.0f ? static_cast<float>(stepCount - 1) / lengthSquared : 0.0f;
+
+#ifdef BLOCK_COMPRESSION_SSE2
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 lastStep = _mm_set1_ps(static_cast<float>(stepCount - 1));
+
+        for (int i = 0; i < BLOCK_PIXELS; i += 4)
+        {
+            __m128 projection = zero;
+            for (int channel = 0; channel < channelCount; ++channel)
+            {
+                __m128 offset = _mm_sub_ps(_mm_load_ps(channels[channel] + i), _mm_set1_ps(origin[channel]));
+                projection = _mm_add_ps(projection, _mm_mul_ps(offset, _mm_set1_ps(axis[channel])));
+            }
+
+            projection = _mm_min_ps(_mm_max_ps(_mm_mul_ps(projection, _mm_set1_ps(scale)), zero), lastStep);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(steps + i), _mm_cvtps_epi32(projection));
+        }
+#else
+        for (int i = 0; i < BLOCK_PIXELS; ++i)
+        {
+            float projection = 0.0f;
+            for (int channel = 0; channel < channelCount; ++channel)
+                projection += (channels[channel][i] - origin[channel]) * axis[channel];
+
+            steps[i] = static_cast<int>(std::lround(std::clamp(projection * scale, 0.0f, static_cast<float>(stepCount - 1))));
+        }
+#endif
+    }
+
+    /*
+     * Colour endpoint selection
+     */
+    ColorEndpoints GetBoundingBoxEndpoints(const BlockPixels& block)
+    {
+        ColorEndpoints endpoints;
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            float minValue, maxValue;
+            GetRange(block.channels[channel], minValue, maxValue);
+
+            // Insetting the box by half a palette step lowers the average error
+            float inset = (maxValue - minValue) / 16.0f;
+            endpoints.colors[0][channel] = maxValue - inset;
+            endpoints.colors[1][channel] = minValue + inset;
+        }
+
+        return endpoints;
+    }
+
+    ColorEndpoints GetPrincipalAxisEndpoints(const BlockPixels& block)
+    {
+        float mean[3] = {};
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            for (int i = 0; i < BLOCK_PIXELS; ++i)
+                mean[channel] += block.channels[channel][i];
+            mean[channel] /= BLOCK_PIXELS;
+        }
+
+        float covariance[3][3] = {};
+        for (int i = 0; i < BLOCK_PIXELS; ++i)
+        {
+            float offset[3];
+            for (int channel = 0; channel < 3; ++channel)
+                offset[channel] = block.channels[channel][i] - mean[channel];
+
+            for (int row = 0; row < 3; ++row)
+                for (int column = row; column < 3; ++column)
+                    covariance[row][column] += offset[row] * offset[column];
+        }
+        covariance[1][0] = covariance[0][1];
+        covariance[2][0] = covariance[0][2];
+        covariance[2][1] = covariance[1][2];
+
+        // Power iteration converges on the direction of largest variance
+        ColorEndpoints boundingBox = GetBoundingBoxEndpoints(block);
+        float axis[3];
+        for (int channel = 0; channel < 3; ++channel)
+            axis[channel] = boundingBox.colors[0][channel] - boundingBox.colors[1][channel] + 1.0f;
+
+        for (int iteration = 0; iteration < 8; ++iteration)
+        {
+            float next[3];
+            for (int row = 0; row < 3; ++row)
+                next[row] = covariance[row][0] * axis[0] + covariance[row][1] * axis[1] + covariance[row][2] * axis[2];
+
+            float length = std::max({ std::abs(next[0]), std::abs(next[1]), std::abs(next[2]) });
+            if (length <= 0.0f)
+                break;
+
+            for (int channel = 0; channel < 3; ++channel)
+                axis[channel] = next[channel] / length;
+        }
+
+        float minProjection = 0.0f, maxProjection = 0.0f;
+        for (int i = 0; i < BLOCK_PIXELS; ++i)
+        {
+            float projection = 0.0f;
+            for (int channel = 0; channel < 3; ++channel)
+                projection += (block.channels[channel][i] - mean[channel]) * axis[channel];
+
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+
+        float lengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        ColorEndpoints endpoints;
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            float direction = lengthSquared > 0.0f ? axis[channel] / lengthSquared : 0.0f;
+            endpoints.colors[0][channel] = std::clamp(mean[channel] + direction * maxProjection, 0.0f, 255.0f);
+            endpoints.colors[1][channel] = std::clamp(mean[channel] + direction * minProjection, 0.0f, 255.0f);
+        }
+
+        return endpoints;
+    }
+
+    // Solves for the endpoints that best reproduce the block given the palette entry chosen for every pixel
+    bool RefineEndpoints(const BlockPixels& block, const int* steps, ColorEndpoints& endpoints)
+    {
+        float weight00 = 0.0f, weight01 = 0.0f, weight11 = 0.0f;
+        float sums[2][3] = {};
+
+        for (int i = 0; i < BLOCK_PIXELS; ++i)
+        {
+            float weight1 = static_cast<float>(steps[i]) / 3.0f;
+            float weight0 = 1.0f - weight1;
+            weight00 += weight0 * weight0;
+            weight01 += weight0 * weight1;
+            weight11 += weight1 * weight1;
+
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                sums[0][channel] += weight0 * block.channels[channel][i];
+                sums[1][channel] += weight1 * block.channels[channel][i];
+            }
+        }
+
+        float determinant = weight00 * weight11 - weight01 * weight01;
+        if (std::abs(determinant) < 1e-6f)
+            return false;
+
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            endpoints.colors[0][channel] = std::clamp((weight11 * sums[0][channel] - weight01 * sums[1][channel]) / determinant, 0.0f, 255.0f);
+            endpoints.colors[1][channel] = std::clamp((weight00 * sums[1][channel] - weight01 * sums[0][channel]) / determinant, 0.0f, 255.0f);
+        }
+
+        return true;
+    }
+
+    /*
+     * BC1 colour block
+     */
+    std::uint16_t PackColor565(const float* color)
+    {
+        auto red = static_cast<std::uint16_t>(std::lround(color[0] * 31.0f / 255.0f));
+        auto green = static_cast<std::uint16_t>(std::lround(color[1] * 63.0f / 255.0f));
+        auto blue = static_cast<std::uint16_t>(std::lround(color[2] * 31.0f / 255.0f));
+
+        return static_cast<std::uint16_t>(red << 11 | green << 5 | blue);
+    }
+
+    void UnpackColor565(const std::uint16_t packed, float* color)
+    {
+        int red = packed >> 11 & 31, green = packed >> 5 & 63, blue = packed & 31;
+        color[0] = static_cast<float>(red << 3 | red >> 2);
+        color[1] = static_cast<float>(green << 2 | green >> 4);
+        color[2] = static_cast<float>(blue << 3 | blue >> 2);
+    }
+
+    struct ColorBlock
+    {
+        std::uint16_t colors[2];
+        std::uint32_t indices;
+        float error;
+    };
+
+    ColorBlock FitColorBlock(const BlockPixels& block, const ColorEndpoints& endpoints, int* steps)
+    {
+        ColorBlock colorBlock { { PackColor565(endpoints.colors[0]), PackColor565(endpoints.colors[1]) }, 0, 0.0f };
+
+        // Four colour mode needs the first endpoint to be the larger one, equal endpoints only ever use index 0
+        if (colorBlock.colors[0] < colorBlock.colors[1])
+            std::swap(colorBlock.colors[0], colorBlock.colors[1]);
+
+        float palette[4][3];
+        UnpackColor565(colorBlock.colors[0], palette[0]);
+        UnpackColor565(colorBlock.colors[1], palette[3]);
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            palette[1][channel] = (2.0f * palette[0][channel] + palette[3][channel]) / 3.0f;
+            palette[2][channel] = (palette[0][channel] + 2.0f * palette[3][channel]) / 3.0f;
+        }
+
+        if (colorBlock.colors[0] == colorBlock.colors[1])
+            std::fill(steps, steps + BLOCK_PIXELS, 0);
+        else
+        {
+            const float* channels[] = { block.channels[0], block.channels[1], block.channels[2] };
+            float axis[3];
+            for (int channel = 0; channel < 3; ++channel)
+                axis[channel] = palette[3][channel] - palette[0][channel];
+
+            ComputeSteps(channels, 3, palette[0], axis, 4, steps);
+        }
+
+        // Steps run from the first to the second endpoint, BC1 stores the endpoints as indices 0 and 1
+        constexpr std::uint32_t STEP_TO_INDEX[] = { 0, 2, 3, 1 };
+        for (int i = 0; i < BLOCK_PIXELS; ++i)
+        {
+            colorBlock.indices |= STEP_TO_INDEX[steps[i]] << (2 * i);
+
+            for (int channel = 0; channel < 3; ++channel)
+            {
+                float difference = block.channels[channel][i] - palette[steps[i]][channel];
+                colorBlock.error += difference * difference;
+            }
+        }
+
+        return colorBlock;
+    }
+
+    void EncodeColorBlock(const BlockPixels& block, const CompressionQuality quality, unsigned char* output)
+    {
+        int steps[BLOCK_PIXELS];
+        ColorEndpoints endpoints = quality == CompressionQuality::Fast ? GetBoundingBoxEndpoints(block) : GetPrincipalAxisEndpoints(block);
+        ColorBlock best = FitColorBlock(block, endpoints, steps);
+
+        if (quality == CompressionQuality::High)
+        {
+            for (int iteration = 0; iteration < 2 && best.error > 0.0f; ++iteration)
+            {
+                // Steps follow the swapped endpoint order, so refine against the stored endpoints
+                UnpackColor565(best.colors[0], endpoints.colors[0]);
+                UnpackColor565(best.colors[1], endpoints.colors[1]);
+                if (!RefineEndpoints(block, steps, endpoints))
+                    break;
+
+                int refinedSteps[BLOCK_PIXELS];
+                ColorBlock refined = FitColorBlock(block, endpoints, refinedSteps);
+                if (refined.error >= best.error)
+                    break;
+
+                best = refined;
+                std::copy(refinedSteps, refinedSteps + BLOCK_PIXELS, steps);
+            }
+        }
+
+        std::memcpy(output, best.colors, sizeof(best.colors));
+        std::memcpy(output + sizeof(best.colors), &best.indices, sizeof(best.indices));
+    }
+
+    /*
+     * BC4 single channel block, BC3 uses it for alpha and BC5 for red and green
+     */
+    void EncodeChannelBlock(const float* values, unsigned char* output)
+    {
+        float minValue, maxValue;
+        GetRange(values, minValue, maxValue);
+
+        auto endpoint0 = static_cast<unsigned char>(std::lround(maxValue));
+        auto endpoint1 = static_cast<unsigned char>(std::lround(minValue));
+        std::uint64_t indices = 0;
+
+        // Eight value mode: endpoint 0 above endpoint 1, indices 2 to 7 interpolate from endpoint 0 towards endpoint 1
+        if (endpoint0 > endpoint1)
+        {
+            int steps[BLOCK_PIXELS];
+            float origin = endpoint1;
+            float axis = static_cast<float>(endpoint0 - endpoint1);
+            ComputeSteps(&values, 1, &origin, &axis, 8, steps);
+
+            for (int i = 0; i < BLOCK_PIXELS; ++i)
+            {
+                std::uint64_t index = steps[i] == 7 ? 0 : steps[i] == 0 ? 1 : 8 - steps[i];
+                indices |= index << (3 * i);
+            }
+        }
+
+        output[0] = endpoint0;
+        output[1] = endpoint1;
+        for (int i = 0; i < 6; ++i)
+            output[2 + i] = static_cast<unsigned char>(indices >> (8 * i));
+    }
+
+    void EncodeBlock(const BlockPixels& block, const BlockFormat format, const CompressionQuality quality, unsigned char* output)
+    {
+        switch (format)
+        {
+            case BlockFormat::BC1:
+                EncodeColorBlock(block, quality, output);
+                break;
+            case BlockFormat::BC3:
+                EncodeChannelBlock(block.channels[3], output);
+                EncodeColorBlock(block, quality, output + 8);
+                break;
+            case BlockFormat::BC5:
+                EncodeChannelBlock(block.channels[0], output);
+                EncodeChannelBlock(block.channels[1], output + 8);
+                break;
+        }
+    }
+
+    std::int64_t GetSourceModifiedTime(const std::string& path)
+    {
+        return Assets::AssetFile::GetModifiedTime(path);
+    }
+
+    std::uint64_t HashSourceFile(const std::string& path)
+    {
+        return Utility::Hash64(Assets::AssetFile(path).View());
+    }
+
+    std::uint64_t AlignOffset(const std::uint64_t offset)
+    {
+        return (offset + PAYLOAD_ALIGNMENT - 1) & ~(PAYLOAD_ALIGNMENT - 1);
+    }
+
+    std::uint32_t GetCacheFlags(const Assets::CompressionSettings& settings)
+    {
+        const Assets::ProcessingSettings& processing = settings.processing;
+        auto flag = [](const bool isSet, const CacheFlags cacheFlag)
+        {
+            return isSet ? static_cast<std::uint32_t>(cacheFlag) : std::uint32_t { 0 };
+        };
+
+        return flag(processing.flipVertically, FlipVertically) | flag(processing.hasMipmaps, HasMipmaps)
+            | flag(processing.premultiplyAlpha, PremultiplyAlpha) | flag(processing.isSRGB, SRGB);
+    }
+}
+
+std::size_t Assets::BlockCompression::GetBlockBytes(const BlockFormat format)
+{
+    return format == BlockFormat::BC1 ? 8 : 16;
+}
+
+int Assets::BlockCompression::GetComponentCount(const BlockFormat format)
+{
+    switch (format)
+    {
+        case BlockFormat::BC1:  return 3;
+        case BlockFormat::BC3:  return 4;
+        default:                return 2;
+    }
+}
+
+std::size_t Assets::BlockCompression::GetEncodedSize(const int width, const int height, const BlockFormat format)
+{
+    std::size_t blocksX = (width + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+    std::size_t blocksY = (height + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+
+    return blocksX * blocksY * GetBlockBytes(format);
+}
+
+GLenum Assets::BlockCompression::GetInternalFormat(const BlockFormat format, const bool isSRGB)
+{
+    switch (format)
+    {
+        case BlockFormat::BC1:  return isSRGB ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case BlockFormat::BC3:  return isSRGB ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        default:                return GL_COMPRESSED_RG_RGTC2;
+    }
+}
+
+const char* Assets::BlockCompression::GetFormatName(const BlockFormat format)
+{
+    switch (format)
+    {
+        case BlockFormat::BC1:  return "BC1";
+        case BlockFormat::BC3:  return "BC3";
+        default:                return "BC5";
+    }
+}
+
+std::optional<BlockFormat> Assets::BlockCompression::ChooseFormat(const int components, const unsigned char* pixels,
+                                                                  const int width, const int height)
+{
+    if (components == 2)
+        return BlockFormat::BC5;
+    if (components == 3)
+        return BlockFormat::BC1;
+    if (components != 4)
+        return std::nullopt;
+    if (pixels == nullptr)
+        return BlockFormat::BC3;
+
+    std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+    for (std::size_t i = 0; i < pixelCount; ++i)
+    {
+        if (pixels[i * 4 + 3] != 255)
+            return BlockFormat::BC3;
+    }
+
+    return BlockFormat::BC1;
+}
+
+void Assets::BlockCompression::EncodeImage(const unsigned char* pixels, const int width, const int height, const BlockFormat format,
+                                           const CompressionQuality quality, unsigned char* output, Utility::ThreadPool* threadPool)
+{
+    const int blocksX = (width + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+    const int blocksY = (height + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+    const std::size_t blockBytes = GetBlockBytes(format);
+
+    auto encodeRows = [&](const int firstRow, const int lastRow)
+    {
+        BlockPixels block;
+        for (int blockY = firstRow; blockY < lastRow; ++blockY)
+        {
+            unsigned char* rowOutput = output + static_cast<std::size_t>(blockY) * blocksX * blockBytes;
+            for (int blockX = 0; blockX < blocksX; ++blockX)
+            {
+                LoadBlock(pixels, width, height, blockX, blockY, block);
+                EncodeBlock(block, format, quality, rowOutput + blockX * blockBytes);
+            }
+        }
+    };
+
+    // Small mip levels are not worth the hand-off to other threads
+    std::size_t bandCount = threadPool != nullptr ? std::min<std::size_t>(blocksY, 4 * (threadPool->GetThreadCount() + 1)) : 1;
+    if (bandCount <= 1 || static_cast<std::size_t>(blocksX) * blocksY < 1024)
+    {
+        encodeRows(0, blocksY);
+        return;
+    }
+
+    threadPool->ParallelFor(bandCount, [&](const std::size_t band)
+    {
+        encodeRows(static_cast<int>(band * blocksY / bandCount), static_cast<int>((band + 1) * blocksY / bandCount));
+    });
+}
+
+Assets::CompressedImage Assets::BlockCompression::EncodeMipChain(const ProcessedImage& source, const BlockFormat format,
+                                                                 const CompressionQuality quality, Utility::ThreadPool* threadPool)
+{
+    CompressedImage image {};
+    image.format = format;
+
+    std::size_t totalSize = 0;
+    for (const ImageLevel& level : source.levels)
+    {
+        std::size_t size = GetEncodedSize(level.width, level.height, format);
+        image.levels.push_back({ level.width, level.height, totalSize, size });
+        totalSize += size;
+    }
+
+    image.encodedData.resize(totalSize);
+    for (std::size_t level = 0; level < image.levels.size(); ++level)
+    {
+        const ImageLevel& compressedLevel = image.levels[level];
+        EncodeImage(source.pixels.data() + source.levels[level].offset, compressedLevel.width, compressedLevel.height, format, quality,
+                    image.encodedData.data() + compressedLevel.offset, threadPool);
+    }
+
+    image.data = image.encodedData;
+
+    return image;
+}
+
+std::string Assets::BlockCompression::GetCachePath(const std::string& path, const CompressionSettings& settings)
+{
+    // Colour space and premultiplication change the filtered mips, so those variants of one image get their own file
+    return path + (settings.processing.isSRGB ? ".srgb" : "") + (settings.processing.premultiplyAlpha ? ".premultiplied" : "") + ".mtex";
+}
+
+std::optional<Assets::CompressedImage> Assets::BlockCompression::OpenCache(const std::string& path, const CompressionSettings& settings)
+{
+    std::string cachePath = GetCachePath(path, settings);
+    AssetFile file(cachePath);
+    if (file.Size() < sizeof(CacheHeader))
+        return std::nullopt;
+
+    CacheHeader header;
+    std::memcpy(&header, file.Data(), sizeof(CacheHeader));
+
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION
+        || header.format > static_cast<std::uint32_t>(BlockFormat::BC5) || header.quality != static_cast<std::uint32_t>(settings.quality)
+        || header.components != static_cast<std::uint32_t>(settings.components) || header.flags != GetCacheFlags(settings))
+        return std::nullopt;
+
+    std::uint64_t dataOffset = AlignOffset(sizeof(CacheHeader) + header.levelCount * sizeof(CacheLevel));
+    if (header.levelCount == 0 || dataOffset > file.Size())
+        return std::nullopt;
+
+    if (header.sourceModifiedTime != GetSourceModifiedTime(path) && header.sourceHash != HashSourceFile(path))
+        return std::nullopt;
+
+    CompressedImage image {};
+    image.format = static_cast<BlockFormat>(header.format);
+    image.data = { reinterpret_cast<const unsigned char*>(file.Data()) + dataOffset, file.Size() - dataOffset };
+
+    for (std::uint32_t i = 0; i < header.levelCount; ++i)
+    {
+        CacheLevel level;
+        std::memcpy(&level, file.Data() + sizeof(CacheHeader) + i * sizeof(CacheLevel), sizeof(CacheLevel));
+
+        if (level.width <= 0 || level.height <= 0 || level.size != GetEncodedSize(level.width, level.height, image.format)
+            || level.offset + level.size > image.data.size())
+            return std::nullopt;
+
+        image.levels.push_back({ level.width, level.height, level.offset, level.size });
+    }
+
+    image.file = std::move(file);
+
+    return image;
+}
+
+bool Assets::BlockCompression::WriteCache(const std::string& path, const CompressionSettings& settings, const CompressedImage& image)
+{
+    CacheHeader header {};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.format = static_cast<std::uint32_t>(image.format);
+    header.quality = static_cast<std::uint32_t>(settings.quality);
+    header.components = settings.components;
+    header.flags = GetCacheFlags(settings);
+    header.levelCount = static_cast<std::uint32_t>(image.levels.size());
+    header.sourceModifiedTime = GetSourceModifiedTime(path);
+    header.sourceHash = HashSourceFile(path);
+
+    std::string cachePath = GetCachePath(path, settings);
+    bool isWritten = Utility::WriteFileAtomically(cachePath, [&](std::ofstream& cacheFile)
+    {
+        cacheFile.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
+        for (const ImageLevel& compressedLevel : image.levels)
+        {
+            CacheLevel level { compressedLevel.width, compressedLevel.height, compressedLevel.offset, compressedLevel.size };
+            cacheFile.write(reinterpret_cast<const char*>(&level), sizeof(CacheLevel));
+        }
+
+        cacheFile.seekp(static_cast<std::streamoff>(AlignOffset(sizeof(CacheHeader) + image.levels.size() * sizeof(CacheLevel))));
+        cacheFile.write(reinterpret_cast<const char*>(image.data.data()), static_cast<std::streamsize>(image.data.size()));
+        return true;
+    });
+
+    if (!isWritten)
+        std::cout << "ERROR::TEXTURE_CACHE::WRITE_FAILED " << cachePath << std::endl;
+
+    return isWritten;
+}
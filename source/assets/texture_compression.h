@@ -0,0 +1,93 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "texture_processing.h"
+#include "asset_pack.h"
+
+// Block compressed formats from EXT_texture_compression_s3tc and EXT_texture_sRGB, the bundled glad only has core enums
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+namespace Utility
+{
+    class ThreadPool;
+}
+
+namespace Assets
+{
+    enum class BlockFormat
+    {
+        BC1,
+        BC3,
+        BC5
+    };
+
+    // Trades encode time for quality: bounding box endpoints, principal axis endpoints,
+    // or principal axis refined by least squares
+    enum class CompressionQuality
+    {
+        Fast,
+        Balanced,
+        High
+    };
+
+    // Level offsets are relative to data, which points into either encodedData or the mapped cache file
+    struct CompressedImage
+    {
+        BlockFormat format;
+        std::vector<ImageLevel> levels;
+        std::span<const unsigned char> data;
+
+        std::vector<unsigned char> encodedData;
+        AssetFile file;
+    };
+
+    // Everything besides the source file that changes the encoded result
+    struct CompressionSettings
+    {
+        CompressionQuality quality;
+        int components;
+        ProcessingSettings processing;
+    };
+
+    namespace BlockCompression
+    {
+        std::size_t GetBlockBytes(BlockFormat format);
+        int GetComponentCount(BlockFormat format);
+        std::size_t GetEncodedSize(int width, int height, BlockFormat format);
+        GLenum GetInternalFormat(BlockFormat format, bool isSRGB);
+        const char* GetFormatName(BlockFormat format);
+
+        // BC1 for opaque colour, BC3 when alpha is used, BC5 for two channel images and nothing for single channel ones.
+        // Without pixels the alpha channel is assumed to be in use
+        std::optional<BlockFormat> ChooseFormat(int components, const unsigned char* pixels, int width, int height);
+
+        // Encodes an RGBA8 image into output, which must hold GetEncodedSize bytes. Spreads block rows over threadPool when given
+        void EncodeImage(const unsigned char* pixels, int width, int height, BlockFormat format, CompressionQuality quality,
+                         unsigned char* output, Utility::ThreadPool* threadPool);
+        // Encodes every level of a processed image, the mip chain is filtered once by TextureProcessing and reused here
+        CompressedImage EncodeMipChain(const ProcessedImage& source, BlockFormat format, CompressionQuality quality,
+                                       Utility::ThreadPool* threadPool);
+
+        std::string GetCachePath(const std::string& path, const CompressionSettings& settings);
+        std::optional<CompressedImage> OpenCache(const std::string& path, const CompressionSettings& settings);
+        bool WriteCache(const std::string& path, const CompressionSettings& settings, const CompressedImage& image);
+    }
+}
@@ -0,0 +1,659 @@
+#include "texture_loader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string_view>
+
+#include "stb_image.h"
+#include "../utility/file_watcher.h"
+#include "../utility/thread_pool.h"
+
+using Assets::TextureLoader;
+
+namespace
+{
+    constexpr unsigned char PLACEHOLDER_PIXEL[] = { 128, 128, 128, 255 };
+
+    int GetComponentCount(const GLenum format)
+    {
+        switch (format)
+        {
+            case GL_RED:    return 1;
+            case GL_RG:     return 2;
+            case GL_RGB:    return 3;
+            case GL_RGBA:   return 4;
+            default:        return 0;
+        }
+    }
+
+    bool IsSRGBFormat(const GLenum internalFormat)
+    {
+        return internalFormat == GL_SRGB || internalFormat == GL_SRGB8
+            || internalFormat == GL_SRGB_ALPHA || internalFormat == GL_SRGB8_ALPHA8;
+    }
+
+    // Only colour formats are swapped for a block compressed one, an unset format is picked after decoding
+    bool IsCompressibleFormat(const GLenum internalFormat)
+    {
+        return internalFormat == GLenum() || IsSRGBFormat(internalFormat) || internalFormat == GL_RGB
+            || internalFormat == GL_RGB8 || internalFormat == GL_RGBA || internalFormat == GL_RGBA8;
+    }
+
+    bool HasExtension(const std::string_view name)
+    {
+        int extensionCount = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+
+        for (int i = 0; i < extensionCount; ++i)
+        {
+            auto extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (extension != nullptr && name == extension)
+                return true;
+        }
+
+        return false;
+    }
+
+    std::size_t GetMipChainBytes(int width, int height, const int components)
+    {
+        std::size_t bytes = 0;
+        while (true)
+        {
+            bytes += static_cast<std::size_t>(width) * height * components;
+            if (width == 1 && height == 1)
+                return bytes;
+
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+        }
+    }
+
+    GLenum GetTextureBindingQuery(const GLenum target)
+    {
+        return target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_BINDING_CUBE_MAP : GL_TEXTURE_BINDING_2D;
+    }
+}
+
+TextureLoader::TextureLoader() : mPixelBuffers(PIXEL_BUFFER_COUNT)
+{
+    for (PixelBuffer& pixelBuffer : mPixelBuffers)
+        glGenBuffers(1, &pixelBuffer.buffer);
+
+    mIsCompressionSupported = HasExtension("GL_EXT_texture_compression_s3tc")
+        && (HasExtension("GL_EXT_texture_sRGB") || HasExtension("GL_EXT_texture_compression_s3tc_srgb"));
+    mIsCompressionEnabled = mIsCompressionSupported;
+}
+
+TextureLoader::~TextureLoader()
+{
+    for (PixelBuffer& pixelBuffer : mPixelBuffers)
+    {
+        if (pixelBuffer.fence != nullptr)
+            glDeleteSync(pixelBuffer.fence);
+
+        glDeleteBuffers(1, &pixelBuffer.buffer);
+    }
+}
+
+unsigned int TextureLoader::LoadTexture(const std::string &path, const bool isSRGB)
+{
+    unsigned int texture = CreatePlaceholder(GL_TEXTURE_2D, GL_REPEAT, GL_LINEAR_MIPMAP_LINEAR);
+    QueueRequest(texture, { GL_TEXTURE_2D, { path }, GLenum(), GLenum(), 0, isSRGB, false, mFlipVertically, mPremultiplyAlpha }, false);
+
+    return texture;
+}
+
+unsigned int TextureLoader::LoadStreamedTexture(const std::string& path, const bool isSRGB)
+{
+    unsigned int texture = CreatePlaceholder(GL_TEXTURE_2D, GL_REPEAT, GL_LINEAR_MIPMAP_LINEAR);
+    QueueRequest(texture, { GL_TEXTURE_2D, { path }, GLenum(), GLenum(), 0, isSRGB, true, mFlipVertically, mPremultiplyAlpha }, false);
+
+    return texture;
+}
+
+unsigned int TextureLoader::LoadTexture(const char* texturePath, const GLenum internalFormat, const GLenum outputFormat, const GLenum wrapFormat)
+{
+    unsigned int texture = CreatePlaceholder(GL_TEXTURE_2D, wrapFormat, GL_LINEAR_MIPMAP_LINEAR);
+    QueueRequest(texture, { GL_TEXTURE_2D, { texturePath }, internalFormat, outputFormat, GetComponentCount(outputFormat),
+                            IsSRGBFormat(internalFormat), false, mFlipVertically, mPremultiplyAlpha }, false);
+
+    return texture;
+}
+
+unsigned int TextureLoader::LoadCubemap(const std::vector<std::string>& faces, const GLenum internalFormat, const GLenum format)
+{
+    unsigned int texture = CreatePlaceholder(GL_TEXTURE_CUBE_MAP, GL_CLAMP_TO_EDGE, GL_LINEAR);
+    QueueRequest(texture, { GL_TEXTURE_CUBE_MAP, faces, internalFormat, format, GetComponentCount(format),
+                            IsSRGBFormat(internalFormat), false, mFlipVertically, mPremultiplyAlpha }, false);
+
+    return texture;
+}
+
+void TextureLoader::Update()
+{
+    std::size_t uploadedBytes = 0;
+    auto request = mPendingRequests.begin();
+
+    while (request != mPendingRequests.end() && uploadedBytes < UPLOAD_BYTES_PER_FRAME)
+    {
+        bool isDecoded = std::all_of(request->faces.begin(), request->faces.end(), [](const std::future<DecodedImage>& face)
+        {
+            return face.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        });
+
+        if (!isDecoded)
+        {
+            ++request;
+            continue;
+        }
+
+        // Out of pixel buffers, the GPU has not consumed the previous uploads yet
+        if (!UploadRequest(*request, uploadedBytes))
+            break;
+
+        request = mPendingRequests.erase(request);
+    }
+}
+
+void TextureLoader::DeleteTexture(const unsigned int texture)
+{
+    std::erase_if(mPendingRequests, [texture](const TextureRequest& request) { return request.texture == texture; });
+    mStreamedTextures.erase(texture);
+    mMemory.erase(texture);
+    mSources.erase(texture);
+
+    auto watches = mSourceWatches.find(texture);
+    if (watches != mSourceWatches.end())
+    {
+        for (unsigned int watchId : watches->second)
+            mFileWatcher->Unwatch(watchId);
+
+        mSourceWatches.erase(watches);
+    }
+
+    glDeleteTextures(1, &texture);
+}
+
+void TextureLoader::SetFileWatcher(Utility::FileWatcher* fileWatcher)
+{
+    mFileWatcher = fileWatcher;
+}
+
+void TextureLoader::ReloadTexture(const unsigned int texture)
+{
+    auto source = mSources.find(texture);
+    if (source == mSources.end())
+        return;
+
+    // A decode still in flight read the old files, the new request supersedes it
+    std::erase_if(mPendingRequests, [texture](const TextureRequest& request) { return request.texture == texture; });
+    QueueRequest(texture, source->second, true);
+}
+
+std::optional<Assets::TextureResidency> TextureLoader::GetResidency(const unsigned int texture) const
+{
+    auto streamedTexture = mStreamedTextures.find(texture);
+    if (streamedTexture == mStreamedTextures.end())
+        return std::nullopt;
+
+    const StreamedTexture& streamed = streamedTexture->second;
+    return TextureResidency {
+        streamed.image.width, streamed.image.height, static_cast<int>(streamed.image.GetLevels().size()),
+        streamed.residentLevel, streamed.tailLevel
+    };
+}
+
+std::size_t TextureLoader::GetLevelBytes(const unsigned int texture, const int level) const
+{
+    auto streamedTexture = mStreamedTextures.find(texture);
+    if (streamedTexture == mStreamedTextures.end() || level < 0
+        || static_cast<std::size_t>(level) >= streamedTexture->second.image.GetLevels().size())
+        return 0;
+
+    return GetImageLevelBytes(streamedTexture->second.image, level);
+}
+
+bool TextureLoader::StreamInLevel(const unsigned int texture)
+{
+    auto streamedTexture = mStreamedTextures.find(texture);
+    if (streamedTexture == mStreamedTextures.end() || streamedTexture->second.residentLevel == 0)
+        return true;
+
+    if (GetFreePixelBufferCount() == 0)
+        return false;
+
+    StreamedTexture& streamed = streamedTexture->second;
+    int level = streamed.residentLevel - 1;
+
+    int previousTexture;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    UploadImage(GL_TEXTURE_2D, streamed.internalFormat, streamed.image, level, level + 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+
+    glBindTexture(GL_TEXTURE_2D, previousTexture);
+
+    streamed.residentLevel = level;
+    mMemory[texture].residentBytes += GetImageLevelBytes(streamed.image, level);
+
+    return true;
+}
+
+void TextureLoader::EvictLevels(const unsigned int texture, int level)
+{
+    auto streamedTexture = mStreamedTextures.find(texture);
+    if (streamedTexture == mStreamedTextures.end())
+        return;
+
+    StreamedTexture& streamed = streamedTexture->second;
+    level = std::min(level, streamed.tailLevel);
+    if (level <= streamed.residentLevel)
+        return;
+
+    int previousTexture;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    // Raise the base level first so the texture stays complete, then respecify the dropped levels as empty to free them
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+    for (int droppedLevel = streamed.residentLevel; droppedLevel < level; ++droppedLevel)
+    {
+        if (streamed.image.compressed)
+            glCompressedTexImage2D(GL_TEXTURE_2D, droppedLevel, streamed.internalFormat, 0, 0, 0, 0, nullptr);
+        else
+            glTexImage2D(GL_TEXTURE_2D, droppedLevel, static_cast<int>(streamed.internalFormat), 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+        mMemory[texture].residentBytes -= GetImageLevelBytes(streamed.image, droppedLevel);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, previousTexture);
+
+    streamed.residentLevel = level;
+}
+
+void TextureLoader::SetFlipVertically(const bool flipVertically)
+{
+    mFlipVertically = flipVertically;
+}
+
+bool TextureLoader::GetFlipVertically() const
+{
+    return mFlipVertically;
+}
+
+void TextureLoader::SetPremultiplyAlpha(const bool premultiplyAlpha)
+{
+    mPremultiplyAlpha = premultiplyAlpha;
+}
+
+bool TextureLoader::GetPremultiplyAlpha() const
+{
+    return mPremultiplyAlpha;
+}
+
+void TextureLoader::SetCompression(const bool isEnabled, const CompressionQuality quality)
+{
+    mIsCompressionEnabled = isEnabled && mIsCompressionSupported;
+    mCompressionQuality = quality;
+}
+
+bool TextureLoader::IsCompressionEnabled() const
+{
+    return mIsCompressionEnabled;
+}
+
+Assets::CompressionQuality TextureLoader::GetCompressionQuality() const
+{
+    return mCompressionQuality;
+}
+
+std::size_t TextureLoader::GetPendingCount() const
+{
+    return mPendingRequests.size();
+}
+
+Assets::TextureMemory TextureLoader::GetMemory(const unsigned int texture) const
+{
+    auto memory = mMemory.find(texture);
+    return memory != mMemory.end() ? memory->second : TextureMemory {};
+}
+
+const std::vector<Assets::TextureTiming>& TextureLoader::GetTimings() const
+{
+    return mTimings;
+}
+
+const std::vector<Assets::ImageLevel>& TextureLoader::DecodedImage::GetLevels() const
+{
+    return compressed ? compressed->levels : processed.levels;
+}
+
+std::span<const unsigned char> TextureLoader::DecodedImage::GetData() const
+{
+    return compressed ? compressed->data : std::span<const unsigned char>(processed.pixels);
+}
+
+unsigned int TextureLoader::CreatePlaceholder(const GLenum target, const GLenum wrapFormat, const GLenum minFilter)
+{
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(target, texture);
+
+    if (target == GL_TEXTURE_CUBE_MAP)
+    {
+        for (unsigned int i = 0; i < 6; ++i)
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, PLACEHOLDER_PIXEL);
+
+        glTexParameteri(target, GL_TEXTURE_WRAP_R, wrapFormat);
+    }
+    else
+        glTexImage2D(target, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, PLACEHOLDER_PIXEL);
+
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, wrapFormat);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, wrapFormat);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    return texture;
+}
+
+void TextureLoader::QueueRequest(const unsigned int texture, const TextureSource& source, const bool isReload)
+{
+    TextureRequest request {};
+    request.texture = texture;
+    request.source = source;
+    for (const std::string& path : source.paths)
+        request.faces.push_back(DecodeAsync(path, source));
+    request.isReload = isReload;
+    request.requestTime = std::chrono::steady_clock::now();
+    mPendingRequests.push_back(std::move(request));
+
+    if (isReload)
+        return;
+
+    mSources.emplace(texture, source);
+    if (mFileWatcher == nullptr)
+        return;
+
+    for (const std::string& path : source.paths)
+        mSourceWatches[texture].push_back(mFileWatcher->Watch(path, [this, texture] { ReloadTexture(texture); }));
+}
+
+std::future<TextureLoader::DecodedImage> TextureLoader::DecodeAsync(const std::string& path, const TextureSource& source) const
+{
+    int desiredComponents = source.desiredComponents;
+    GLenum target = source.target;
+    bool isCompressed = mIsCompressionEnabled && IsCompressibleFormat(source.internalFormat);
+    ProcessingSettings processing { source.flipVertically, source.premultiplyAlpha, source.isSRGB, target == GL_TEXTURE_2D };
+    CompressionSettings settings { mCompressionQuality, desiredComponents, processing };
+
+    return Utility::ThreadPool::GetShared().Submit([path, desiredComponents, target, isCompressed, settings]
+    {
+        auto decodeStart = std::chrono::steady_clock::now();
+        DecodedImage image;
+
+        if (isCompressed)
+        {
+            if (std::optional<CompressedImage> cachedImage = BlockCompression::OpenCache(path, settings))
+            {
+                image.width = cachedImage->levels.front().width;
+                image.height = cachedImage->levels.front().height;
+                image.components = desiredComponents != 0 ? desiredComponents : BlockCompression::GetComponentCount(cachedImage->format);
+                image.compressed = std::move(cachedImage);
+                image.isFromCache = true;
+                image.decodeMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - decodeStart).count();
+
+                return image;
+            }
+        }
+
+        // Decoded straight from the mapping, whether the file is loose or inside the asset pack
+        AssetFile file(path);
+        std::unique_ptr<unsigned char, void(*)(void*)> pixels {
+            file.IsOpen() ? stbi_load_from_memory(reinterpret_cast<const unsigned char*>(file.Data()), static_cast<int>(file.Size()),
+                                                  &image.width, &image.height, &image.components, desiredComponents) : nullptr,
+            stbi_image_free
+        };
+        file = AssetFile();
+        if (desiredComponents != 0)
+            image.components = desiredComponents;
+
+        auto processStart = std::chrono::steady_clock::now();
+        image.decodeMilliseconds = std::chrono::duration<double, std::milli>(processStart - decodeStart).count();
+
+        if (!pixels)
+            return image;
+
+        Utility::ThreadPool& threadPool = Utility::ThreadPool::GetShared();
+        image.processed = TextureProcessing::ProcessImage(pixels.get(), image.width, image.height, image.components, settings.processing, &threadPool);
+        pixels.reset();
+
+        auto encodeStart = std::chrono::steady_clock::now();
+        image.processMilliseconds = std::chrono::duration<double, std::milli>(encodeStart - processStart).count();
+
+        if (!isCompressed)
+            return image;
+
+        // Every cubemap face needs the same format, so only 2D textures look at their alpha to pick BC1 over BC3
+        const unsigned char* alphaPixels = target == GL_TEXTURE_2D ? image.processed.pixels.data() : nullptr;
+        std::optional<BlockFormat> format = BlockCompression::ChooseFormat(image.components, alphaPixels, image.width, image.height);
+        if (!format)
+            return image;
+
+        image.compressed = BlockCompression::EncodeMipChain(image.processed, *format, settings.quality, &threadPool);
+        image.processed = {};
+        BlockCompression::WriteCache(path, settings, *image.compressed);
+        image.encodeMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - encodeStart).count();
+
+        return image;
+    });
+}
+
+bool TextureLoader::UploadRequest(TextureRequest& request, std::size_t& uploadedBytes)
+{
+    if (GetFreePixelBufferCount() < request.faces.size())
+        return false;
+
+    std::vector<DecodedImage> images;
+    for (std::future<DecodedImage>& face : request.faces)
+        images.push_back(face.get());
+
+    for (std::size_t i = 0; i < images.size(); ++i)
+    {
+        if (images[i].processed.pixels.empty() && !images[i].compressed)
+        {
+            std::cout << "Texture failed to load at path: " << request.source.paths[i]
+                      << (request.isReload ? ", keeping the previous texture" : "") << std::endl;
+            return true;
+        }
+    }
+
+    auto uploadStart = std::chrono::steady_clock::now();
+
+    const TextureSource& source = request.source;
+
+    // A reloaded streamed texture starts over from its new tail, the finer levels of the old data are freed first
+    if (request.isReload)
+        EvictLevels(request.texture, std::numeric_limits<int>::max());
+
+    int previousTexture;
+    glGetIntegerv(GetTextureBindingQuery(source.target), &previousTexture);
+    glBindTexture(source.target, request.texture);
+
+    // Streamed textures start with only their mip tail, TextureStreamer brings in the finer levels
+    std::size_t firstLevel = source.isStreamed ? GetTailLevel(images.front()) : 0;
+    if (source.isStreamed)
+        glTexParameteri(source.target, GL_TEXTURE_BASE_LEVEL, static_cast<int>(firstLevel));
+
+    double decodeMilliseconds = 0.0, processMilliseconds = 0.0, encodeMilliseconds = 0.0;
+    GLenum internalFormat = GetInternalFormat(source.internalFormat, source.isSRGB, images.front());
+    TextureMemory& memory = mMemory[request.texture];
+    memory = {};
+    for (std::size_t i = 0; i < images.size(); ++i)
+    {
+        const DecodedImage& image = images[i];
+        GLenum faceTarget = source.target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + i : source.target;
+        UploadImage(faceTarget, internalFormat, image, firstLevel, image.GetLevels().size());
+
+        std::size_t imageBytes = static_cast<std::size_t>(image.width) * image.height * image.components;
+        std::size_t uncompressedBytes = source.target == GL_TEXTURE_2D ? GetMipChainBytes(image.width, image.height, image.components) : imageBytes;
+
+        for (std::size_t level = firstLevel; level < image.GetLevels().size(); ++level)
+        {
+            uploadedBytes += image.GetLevels()[level].size;
+            memory.residentBytes += GetImageLevelBytes(image, level);
+        }
+
+        memory.uncompressedBytes += uncompressedBytes;
+        decodeMilliseconds += image.decodeMilliseconds;
+        processMilliseconds += image.processMilliseconds;
+        encodeMilliseconds += image.encodeMilliseconds;
+    }
+
+    glBindTexture(source.target, previousTexture);
+
+    auto uploadEnd = std::chrono::steady_clock::now();
+    mTimings.push_back({
+        source.paths.front(), images.front().width, images.front().height, decodeMilliseconds, processMilliseconds, encodeMilliseconds,
+        std::chrono::duration<double, std::milli>(uploadEnd - uploadStart).count(),
+        std::chrono::duration<double, std::milli>(uploadEnd - request.requestTime).count()
+    });
+
+    const TextureTiming& timing = mTimings.back();
+    std::cout << (request.isReload ? "TEXTURE::RELOADED " : "TEXTURE::LOADED ") << timing.path
+              << (source.target == GL_TEXTURE_CUBE_MAP ? " (cubemap)" : "") << (source.isStreamed ? " (streamed)" : "") << " " << timing.width << "x" << timing.height;
+
+    if (images.front().compressed)
+    {
+        std::cout << " " << BlockCompression::GetFormatName(images.front().compressed->format)
+                  << (images.front().isFromCache ? " from cache" : "");
+    }
+
+    std::cout << ", decoded in " << timing.decodeMilliseconds << " ms, processed in " << timing.processMilliseconds
+              << " ms, encoded in " << timing.encodeMilliseconds
+              << " ms, uploaded in " << timing.uploadMilliseconds << " ms, resident after " << timing.residentMilliseconds
+              << " ms, " << memory.residentBytes / 1024 << " KB of " << memory.uncompressedBytes / 1024 << " KB" << std::endl;
+
+    if (source.isStreamed)
+    {
+        auto tailLevel = static_cast<int>(firstLevel);
+        mStreamedTextures.insert_or_assign(request.texture, StreamedTexture { std::move(images.front()), internalFormat, tailLevel, tailLevel });
+    }
+
+    return true;
+}
+
+void TextureLoader::UploadImage(const GLenum target, const GLenum internalFormat, const DecodedImage& image,
+                                const std::size_t firstLevel, const std::size_t endLevel)
+{
+    const std::vector<ImageLevel>& levels = image.GetLevels();
+    std::size_t rangeStart = levels[firstLevel].offset;
+    std::size_t rangeEnd = levels[endLevel - 1].offset + levels[endLevel - 1].size;
+    std::span<const unsigned char> source = image.GetData().subspan(rangeStart, rangeEnd - rangeStart);
+
+    PixelBuffer& pixelBuffer = mPixelBuffers[mNextPixelBuffer];
+    mNextPixelBuffer = (mNextPixelBuffer + 1) % mPixelBuffers.size();
+
+    auto size = static_cast<GLsizeiptr>(source.size());
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer.buffer);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+
+    // Sourcing from the bound pixel buffer lets the copy into the texture happen on the GPU's timeline,
+    // data pointers become offsets into that buffer
+    bool isMapped = false;
+    if (void* destination = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT))
+    {
+        std::memcpy(destination, source.data(), source.size());
+        isMapped = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+    }
+
+    if (!isMapped)
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    auto getSource = [&](const std::size_t offset) -> const void*
+    {
+        return isMapped ? reinterpret_cast<const void*>(offset - rangeStart) : source.data() + (offset - rangeStart);
+    };
+
+    // Processed levels are always RGBA8, so every row meets the default unpack alignment of 4
+    for (std::size_t level = firstLevel; level < endLevel; ++level)
+    {
+        const ImageLevel& imageLevel = levels[level];
+        if (image.compressed)
+        {
+            glCompressedTexImage2D(target, static_cast<int>(level), internalFormat, imageLevel.width, imageLevel.height, 0,
+                                   static_cast<GLsizei>(imageLevel.size), getSource(imageLevel.offset));
+        }
+        else
+        {
+            glTexImage2D(target, static_cast<int>(level), static_cast<int>(internalFormat), imageLevel.width, imageLevel.height, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, getSource(imageLevel.offset));
+        }
+    }
+
+    if (isMapped)
+    {
+        pixelBuffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+}
+
+GLenum TextureLoader::GetInternalFormat(const GLenum requestedFormat, const bool isSRGB, const DecodedImage& image)
+{
+    if (image.compressed)
+        return BlockCompression::GetInternalFormat(image.compressed->format, isSRGB || IsSRGBFormat(requestedFormat));
+    if (requestedFormat != GLenum())
+        return requestedFormat;
+
+    switch (image.components)
+    {
+        case 1:     return GL_RED;
+        case 2:     return GL_RG;
+        case 3:     return isSRGB ? GL_SRGB : GL_RGB;
+        default:    return isSRGB ? GL_SRGB_ALPHA : GL_RGBA;
+    }
+}
+
+std::size_t TextureLoader::GetTailLevel(const DecodedImage& image)
+{
+    const std::vector<ImageLevel>& levels = image.GetLevels();
+
+    std::size_t level = 0;
+    while (level + 1 < levels.size() && std::max(levels[level].width, levels[level].height) > STREAMING_TAIL_SIZE)
+        ++level;
+
+    return level;
+}
+
+std::size_t TextureLoader::GetImageLevelBytes(const DecodedImage& image, const std::size_t level)
+{
+    const ImageLevel& imageLevel = image.GetLevels()[level];
+    return image.compressed ? imageLevel.size : static_cast<std::size_t>(imageLevel.width) * imageLevel.height * image.components;
+}
+
+std::size_t TextureLoader::GetFreePixelBufferCount()
+{
+    std::size_t freeCount = 0;
+
+    for (; freeCount < mPixelBuffers.size(); ++freeCount)
+    {
+        PixelBuffer& pixelBuffer = mPixelBuffers[(mNextPixelBuffer + freeCount) % mPixelBuffers.size()];
+        if (pixelBuffer.fence == nullptr)
+            continue;
+
+        int status;
+        glGetSynciv(pixelBuffer.fence, GL_SYNC_STATUS, 1, nullptr, &status);
+        if (status != GL_SIGNALED)
+            break;
+
+        glDeleteSync(pixelBuffer.fence);
+        pixelBuffer.fence = nullptr;
+    }
+
+    return freeCount;
+}
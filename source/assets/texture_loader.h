@@ -0,0 +1,182 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "texture_compression.h"
+
+namespace Utility
+{
+    class FileWatcher;
+}
+
+namespace Assets
+{
+    struct TextureTiming
+    {
+        std::string path;
+        int width, height;
+        double decodeMilliseconds;
+        double processMilliseconds;
+        double encodeMilliseconds;
+        double uploadMilliseconds;
+        double residentMilliseconds;
+    };
+
+    struct TextureMemory
+    {
+        std::size_t residentBytes;
+        std::size_t uncompressedBytes;
+    };
+
+    struct TextureResidency
+    {
+        int width, height;
+        int levelCount;
+        // Finest level on the GPU, and the coarse level the texture never drops below
+        int residentLevel;
+        int tailLevel;
+    };
+
+    /*
+     * Decodes images on the shared thread pool and streams them to the GPU through a ring of pixel
+     * buffer objects. Flipping, alpha premultiplication and mip generation happen on the workers too,
+     * so Update only copies finished levels. Every load returns its texture name immediately, the
+     * texture shows a 1x1 placeholder until Update has uploaded the decoded data into it
+     */
+    class TextureLoader
+    {
+    public:
+        TextureLoader();
+        // Deletes the pixel buffers and the fences of uploads still in flight, destroy while the context is still current
+        ~TextureLoader();
+
+        unsigned int LoadTexture(const std::string& path, bool isSRGB);
+        // Uploads only the mip tail and keeps every level on the CPU, so finer levels can be streamed in and evicted later
+        unsigned int LoadStreamedTexture(const std::string& path, bool isSRGB);
+        unsigned int LoadTexture(const char* texturePath, GLenum internalFormat, GLenum outputFormat, GLenum wrapFormat);
+        unsigned int LoadCubemap(const std::vector<std::string>& faces, GLenum internalFormat, GLenum format);
+
+        // Uploads finished decodes, must be called once per frame on the GL thread
+        void Update();
+        // Deletes the texture and drops its upload if it is still pending
+        void DeleteTexture(unsigned int texture);
+
+        // Textures loaded afterwards are reloaded whenever one of their source files is written
+        void SetFileWatcher(Utility::FileWatcher* fileWatcher);
+        // Decodes the source files again with the settings of the original load. The texture keeps its current
+        // data until Update uploads the new one, and keeps it for good when the new decode fails
+        void ReloadTexture(unsigned int texture);
+
+        // Empty until a streamed texture has been decoded and its tail uploaded
+        std::optional<TextureResidency> GetResidency(unsigned int texture) const;
+        std::size_t GetLevelBytes(unsigned int texture, int level) const;
+        // Uploads the next finer level of a streamed texture, false when every pixel buffer is still in flight
+        bool StreamInLevel(unsigned int texture);
+        // Frees every level finer than level, the tail always stays resident
+        void EvictLevels(unsigned int texture, int level);
+
+        void SetFlipVertically(bool flipVertically);
+        bool GetFlipVertically() const;
+        // Textures loaded afterwards need a GL_ONE, GL_ONE_MINUS_SRC_ALPHA blend function
+        void SetPremultiplyAlpha(bool premultiplyAlpha);
+        bool GetPremultiplyAlpha() const;
+        // Block compresses colour textures on the CPU when the driver supports S3TC, applies to later loads
+        void SetCompression(bool isEnabled, CompressionQuality quality);
+        bool IsCompressionEnabled() const;
+        CompressionQuality GetCompressionQuality() const;
+
+        std::size_t GetPendingCount() const;
+        TextureMemory GetMemory(unsigned int texture) const;
+        const std::vector<TextureTiming>& GetTimings() const;
+
+    private:
+        struct DecodedImage
+        {
+            ProcessedImage processed;
+            std::optional<CompressedImage> compressed;
+            int width = 0, height = 0, components = 0;
+            double decodeMilliseconds = 0.0;
+            double processMilliseconds = 0.0;
+            double encodeMilliseconds = 0.0;
+            bool isFromCache = false;
+
+            const std::vector<ImageLevel>& GetLevels() const;
+            std::span<const unsigned char> GetData() const;
+        };
+
+        // Everything needed to decode a texture again, loader settings are captured at load time
+        struct TextureSource
+        {
+            GLenum target;
+            std::vector<std::string> paths;
+            GLenum internalFormat, format;
+            int desiredComponents;
+            bool isSRGB;
+            bool isStreamed;
+            bool flipVertically;
+            bool premultiplyAlpha;
+        };
+
+        struct TextureRequest
+        {
+            unsigned int texture;
+            TextureSource source;
+            std::vector<std::future<DecodedImage>> faces;
+            bool isReload = false;
+            std::chrono::steady_clock::time_point requestTime;
+        };
+
+        struct StreamedTexture
+        {
+            DecodedImage image;
+            GLenum internalFormat;
+            int residentLevel;
+            int tailLevel;
+        };
+
+        struct PixelBuffer
+        {
+            unsigned int buffer = 0;
+            GLsync fence = nullptr;
+        };
+
+        unsigned int CreatePlaceholder(GLenum target, GLenum wrapFormat, GLenum minFilter);
+        void QueueRequest(unsigned int texture, const TextureSource& source, bool isReload);
+        std::future<DecodedImage> DecodeAsync(const std::string& path, const TextureSource& source) const;
+        bool UploadRequest(TextureRequest& request, std::size_t& uploadedBytes);
+        void UploadImage(GLenum target, GLenum internalFormat, const DecodedImage& image, std::size_t firstLevel, std::size_t endLevel);
+        static GLenum GetInternalFormat(GLenum requestedFormat, bool isSRGB, const DecodedImage& image);
+        static std::size_t GetTailLevel(const DecodedImage& image);
+        static std::size_t GetImageLevelBytes(const DecodedImage& image, std::size_t level);
+        std::size_t GetFreePixelBufferCount();
+
+        std::vector<TextureRequest> mPendingRequests;
+        std::vector<PixelBuffer> mPixelBuffers;
+        std::vector<TextureTiming> mTimings;
+        std::unordered_map<unsigned int, TextureMemory> mMemory;
+        std::unordered_map<unsigned int, StreamedTexture> mStreamedTextures;
+        std::unordered_map<unsigned int, TextureSource> mSources;
+        std::unordered_map<unsigned int, std::vector<unsigned int>> mSourceWatches;
+        Utility::FileWatcher* mFileWatcher = nullptr;
+        std::size_t mNextPixelBuffer = 0;
+        bool mFlipVertically = false;
+        bool mPremultiplyAlpha = false;
+
+        bool mIsCompressionSupported = false;
+        bool mIsCompressionEnabled = false;
+        CompressionQuality mCompressionQuality = CompressionQuality::Balanced;
+
+        static constexpr std::size_t PIXEL_BUFFER_COUNT = 8;
+        static constexpr std::size_t UPLOAD_BYTES_PER_FRAME = 32 * 1024 * 1024;
+        static constexpr int STREAMING_TAIL_SIZE = 64;
+    };
+}
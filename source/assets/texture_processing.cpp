@@ -0,0 +1,371 @@
+#include "texture_processing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXTURE_PROCESSING_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "../utility/thread_pool.h"
+
+namespace
+{
+    constexpr std::size_t MIN_PARALLEL_PIXELS = 16 * 1024;
+    // Linear values are quantised this finely before the lookup back to sRGB, enough to round trip every byte
+    constexpr int LINEAR_STEPS = 16384;
+
+    struct ConversionTables
+    {
+        float srgbToLinear[256];
+        float byteToUnit[256];
+        unsigned char linearToSRGB[LINEAR_STEPS];
+    };
+
+    const ConversionTables& GetConversionTables()
+    {
+        static const ConversionTables tables = []
+        {
+            ConversionTables result;
+            for (int i = 0; i < 256; ++i)
+            {
+                float value = static_cast<float>(i) / 255.0f;
+                result.byteToUnit[i] = value;
+                result.srgbToLinear[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+            }
+
+            for (int i = 0; i < LINEAR_STEPS; ++i)
+            {
+                float value = static_cast<float>(i) / (LINEAR_STEPS - 1);
+                float encoded = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+                result.linearToSRGB[i] = static_cast<unsigned char>(std::lround(std::clamp(encoded, 0.0f, 1.0f) * 255.0f));
+            }
+
+            return result;
+        }();
+
+        return tables;
+    }
+
+    /*
+     * One RGBA texel in floating point, a single SSE register when available
+     */
+#ifdef TEXTURE_PROCESSING_SSE2
+    using Texel = __m128;
+
+    Texel MakeTexel(const float red, const float green, const float blue, const float alpha)
+    {
+        return _mm_setr_ps(red, green, blue, alpha);
+    }
+
+    Texel Add(const Texel left, const Texel right)
+    {
+        return _mm_add_ps(left, right);
+    }
+
+    Texel Multiply(const Texel left, const Texel right)
+    {
+        return _mm_mul_ps(left, right);
+    }
+
+    float GetAlpha(const Texel texel)
+    {
+        return _mm_cvtss_f32(_mm_shuffle_ps(texel, texel, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+
+    void StoreRounded(const Texel texel, int* values)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values), _mm_cvtps_epi32(texel));
+    }
+#else
+    struct Texel
+    {
+        float values[4];
+    };
+
+    Texel MakeTexel(const float red, const float green, const float blue, const float alpha)
+    {
+        return { { red, green, blue, alpha } };
+    }
+
+    Texel Add(const Texel left, const Texel right)
+    {
+        return { { left.values[0] + right.values[0], left.values[1] + right.values[1],
+                   left.values[2] + right.values[2], left.values[3] + right.values[3] } };
+    }
+
+    Texel Multiply(const Texel left, const Texel right)
+    {
+        return { { left.values[0] * right.values[0], left.values[1] * right.values[1],
+                   left.values[2] * right.values[2], left.values[3] * right.values[3] } };
+    }
+
+    float GetAlpha(const Texel texel)
+    {
+        return texel.values[3];
+    }
+
+    void StoreRounded(const Texel texel, int* values)
+    {
+        for (int channel = 0; channel < 4; ++channel)
+            values[channel] = static_cast<int>(std::lround(texel.values[channel]));
+    }
+#endif
+
+    Texel LoadTexel(const unsigned char* pixel, const float* colorTable, const ConversionTables& tables)
+    {
+        return MakeTexel(colorTable[pixel[0]], colorTable[pixel[1]], colorTable[pixel[2]], tables.byteToUnit[pixel[3]]);
+    }
+
+    void StoreTexel(const Texel texel, const bool isSRGB, const ConversionTables& tables, unsigned char* pixel)
+    {
+        constexpr float LAST_STEP = LINEAR_STEPS - 1;
+        float colorScale = isSRGB ? LAST_STEP : 255.0f;
+
+        int values[4];
+        StoreRounded(Multiply(texel, MakeTexel(colorScale, colorScale, colorScale, 255.0f)), values);
+
+        for (int channel = 0; channel < 3; ++channel)
+        {
+            int value = std::clamp(values[channel], 0, isSRGB ? LINEAR_STEPS - 1 : 255);
+            pixel[channel] = isSRGB ? tables.linearToSRGB[value] : static_cast<unsigned char>(value);
+        }
+        pixel[3] = static_cast<unsigned char>(std::clamp(values[3], 0, 255));
+    }
+
+    void ForEachRowBand(const int rowCount, const int width, Utility::ThreadPool* threadPool, const std::function<void(int, int)>& processRows)
+    {
+        // Small images and mip levels are not worth the hand-off to other threads
+        std::size_t bandCount = threadPool != nullptr ? std::min<std::size_t>(rowCount, 4 * (threadPool->GetThreadCount() + 1)) : 1;
+        if (bandCount <= 1 || static_cast<std::size_t>(width) * rowCount < MIN_PARALLEL_PIXELS)
+        {
+            processRows(0, rowCount);
+            return;
+        }
+
+        threadPool->ParallelFor(bandCount, [&](const std::size_t band)
+        {
+            processRows(static_cast<int>(band * rowCount / bandCount), static_cast<int>((band + 1) * rowCount / bandCount));
+        });
+    }
+
+    void ConvertRow(const unsigned char* source, const int width, const int components, unsigned char* destination)
+    {
+        if (components == 4)
+        {
+            std::memcpy(destination, source, static_cast<std::size_t>(width) * 4);
+            return;
+        }
+
+        int x = 0;
+#ifdef TEXTURE_PROCESSING_SSE2
+        // Four RGB pixels per iteration, each read as a 32 bit word whose top byte is overwritten by opaque alpha.
+        // The last word reaches one byte into the next pixel, so the loop stops a pixel short of the row end
+        if (components == 3)
+        {
+            const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+            for (; x + 4 < width; x += 4)
+            {
+                alignas(16) std::uint32_t words[4];
+                for (int i = 0; i < 4; ++i)
+                    std::memcpy(&words[i], source + 3 * (x + i), sizeof(std::uint32_t));
+
+                __m128i pixels = _mm_or_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(words)), opaque);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 4 * x), pixels);
+            }
+        }
+#endif
+
+        for (; x < width; ++x)
+        {
+            const unsigned char* pixel = source + static_cast<std::size_t>(x) * components;
+            unsigned char* output = destination + static_cast<std::size_t>(x) * 4;
+            output[0] = pixel[0];
+            output[1] = components > 1 ? pixel[1] : 0;
+            output[2] = components > 2 ? pixel[2] : 0;
+            output[3] = components > 3 ? pixel[3] : 255;
+        }
+    }
+
+    unsigned char PremultiplyChannel(const unsigned char value, const unsigned char alpha)
+    {
+        // value * alpha / 255 rounded, without the division
+        int product = value * alpha + 128;
+        return static_cast<unsigned char>((product + (product >> 8)) >> 8);
+    }
+
+    void PremultiplyLinearRow(unsigned char* pixels, const int width)
+    {
+        int x = 0;
+#ifdef TEXTURE_PROCESSING_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i rounding = _mm_set1_epi16(128);
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+        for (; x + 4 <= width; x += 4)
+        {
+            __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 4 * x));
+            __m128i halves[2] = { _mm_unpacklo_epi8(source, zero), _mm_unpackhi_epi8(source, zero) };
+
+            for (__m128i& half : halves)
+            {
+                __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(half, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+                __m128i product = _mm_add_epi16(_mm_mullo_epi16(half, alpha), rounding);
+                half = _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+            }
+
+            __m128i result = _mm_packus_epi16(halves[0], halves[1]);
+            result = _mm_or_si128(_mm_andnot_si128(alphaMask, result), _mm_and_si128(alphaMask, source));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + 4 * x), result);
+        }
+#endif
+
+        for (; x < width; ++x)
+        {
+            unsigned char* pixel = pixels + static_cast<std::size_t>(x) * 4;
+            for (int channel = 0; channel < 3; ++channel)
+                pixel[channel] = PremultiplyChannel(pixel[channel], pixel[3]);
+        }
+    }
+
+    void PremultiplySRGBRow(unsigned char* pixels, const int width, const ConversionTables& tables)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            unsigned char* pixel = pixels + static_cast<std::size_t>(x) * 4;
+            if (pixel[3] == 255)
+                continue;
+
+            float alpha = tables.byteToUnit[pixel[3]];
+            Texel texel = LoadTexel(pixel, tables.srgbToLinear, tables);
+            StoreTexel(Multiply(texel, MakeTexel(alpha, alpha, alpha, 1.0f)), true, tables, pixel);
+        }
+    }
+
+    void DownsampleRow(const unsigned char* row0, const unsigned char* row1, const int width, const int nextWidth, const bool isSRGB,
+                       const bool isPremultiplied, const ConversionTables& tables, unsigned char* output)
+    {
+        const float* colorTable = isSRGB ? tables.srgbToLinear : tables.byteToUnit;
+        const Texel quarter = MakeTexel(0.25f, 0.25f, 0.25f, 0.25f);
+
+        for (int x = 0; x < nextWidth; ++x)
+        {
+            std::size_t x0 = static_cast<std::size_t>(std::min(2 * x, width - 1)) * 4;
+            std::size_t x1 = static_cast<std::size_t>(std::min(2 * x + 1, width - 1)) * 4;
+            const unsigned char* sources[] = { row0 + x0, row0 + x1, row1 + x0, row1 + x1 };
+
+            Texel weighted = MakeTexel(0.0f, 0.0f, 0.0f, 0.0f);
+            Texel straight = weighted;
+            for (const unsigned char* source : sources)
+            {
+                Texel texel = LoadTexel(source, colorTable, tables);
+                if (isPremultiplied)
+                {
+                    weighted = Add(weighted, texel);
+                    continue;
+                }
+
+                float alpha = tables.byteToUnit[source[3]];
+                weighted = Add(weighted, Multiply(texel, MakeTexel(alpha, alpha, alpha, 1.0f)));
+                straight = Add(straight, texel);
+            }
+
+            Texel result = Multiply(weighted, quarter);
+            if (!isPremultiplied)
+            {
+                // Fully transparent texels keep their plain average so filtering at cut-out edges has a colour to blend to
+                float alpha = GetAlpha(result);
+                result = alpha > 0.0f ? Multiply(result, MakeTexel(1.0f / alpha, 1.0f / alpha, 1.0f / alpha, 1.0f)) : Multiply(straight, quarter);
+            }
+
+            StoreTexel(result, isSRGB, tables, output + static_cast<std::size_t>(x) * 4);
+        }
+    }
+}
+
+Assets::ProcessedImage Assets::TextureProcessing::ProcessImage(const unsigned char* pixels, const int width, const int height,
+                                                               const int components, const ProcessingSettings& settings,
+                                                               Utility::ThreadPool* threadPool)
+{
+    ProcessedImage image;
+
+    std::size_t totalSize = 0;
+    for (int levelWidth = width, levelHeight = height; ; levelWidth = std::max(1, levelWidth / 2), levelHeight = std::max(1, levelHeight / 2))
+    {
+        std::size_t size = static_cast<std::size_t>(levelWidth) * levelHeight * 4;
+        image.levels.push_back({ levelWidth, levelHeight, totalSize, size });
+        totalSize += size;
+
+        if (!settings.hasMipmaps || (levelWidth == 1 && levelHeight == 1))
+            break;
+    }
+
+    image.pixels.resize(totalSize);
+    ConvertToRGBA(pixels, width, height, components, settings.flipVertically, image.pixels.data(), threadPool);
+
+    if (settings.premultiplyAlpha)
+        PremultiplyAlpha(image.pixels.data(), width, height, settings.isSRGB, threadPool);
+
+    for (std::size_t level = 1; level < image.levels.size(); ++level)
+    {
+        const ImageLevel& previous = image.levels[level - 1];
+        Downsample(image.pixels.data() + previous.offset, previous.width, previous.height, settings.isSRGB, settings.premultiplyAlpha,
+                   image.pixels.data() + image.levels[level].offset, threadPool);
+    }
+
+    return image;
+}
+
+void Assets::TextureProcessing::ConvertToRGBA(const unsigned char* pixels, const int width, const int height, const int components,
+                                              const bool flipVertically, unsigned char* output, Utility::ThreadPool* threadPool)
+{
+    ForEachRowBand(height, width, threadPool, [&](const int firstRow, const int lastRow)
+    {
+        for (int y = firstRow; y < lastRow; ++y)
+        {
+            int outputY = flipVertically ? height - 1 - y : y;
+            ConvertRow(pixels + static_cast<std::size_t>(y) * width * components, width, components,
+                       output + static_cast<std::size_t>(outputY) * width * 4);
+        }
+    });
+}
+
+void Assets::TextureProcessing::PremultiplyAlpha(unsigned char* pixels, const int width, const int height, const bool isSRGB,
+                                                 Utility::ThreadPool* threadPool)
+{
+    const ConversionTables& tables = GetConversionTables();
+
+    ForEachRowBand(height, width, threadPool, [&](const int firstRow, const int lastRow)
+    {
+        for (int y = firstRow; y < lastRow; ++y)
+        {
+            unsigned char* row = pixels + static_cast<std::size_t>(y) * width * 4;
+            if (isSRGB)
+                PremultiplySRGBRow(row, width, tables);
+            else
+                PremultiplyLinearRow(row, width);
+        }
+    });
+}
+
+void Assets::TextureProcessing::Downsample(const unsigned char* pixels, const int width, const int height, const bool isSRGB,
+                                           const bool isPremultiplied, unsigned char* output, Utility::ThreadPool* threadPool)
+{
+    const ConversionTables& tables = GetConversionTables();
+    int nextWidth = std::max(1, width / 2);
+    int nextHeight = std::max(1, height / 2);
+
+    ForEachRowBand(nextHeight, nextWidth, threadPool, [&](const int firstRow, const int lastRow)
+    {
+        for (int y = firstRow; y < lastRow; ++y)
+        {
+            const unsigned char* row0 = pixels + static_cast<std::size_t>(std::min(2 * y, height - 1)) * width * 4;
+            const unsigned char* row1 = pixels + static_cast<std::size_t>(std::min(2 * y + 1, height - 1)) * width * 4;
+            DownsampleRow(row0, row1, width, nextWidth, isSRGB, isPremultiplied, tables, output + static_cast<std::size_t>(y) * nextWidth * 4);
+        }
+    });
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Utility
+{
+    class ThreadPool;
+}
+
+namespace Assets
+{
+    struct ImageLevel
+    {
+        int width, height;
+        std::size_t offset, size;
+    };
+
+    // An RGBA8 image and its mip chain in one allocation, level offsets are relative to pixels
+    struct ProcessedImage
+    {
+        std::vector<ImageLevel> levels;
+        std::vector<unsigned char> pixels;
+    };
+
+    // Everything besides the source pixels that changes the processed result
+    struct ProcessingSettings
+    {
+        bool flipVertically;
+        bool premultiplyAlpha;
+        bool isSRGB;
+        bool hasMipmaps;
+    };
+
+    /*
+     * CPU side texture preparation, so textures reach the GL thread ready to upload level by level. Every
+     * step takes an optional thread pool and splits its rows into bands over it
+     */
+    namespace TextureProcessing
+    {
+        // Expands to RGBA, flips and premultiplies level 0, then filters the remaining levels from it
+        ProcessedImage ProcessImage(const unsigned char* pixels, int width, int height, int components,
+                                    const ProcessingSettings& settings, Utility::ThreadPool* threadPool);
+
+        // One and two channel images keep their channels in red and green, missing alpha becomes opaque
+        void ConvertToRGBA(const unsigned char* pixels, int width, int height, int components, bool flipVertically,
+                           unsigned char* output, Utility::ThreadPool* threadPool);
+        // sRGB colour is multiplied in linear space and encoded again
+        void PremultiplyAlpha(unsigned char* pixels, int width, int height, bool isSRGB, Utility::ThreadPool* threadPool);
+        // 2x2 box filter in linear space. Straight alpha images are weighted by alpha, so transparent texels
+        // do not bleed their colour into the smaller levels
+        void Downsample(const unsigned char* pixels, int width, int height, bool isSRGB, bool isPremultiplied,
+                        unsigned char* output, Utility::ThreadPool* threadPool);
+    }
+}
@@ -0,0 +1,182 @@
+#include "texture_streamer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+
+using Assets::TextureStreamer;
+
+TextureStreamer::TextureStreamer(TextureLoader& textureLoader) : mTextureLoader(textureLoader) {}
+
+void TextureStreamer::SetBudget(const std::size_t budgetBytes)
+{
+    mBudgetBytes = budgetBytes;
+}
+
+std::size_t TextureStreamer::GetBudget() const
+{
+    return mBudgetBytes;
+}
+
+void TextureStreamer::SetView(const glm::mat4& view, const glm::mat4& projection)
+{
+    mView = view;
+    mProjection = projection;
+
+    int viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    mViewportHeight = static_cast<float>(std::max(1, viewport[3]));
+}
+
+void TextureStreamer::RecordDraw(const std::span<const unsigned int> textures, const glm::mat4& model, const glm::vec3& boundsCenter,
+                                 const float boundsRadius, const float texelDensity)
+{
+    float scale = std::sqrt(std::max({ glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+                                       glm::dot(glm::vec3(model[1]), glm::vec3(model[1])),
+                                       glm::dot(glm::vec3(model[2]), glm::vec3(model[2])) }));
+    if (scale <= 0.0f)
+        return;
+
+    // Entirely behind the camera, nothing of it reaches the screen
+    glm::vec4 viewCenter = mView * model * glm::vec4(boundsCenter, 1.0f);
+    float radius = boundsRadius * scale;
+    if (viewCenter.z - radius > 0.0f)
+        return;
+
+    // The nearest point of the bounds decides how many pixels a world unit covers
+    float distance = std::max(NEAR_DISTANCE, -viewCenter.z - radius);
+    float pixelsPerUnit = mProjection[1][1] * mViewportHeight * 0.5f / distance;
+
+    for (unsigned int texture : textures)
+    {
+        std::optional<TextureResidency> residency = mTextureLoader.GetResidency(texture);
+        if (!residency)
+            continue;
+
+        // Each level halves the texels per unit, so the wanted level is how many halvings bring it down to one texel per pixel
+        float texelsPerUnit = texelDensity * static_cast<float>(std::max(residency->width, residency->height)) / scale;
+        float ratio = texelsPerUnit / pixelsPerUnit;
+        int level = ratio > 1.0f ? static_cast<int>(std::floor(std::log2(ratio))) : 0;
+
+        RequestLevel(texture, std::clamp(level, 0, residency->levelCount - 1));
+    }
+}
+
+void TextureStreamer::RecordFullResolution(const std::span<const unsigned int> textures)
+{
+    for (unsigned int texture : textures)
+    {
+        if (mTextureLoader.GetResidency(texture))
+            RequestLevel(texture, 0);
+    }
+}
+
+void TextureStreamer::Update()
+{
+    // Textures released since the last frame
+    std::erase_if(mTextures, [this](const auto& entry) { return !mTextureLoader.GetResidency(entry.first); });
+
+    mResidentBytes = 0;
+    for (const auto& [texture, streamed] : mTextures)
+        mResidentBytes += mTextureLoader.GetMemory(texture).residentBytes;
+
+    // Applies a lowered budget right away
+    MakeRoom(0);
+
+    // Textures wanting the finest levels go first, they are the closest to the camera
+    std::vector<std::pair<int, unsigned int>> requests;
+    for (const auto& [texture, streamed] : mTextures)
+    {
+        if (streamed.lastDrawnFrame == mFrame && streamed.wantedLevel < mTextureLoader.GetResidency(texture)->residentLevel)
+            requests.emplace_back(streamed.wantedLevel, texture);
+    }
+    std::sort(requests.begin(), requests.end());
+
+    bool isOverBudget = false;
+    std::size_t frameBytes = 0;
+    for (const auto& [wantedLevel, texture] : requests)
+    {
+        int level = mTextureLoader.GetResidency(texture)->residentLevel - 1;
+        std::size_t bytes = mTextureLoader.GetLevelBytes(texture, level);
+        if (frameBytes > 0 && frameBytes + bytes > STREAM_BYTES_PER_FRAME)
+            break;
+
+        if (!MakeRoom(bytes))
+        {
+            isOverBudget = true;
+            continue;
+        }
+
+        // Out of pixel buffers, the rest waits for the next frame
+        if (!mTextureLoader.StreamInLevel(texture))
+            break;
+
+        frameBytes += bytes;
+        mResidentBytes += bytes;
+        mStreamedBytes += bytes;
+    }
+
+    if (isOverBudget && !mIsOverBudget)
+    {
+        std::cout << "TEXTURE_STREAMING::BUDGET_FULL " << mResidentBytes / (1024 * 1024) << " MB of "
+                  << mBudgetBytes / (1024 * 1024) << " MB resident, visible textures stay at coarser levels" << std::endl;
+    }
+    mIsOverBudget = isOverBudget;
+
+    ++mFrame;
+}
+
+Assets::TextureStreamingStats TextureStreamer::GetStats() const
+{
+    return { mTextures.size(), mResidentBytes, mBudgetBytes, mStreamedBytes, mEvictedBytes };
+}
+
+void TextureStreamer::RequestLevel(const unsigned int texture, const int level)
+{
+    auto [entry, isNew] = mTextures.try_emplace(texture, StreamedTexture { level, mFrame });
+    StreamedTexture& streamed = entry->second;
+
+    // The first draw of a frame replaces last frame's request, later draws can only ask for finer levels
+    streamed.wantedLevel = streamed.lastDrawnFrame == mFrame && !isNew ? std::min(streamed.wantedLevel, level) : level;
+    streamed.lastDrawnFrame = mFrame;
+}
+
+bool TextureStreamer::MakeRoom(const std::size_t bytes)
+{
+    while (mResidentBytes + bytes > mBudgetBytes)
+    {
+        // Least recently drawn texture that holds levels finer than it needs, textures drawn
+        // this frame only give up levels beyond the one they asked for
+        unsigned int victim = 0;
+        int victimLevel = 0;
+        std::uint64_t oldestFrame = std::numeric_limits<std::uint64_t>::max();
+
+        for (const auto& [texture, streamed] : mTextures)
+        {
+            TextureResidency residency = *mTextureLoader.GetResidency(texture);
+            int keptLevel = streamed.lastDrawnFrame == mFrame ? streamed.wantedLevel : residency.tailLevel;
+
+            if (residency.residentLevel < keptLevel && streamed.lastDrawnFrame < oldestFrame)
+            {
+                victim = texture;
+                victimLevel = residency.residentLevel;
+                oldestFrame = streamed.lastDrawnFrame;
+            }
+        }
+
+        if (oldestFrame == std::numeric_limits<std::uint64_t>::max())
+            return false;
+
+        std::size_t freedBytes = mTextureLoader.GetLevelBytes(victim, victimLevel);
+        mTextureLoader.EvictLevels(victim, victimLevel + 1);
+        mResidentBytes -= freedBytes;
+        mEvictedBytes += freedBytes;
+    }
+
+    return true;
+}
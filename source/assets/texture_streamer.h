@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+
+#include <../../libraries/glm/glm.hpp>
+
+#include "texture_loader.h"
+
+namespace Assets
+{
+    struct TextureStreamingStats
+    {
+        std::size_t textureCount;
+        std::size_t residentBytes;
+        std::size_t budgetBytes;
+        std::size_t streamedBytes;
+        std::size_t evictedBytes;
+    };
+
+    /*
+     * Keeps streamed textures at the mip level their on-screen footprint needs. Draws report the level each
+     * texture wants, Update streams in one finer level per texture and frame, and when that would exceed the
+     * budget it evicts levels from the least recently drawn textures first
+     */
+    class TextureStreamer
+    {
+    public:
+        explicit TextureStreamer(TextureLoader& textureLoader);
+
+        void SetBudget(std::size_t budgetBytes);
+        std::size_t GetBudget() const;
+
+        // Camera used to turn the following draws into screen-space footprints
+        void SetView(const glm::mat4& view, const glm::mat4& projection);
+        // Bounds are in model space, texelDensity is texture coordinate units per model space unit
+        void RecordDraw(std::span<const unsigned int> textures, const glm::mat4& model, const glm::vec3& boundsCenter,
+                        float boundsRadius, float texelDensity);
+        // For draws without a single transform, such as instanced ones
+        void RecordFullResolution(std::span<const unsigned int> textures);
+
+        // Streams and evicts for the draws recorded since the last call, call once per frame on the GL thread
+        void Update();
+
+        TextureStreamingStats GetStats() const;
+
+    private:
+        struct StreamedTexture
+        {
+            int wantedLevel;
+            std::uint64_t lastDrawnFrame;
+        };
+
+        void RequestLevel(unsigned int texture, int level);
+        bool MakeRoom(std::size_t bytes);
+
+        TextureLoader& mTextureLoader;
+        std::unordered_map<unsigned int, StreamedTexture> mTextures;
+        std::uint64_t mFrame = 1;
+
+        glm::mat4 mView = glm::mat4(1.0f);
+        glm::mat4 mProjection = glm::mat4(1.0f);
+        float mViewportHeight = 1.0f;
+
+        std::size_t mBudgetBytes = DEFAULT_BUDGET_BYTES;
+        std::size_t mResidentBytes = 0;
+        std::size_t mStreamedBytes = 0;
+        std::size_t mEvictedBytes = 0;
+        bool mIsOverBudget = false;
+
+        static constexpr std::size_t DEFAULT_BUDGET_BYTES = 256 * 1024 * 1024;
+        static constexpr std::size_t STREAM_BYTES_PER_FRAME = 16 * 1024 * 1024;
+        static constexpr float NEAR_DISTANCE = 0.1f;
+    };
+}
@@ -0,0 +1,183 @@
+#include "cluster_culler.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLUSTER_CULLER_SSE2
+#include <emmintrin.h>
+#endif
+
+using Geometry::ClusterCuller;
+
+namespace
+{
+    constexpr int FRUSTUM_PLANE_COUNT = 6;
+
+    // Planes of the clip volume of the given matrix, normalized so they measure distance in its input space
+    void ExtractFrustumPlanes(const glm::mat4& matrix, glm::vec4 (&planes)[FRUSTUM_PLANE_COUNT])
+    {
+        glm::vec4 rows[4];
+        for (int row = 0; row < 4; ++row)
+            rows[row] = glm::vec4(matrix[0][row], matrix[1][row], matrix[2][row], matrix[3][row]);
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            planes[axis * 2] = rows[3] + rows[axis];
+            planes[axis * 2 + 1] = rows[3] - rows[axis];
+        }
+
+        for (glm::vec4& plane : planes)
+            plane /= glm::length(glm::vec3(plane));
+    }
+
+#ifndef CLUSTER_CULLER_SSE2
+    // Same tests as the SSE path, one meshlet at a time
+    void CullMeshlet(const Geometry::MeshletBounds& bounds, const std::size_t i, const glm::vec4 (&planes)[FRUSTUM_PLANE_COUNT],
+                     const glm::vec3& camera, bool& isOutside, bool& isBackfacing)
+    {
+        glm::vec3 center(bounds.centerX[i], bounds.centerY[i], bounds.centerZ[i]);
+        float radius = bounds.radius[i];
+
+        isOutside = false;
+        for (const glm::vec4& plane : planes)
+            isOutside |= glm::dot(glm::vec3(plane), center) + plane.w < -radius;
+
+        glm::vec3 offset = center - camera;
+        glm::vec3 axis(bounds.coneAxisX[i], bounds.coneAxisY[i], bounds.coneAxisZ[i]);
+        isBackfacing = glm::dot(offset, axis) >= bounds.coneCutoff[i] * glm::length(offset) + radius;
+    }
+#endif
+}
+
+void ClusterCuller::SetView(const glm::mat4& view, const glm::mat4& projection)
+{
+    mView = view;
+    mProjection = projection;
+}
+
+std::size_t ClusterCuller::Cull(const MeshletBounds& bounds, const std::size_t meshletCount, const glm::mat4& model,
+                                std::vector<unsigned char>& visibility)
+{
+    /*
+     * Bring the frustum and the camera into model space instead of every meshlet into view space. Non-uniform
+     * scale is fine, planes are normalized in model space and back-facing is preserved by affine transforms
+     */
+    glm::vec4 planes[FRUSTUM_PLANE_COUNT];
+    ExtractFrustumPlanes(mProjection * mView * model, planes);
+    glm::vec3 camera = glm::vec3(glm::inverse(mView * model)[3]);
+
+    visibility.resize(bounds.radius.size());
+    std::size_t frustumCulledCount = 0, backfaceCulledCount = 0;
+
+#ifdef CLUSTER_CULLER_SSE2
+    __m128 planeX[FRUSTUM_PLANE_COUNT], planeY[FRUSTUM_PLANE_COUNT], planeZ[FRUSTUM_PLANE_COUNT], planeW[FRUSTUM_PLANE_COUNT];
+    for (int plane = 0; plane < FRUSTUM_PLANE_COUNT; ++plane)
+    {
+        planeX[plane] = _mm_set1_ps(planes[plane].x);
+        planeY[plane] = _mm_set1_ps(planes[plane].y);
+        planeZ[plane] = _mm_set1_ps(planes[plane].z);
+        planeW[plane] = _mm_set1_ps(planes[plane].w);
+    }
+
+    __m128 cameraX = _mm_set1_ps(camera.x), cameraY = _mm_set1_ps(camera.y), cameraZ = _mm_set1_ps(camera.z);
+    __m128 zero = _mm_setzero_ps();
+
+    for (std::size_t i = 0; i < meshletCount; i += Meshlets::BOUNDS_ALIGNMENT)
+    {
+        __m128 centerX = _mm_loadu_ps(&bounds.centerX[i]);
+        __m128 centerY = _mm_loadu_ps(&bounds.centerY[i]);
+        __m128 centerZ = _mm_loadu_ps(&bounds.centerZ[i]);
+        __m128 radius = _mm_loadu_ps(&bounds.radius[i]);
+        __m128 negativeRadius = _mm_sub_ps(zero, radius);
+
+        __m128 outside = zero;
+        for (int plane = 0; plane < FRUSTUM_PLANE_COUNT; ++plane)
+        {
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[plane], centerX), _mm_mul_ps(planeY[plane], centerY)),
+                                         _mm_add_ps(_mm_mul_ps(planeZ[plane], centerZ), planeW[plane]));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeRadius));
+        }
+
+        __m128 offsetX = _mm_sub_ps(centerX, cameraX);
+        __m128 offsetY = _mm_sub_ps(centerY, cameraY);
+        __m128 offsetZ = _mm_sub_ps(centerZ, cameraZ);
+        __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(offsetX, offsetX), _mm_mul_ps(offsetY, offsetY)),
+                                                 _mm_mul_ps(offsetZ, offsetZ)));
+        __m128 alongAxis = _mm_add_ps(_mm_add_ps(_mm_mul_ps(offsetX, _mm_loadu_ps(&bounds.coneAxisX[i])),
+                                                 _mm_mul_ps(offsetY, _mm_loadu_ps(&bounds.coneAxisY[i]))),
+                                      _mm_mul_ps(offsetZ, _mm_loadu_ps(&bounds.coneAxisZ[i])));
+        __m128 backfacing = _mm_cmpge_ps(alongAxis, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&bounds.coneCutoff[i]), distance), radius));
+
+        // Padding past the last meshlet is left out of the counts
+        std::size_t laneCount = std::min<std::size_t>(Meshlets::BOUNDS_ALIGNMENT, meshletCount - i);
+        auto laneMask = static_cast<unsigned int>((1u << laneCount) - 1);
+        auto outsideMask = static_cast<unsigned int>(_mm_movemask_ps(outside)) & laneMask;
+        auto backfacingMask = static_cast<unsigned int>(_mm_movemask_ps(backfacing)) & laneMask & ~outsideMask;
+
+        frustumCulledCount += std::popcount(outsideMask);
+        backfaceCulledCount += std::popcount(backfacingMask);
+
+        unsigned int visibleMask = ~(outsideMask | backfacingMask);
+        for (std::size_t lane = 0; lane < Meshlets::BOUNDS_ALIGNMENT; ++lane)
+            visibility[i + lane] = static_cast<unsigned char>((visibleMask >> lane) & 1u);
+    }
+#else
+    for (std::size_t i = 0; i < meshletCount; ++i)
+    {
+        bool isOutside, isBackfacing;
+        CullMeshlet(bounds, i, planes, camera, isOutside, isBackfacing);
+
+        frustumCulledCount += isOutside;
+        backfaceCulledCount += !isOutside && isBackfacing;
+        visibility[i] = !isOutside && !isBackfacing;
+    }
+#endif
+
+    mStats.meshletCount += meshletCount;
+    mStats.frustumCulledCount += frustumCulledCount;
+    mStats.backfaceCulledCount += backfaceCulledCount;
+
+    return meshletCount - frustumCulledCount - backfaceCulledCount;
+}
+
+const Geometry::ClusterDrawList& ClusterCuller::BuildDrawList(const std::span<const Meshlet> meshlets, const MeshletBounds& bounds,
+                                                              const glm::mat4& model)
+{
+    mDrawList.firstIndices.clear();
+    mDrawList.counts.clear();
+
+    Cull(bounds, meshlets.size(), model, mVisibility);
+
+    // Meshlets are consecutive in the index buffer, so a run of visible ones is a single draw
+    std::size_t runEnd = 0;
+    for (std::size_t i = 0; i < meshlets.size(); ++i)
+    {
+        if (!mVisibility[i])
+            continue;
+
+        auto count = static_cast<int>(meshlets[i].triangleCount * 3);
+        if (!mDrawList.counts.empty() && runEnd == i)
+            mDrawList.counts.back() += count;
+        else
+        {
+            mDrawList.firstIndices.push_back(meshlets[i].firstIndex);
+            mDrawList.counts.push_back(count);
+        }
+
+        runEnd = i + 1;
+    }
+
+    return mDrawList;
+}
+
+Geometry::ClusterCullingStats ClusterCuller::GetStats() const
+{
+    return mStats;
+}
+
+void ClusterCuller::ResetStats()
+{
+    mStats = {};
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <../../libraries/glm/glm.hpp>
+
+#include "meshlet.h"
+
+namespace Geometry
+{
+    struct ClusterCullingStats
+    {
+        std::size_t meshletCount;
+        std::size_t frustumCulledCount;
+        std::size_t backfaceCulledCount;
+    };
+
+    // Index ranges of the meshlets that survived culling with neighbouring ones merged, as Mesh::DrawRanges takes them
+    struct ClusterDrawList
+    {
+        std::vector<unsigned int> firstIndices;
+        std::vector<int> counts;
+    };
+
+    /*
+     * Rejects meshlets outside the view frustum or facing away from the camera before they are drawn. The tests
+     * run in model space, so per draw only the camera is transformed, and cover four meshlets at a time with SSE
+     * when it is available. The context is OpenGL 3.3, which has no compute shaders, so culling stays on the CPU
+     */
+    class ClusterCuller
+    {
+    public:
+        // Camera used for the following draws
+        void SetView(const glm::mat4& view, const glm::mat4& projection);
+
+        // One flag per meshlet in visibility, returns how many are visible
+        std::size_t Cull(const MeshletBounds& bounds, std::size_t meshletCount, const glm::mat4& model,
+                         std::vector<unsigned char>& visibility);
+        // Valid until the next call
+        const ClusterDrawList& BuildDrawList(std::span<const Meshlet> meshlets, const MeshletBounds& bounds, const glm::mat4& model);
+
+        // Counted over every cull since the last reset
+        ClusterCullingStats GetStats() const;
+        void ResetStats();
+
+    private:
+        glm::mat4 mView = glm::mat4(1.0f);
+        glm::mat4 mProjection = glm::mat4(1.0f);
+
+        std::vector<unsigned char> mVisibility;
+        ClusterDrawList mDrawList;
+        ClusterCullingStats mStats {};
+    };
+}
@@ -14,12 +14,20 @@ namespace Geometry
         int materialIndex;
     };
 
-    struct Face
+    // Layout of a mesh's vertex buffer, Quantized uploads QuantizedVertex instead of Vertex
+    enum class VertexFormat
     {
-        std::vector<unsigned int> vertexIndices;
-        std::vector<unsigned int> normalIndices;
-        std::vector<unsigned int> textureCoordinateIndices;
-        std::string materialName;
+        Full,
+        Quantized
+    };
+
+    // One level of detail, a range of the mesh's index buffer over the shared vertices. error is how far the
+    // level's surface strays from the full mesh, in model space units
+    struct MeshLod
+    {
+        unsigned int firstIndex;
+        unsigned int indexCount;
+        float error;
     };
 
     struct Material
@@ -32,10 +40,12 @@ namespace Geometry
         glm::vec3 diffuseColor;
         int diffuseMap;
         bool hasDiffuseMap;
+        std::string diffuseMapPath;
 
         glm::vec3 specularColor;
         int specularMap;
         bool hasSpecularMap;
+        std::string specularMapPath;
 
         glm::vec3 emissiveColor;
 
@@ -0,0 +1,512 @@
+#include "glb_importer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "../assets/asset_pack.h"
+#include "../utility/json.h"
+
+using Utility::JsonValue;
+
+namespace
+{
+    constexpr std::size_t HEADER_SIZE = 12;
+    constexpr std::size_t CHUNK_HEADER_SIZE = 8;
+
+    // Node hierarchies deeper than this are taken to be cyclic
+    constexpr int MAX_NODE_DEPTH = 64;
+
+    constexpr int TRIANGLES_MODE = 4;
+
+    enum ComponentType
+    {
+        BYTE = 5120,
+        UNSIGNED_BYTE = 5121,
+        SHORT = 5122,
+        UNSIGNED_SHORT = 5123,
+        UNSIGNED_INT = 5125,
+        FLOAT = 5126
+    };
+
+    // An accessor resolved to its bytes inside the BIN chunk, element i starts at data + i * stride
+    struct AccessorView
+    {
+        const unsigned char* data = nullptr;
+        std::size_t count = 0;
+        std::size_t stride = 0;
+        int componentType = 0;
+        int componentCount = 0;
+        bool isNormalized = false;
+    };
+
+    struct Document
+    {
+        JsonValue json;
+        std::span<const unsigned char> bin;
+    };
+
+    std::uint32_t ReadUint32(const char* data)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    template<typename T>
+    T ReadComponent(const unsigned char* data)
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    std::size_t GetComponentSize(const int componentType)
+    {
+        switch (componentType)
+        {
+            case BYTE:
+            case UNSIGNED_BYTE:     return 1;
+            case SHORT:
+            case UNSIGNED_SHORT:    return 2;
+            case UNSIGNED_INT:
+            case FLOAT:             return 4;
+            default:                return 0;
+        }
+    }
+
+    int GetComponentCount(const std::string_view type)
+    {
+        if (type == "SCALAR")   return 1;
+        if (type == "VEC2")     return 2;
+        if (type == "VEC3")     return 3;
+        if (type == "VEC4")     return 4;
+
+        return 0;
+    }
+
+    const JsonValue* GetElement(const JsonValue& document, const std::string_view arrayName, const int index)
+    {
+        const JsonValue* array = document.Find(arrayName);
+        if (array == nullptr || index < 0 || static_cast<std::size_t>(index) >= array->GetSize())
+            return nullptr;
+
+        return &array->GetElements()[index];
+    }
+
+    // Nothing when the accessor is missing, sparse, outside the BIN chunk or of a type the engine has no use for
+    std::optional<AccessorView> GetAccessor(const Document& document, const int accessorIndex)
+    {
+        const JsonValue* accessor = GetElement(document.json, "accessors", accessorIndex);
+        if (accessor == nullptr || accessor->Find("sparse") != nullptr)
+            return std::nullopt;
+
+        const JsonValue* bufferView = GetElement(document.json, "bufferViews", accessor->GetInt("bufferView", -1));
+        if (bufferView == nullptr || bufferView->GetInt("buffer", 0) != 0)
+            return std::nullopt;
+
+        AccessorView view;
+        view.componentType = accessor->GetInt("componentType", 0);
+        view.componentCount = GetComponentCount(accessor->GetString("type"));
+        view.count = static_cast<std::size_t>(std::max(accessor->GetNumber("count", 0.0), 0.0));
+        const JsonValue* normalized = accessor->Find("normalized");
+        view.isNormalized = normalized != nullptr && normalized->GetBoolean();
+
+        std::size_t elementSize = GetComponentSize(view.componentType) * view.componentCount;
+        if (elementSize == 0)
+            return std::nullopt;
+
+        auto viewOffset = static_cast<std::size_t>(std::max(bufferView->GetNumber("byteOffset", 0.0), 0.0));
+        auto viewLength = static_cast<std::size_t>(std::max(bufferView->GetNumber("byteLength", 0.0), 0.0));
+        auto accessorOffset = static_cast<std::size_t>(std::max(accessor->GetNumber("byteOffset", 0.0), 0.0));
+        view.stride = static_cast<std::size_t>(std::max(bufferView->GetNumber("byteStride", 0.0), 0.0));
+        if (view.stride == 0)
+            view.stride = elementSize;
+
+        if (viewOffset > document.bin.size() || viewLength > document.bin.size() - viewOffset)
+            return std::nullopt;
+        if (view.count > 0 && (view.stride < elementSize || accessorOffset > viewLength || elementSize > viewLength - accessorOffset
+            || (view.count - 1) > (viewLength - accessorOffset - elementSize) / view.stride))
+            return std::nullopt;
+
+        view.data = document.bin.data() + viewOffset + accessorOffset;
+        return view;
+    }
+
+    // Integer components are normalized when the accessor says so, otherwise converted as they are
+    glm::vec4 ReadElement(const AccessorView& view, const std::size_t index)
+    {
+        const unsigned char* element = view.data + index * view.stride;
+        glm::vec4 value(0.0f);
+
+        for (int component = 0; component < view.componentCount; ++component)
+        {
+            float& result = value[component];
+            switch (view.componentType)
+            {
+                case FLOAT:
+                    result = ReadComponent<float>(element + 4 * component);
+                    break;
+                case UNSIGNED_BYTE:
+                    result = ReadComponent<std::uint8_t>(element + component);
+                    if (view.isNormalized)
+                        result /= 255.0f;
+                    break;
+                case BYTE:
+                    result = ReadComponent<std::int8_t>(element + component);
+                    if (view.isNormalized)
+                        result = std::max(result / 127.0f, -1.0f);
+                    break;
+                case UNSIGNED_SHORT:
+                    result = ReadComponent<std::uint16_t>(element + 2 * component);
+                    if (view.isNormalized)
+                        result /= 65535.0f;
+                    break;
+                case SHORT:
+                    result = ReadComponent<std::int16_t>(element + 2 * component);
+                    if (view.isNormalized)
+                        result = std::max(result / 32767.0f, -1.0f);
+                    break;
+                case UNSIGNED_INT:
+                    result = static_cast<float>(ReadComponent<std::uint32_t>(element + 4 * component));
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        return value;
+    }
+
+    unsigned int ReadIndex(const AccessorView& view, const std::size_t index)
+    {
+        const unsigned char* element = view.data + index * view.stride;
+        switch (view.componentType)
+        {
+            case UNSIGNED_BYTE:     return ReadComponent<std::uint8_t>(element);
+            case UNSIGNED_SHORT:    return ReadComponent<std::uint16_t>(element);
+            case UNSIGNED_INT:      return ReadComponent<std::uint32_t>(element);
+            default:                return 0;
+        }
+    }
+
+    glm::vec3 ReadVec3(const JsonValue& object, const std::string_view key, const glm::vec3& fallback)
+    {
+        const JsonValue* array = object.Find(key);
+        if (array == nullptr || array->GetSize() < 3)
+            return fallback;
+
+        std::span<const JsonValue> elements = array->GetElements();
+        return { elements[0].GetNumber(), elements[1].GetNumber(), elements[2].GetNumber() };
+    }
+
+    glm::mat4 GetNodeTransform(const JsonValue& node)
+    {
+        const JsonValue* matrix = node.Find("matrix");
+        if (matrix != nullptr && matrix->GetSize() == 16)
+        {
+            // Column-major like glm
+            glm::mat4 transform;
+            for (int i = 0; i < 16; ++i)
+                glm::value_ptr(transform)[i] = static_cast<float>(matrix->GetElements()[i].GetNumber());
+
+            return transform;
+        }
+
+        glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
+        const JsonValue* rotationArray = node.Find("rotation");
+        if (rotationArray != nullptr && rotationArray->GetSize() == 4)
+        {
+            std::span<const JsonValue> elements = rotationArray->GetElements();
+            rotation = glm::quat(static_cast<float>(elements[3].GetNumber()), static_cast<float>(elements[0].GetNumber()),
+                                 static_cast<float>(elements[1].GetNumber()), static_cast<float>(elements[2].GetNumber()));
+        }
+
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), ReadVec3(node, "translation", glm::vec3(0.0f)));
+        transform *= glm::mat4_cast(rotation);
+        return glm::scale(transform, ReadVec3(node, "scale", glm::vec3(1.0f)));
+    }
+
+    std::string GetSiblingPath(const char* modelPath, const std::string_view fileName)
+    {
+        std::string path = modelPath;
+        path = path.substr(0, path.find_last_of('/') + 1);
+        path += fileName;
+
+        return path;
+    }
+
+    // Empty when the texture is missing or its image is embedded in the BIN chunk
+    std::string GetTexturePath(const JsonValue& document, const JsonValue* textureInfo, const char* modelPath)
+    {
+        if (textureInfo == nullptr)
+            return {};
+
+        const JsonValue* texture = GetElement(document, "textures", textureInfo->GetInt("index", -1));
+        const JsonValue* image = texture != nullptr ? GetElement(document, "images", texture->GetInt("source", -1)) : nullptr;
+        if (image == nullptr)
+            return {};
+
+        std::string_view uri = image->GetString("uri");
+        if (uri.empty() || uri.starts_with("data:"))
+        {
+            std::cout << "ERROR::GLB::EMBEDDED_IMAGE_NOT_SUPPORTED " << modelPath << std::endl;
+            return {};
+        }
+
+        return GetSiblingPath(modelPath, uri);
+    }
+
+    /*
+     * Metallic-roughness onto the Phong-style material the shaders use. Specular is the Fresnel reflectance at
+     * normal incidence, and the shininess gives a Blinn-Phong lobe about as wide as the GGX one of the roughness
+     */
+    Geometry::Material ReadMaterial(const JsonValue& document, const JsonValue& material, const char* modelPath)
+    {
+        Geometry::Material result {};
+        result.name = std::string(material.GetString("name"));
+
+        glm::vec3 baseColor(1.0f);
+        float metallic = 1.0f;
+        float roughness = 1.0f;
+        const JsonValue* textureInfo = nullptr;
+
+        if (const JsonValue* pbr = material.Find("pbrMetallicRoughness"))
+        {
+            baseColor = ReadVec3(*pbr, "baseColorFactor", baseColor);
+            metallic = static_cast<float>(std::clamp(pbr->GetNumber("metallicFactor", 1.0), 0.0, 1.0));
+            roughness = static_cast<float>(std::clamp(pbr->GetNumber("roughnessFactor", 1.0), 0.0, 1.0));
+            textureInfo = pbr->Find("baseColorTexture");
+        }
+
+        result.ambientColor = glm::vec3(1.0f);
+        result.diffuseColor = baseColor * (1.0f - metallic);
+        result.specularColor = glm::mix(glm::vec3(0.04f), baseColor, metallic);
+        result.emissiveColor = ReadVec3(material, "emissiveFactor", glm::vec3(0.0f));
+
+        float alpha = std::max(roughness * roughness, 0.03f);
+        result.shininess = std::clamp(2.0f / (alpha * alpha) - 2.0f, 1.0f, 1000.0f);
+
+        result.diffuseMapPath = GetTexturePath(document, textureInfo, modelPath);
+        result.hasDiffuseMap = !result.diffuseMapPath.empty();
+
+        return result;
+    }
+
+    void ReadPrimitive(const Document& document, const JsonValue& primitive, const glm::mat4& transform,
+                       const char* modelPath, Geometry::ModelData& modelData)
+    {
+        if (primitive.GetInt("mode", TRIANGLES_MODE) != TRIANGLES_MODE)
+            return;
+
+        const JsonValue* attributes = primitive.Find("attributes");
+        if (attributes == nullptr)
+            return;
+
+        std::optional<AccessorView> positions = GetAccessor(document, attributes->GetInt("POSITION", -1));
+        if (!positions || positions->componentCount != 3)
+        {
+            std::cout << "ERROR::GLB::PRIMITIVE_WITHOUT_POSITIONS " << modelPath << std::endl;
+            return;
+        }
+
+        std::optional<AccessorView> normals = GetAccessor(document, attributes->GetInt("NORMAL", -1));
+        std::optional<AccessorView> textureCoordinates = GetAccessor(document, attributes->GetInt("TEXCOORD_0", -1));
+        if (normals && (normals->componentCount != 3 || normals->count < positions->count))
+            normals.reset();
+        if (textureCoordinates && (textureCoordinates->componentCount != 2 || textureCoordinates->count < positions->count))
+            textureCoordinates.reset();
+
+        std::optional<AccessorView> indices;
+        if (const JsonValue* indicesAccessor = primitive.Find("indices"))
+        {
+            indices = GetAccessor(document, indicesAccessor->GetInt(-1));
+            if (!indices || indices->componentCount != 1 || indices->componentType == FLOAT)
+            {
+                std::cout << "ERROR::GLB::INVALID_INDICES " << modelPath << std::endl;
+                return;
+            }
+        }
+
+        int materialIndex = primitive.GetInt("material", -1);
+        if (materialIndex >= static_cast<int>(modelData.materials.size()))
+            materialIndex = -1;
+
+        auto vertexOffset = static_cast<unsigned int>(modelData.vertices.size());
+        std::size_t indexCount = indices ? indices->count : positions->count;
+        indexCount -= indexCount % 3;
+
+        /*
+         * Check the indices before anything is added, a primitive is either read whole or skipped
+         */
+        if (indices)
+        {
+            for (std::size_t i = 0; i < indexCount; ++i)
+            {
+                if (ReadIndex(*indices, i) >= positions->count)
+                {
+                    std::cout << "ERROR::GLB::INDEX_OUT_OF_RANGE " << modelPath << std::endl;
+                    return;
+                }
+            }
+        }
+
+        glm::mat3 normalTransform = glm::transpose(glm::inverse(glm::mat3(transform)));
+        modelData.vertices.reserve(modelData.vertices.size() + positions->count);
+        for (std::size_t i = 0; i < positions->count; ++i)
+        {
+            Geometry::Vertex vertex {};
+            vertex.position = glm::vec3(transform * glm::vec4(glm::vec3(ReadElement(*positions, i)), 1.0f));
+            if (normals)
+            {
+                glm::vec3 normal = normalTransform * glm::vec3(ReadElement(*normals, i));
+                float length = glm::length(normal);
+                vertex.normal = length > 0.0f ? normal / length : normal;
+            }
+            // glTF puts the texture origin at the top left, OBJ and the texture loader at the bottom left
+            if (textureCoordinates)
+            {
+                glm::vec2 coordinates = glm::vec2(ReadElement(*textureCoordinates, i));
+                vertex.textureCoordinates = glm::vec2(coordinates.x, 1.0f - coordinates.y);
+            }
+            vertex.materialIndex = materialIndex;
+
+            modelData.vertices.push_back(vertex);
+        }
+
+        // Mirroring transforms turn the winding around
+        bool isMirrored = glm::determinant(glm::mat3(transform)) < 0.0f;
+        modelData.indices.reserve(modelData.indices.size() + indexCount);
+        for (std::size_t i = 0; i < indexCount; i += 3)
+        {
+            unsigned int triangle[3];
+            for (std::size_t corner = 0; corner < 3; ++corner)
+                triangle[corner] = vertexOffset + (indices ? ReadIndex(*indices, i + corner) : static_cast<unsigned int>(i + corner));
+
+            if (isMirrored)
+                std::swap(triangle[1], triangle[2]);
+
+            modelData.indices.insert(modelData.indices.end(), std::begin(triangle), std::end(triangle));
+        }
+    }
+
+    void ReadNode(const Document& document, const int nodeIndex, const glm::mat4& parentTransform, const int depth,
+                  const char* modelPath, Geometry::ModelData& modelData)
+    {
+        const JsonValue* node = GetElement(document.json, "nodes", nodeIndex);
+        if (node == nullptr || depth > MAX_NODE_DEPTH)
+            return;
+
+        glm::mat4 transform = parentTransform * GetNodeTransform(*node);
+
+        if (const JsonValue* mesh = GetElement(document.json, "meshes", node->GetInt("mesh", -1)))
+        {
+            if (const JsonValue* primitives = mesh->Find("primitives"))
+            {
+                for (const JsonValue& primitive : primitives->GetElements())
+                    ReadPrimitive(document, primitive, transform, modelPath, modelData);
+            }
+        }
+
+        if (const JsonValue* children = node->Find("children"))
+        {
+            for (const JsonValue& child : children->GetElements())
+                ReadNode(document, child.GetInt(-1), transform, depth + 1, modelPath, modelData);
+        }
+    }
+}
+
+Geometry::ModelData Geometry::GlbImporter::Read(const char* path)
+{
+    ModelData modelData;
+
+    Assets::AssetFile file(path);
+    if (!file.IsOpen())
+    {
+        std::cout << "ERROR::ASSET::GLB_FILE_NOT_SUCCESSFULLY_READ" << std::endl;
+        return modelData;
+    }
+
+    /*
+     * Header, then the JSON chunk and an optional BIN chunk, each with its length and type
+     */
+    std::string_view source = file.View();
+    if (source.size() < HEADER_SIZE + CHUNK_HEADER_SIZE || ReadUint32(source.data()) != MAGIC
+        || ReadUint32(source.data() + 4) != VERSION)
+    {
+        std::cout << "ERROR::GLB::INVALID_HEADER " << path << std::endl;
+        return modelData;
+    }
+
+    std::size_t fileLength = std::min<std::size_t>(ReadUint32(source.data() + 8), source.size());
+    std::string_view jsonChunk;
+    std::span<const unsigned char> binChunk;
+
+    for (std::size_t offset = HEADER_SIZE; offset + CHUNK_HEADER_SIZE <= fileLength;)
+    {
+        std::size_t chunkLength = ReadUint32(source.data() + offset);
+        std::uint32_t chunkType = ReadUint32(source.data() + offset + 4);
+        offset += CHUNK_HEADER_SIZE;
+        if (chunkLength > fileLength - offset)
+            break;
+
+        if (chunkType == JSON_CHUNK && jsonChunk.empty())
+            jsonChunk = source.substr(offset, chunkLength);
+        else if (chunkType == BIN_CHUNK && binChunk.empty())
+            binChunk = { reinterpret_cast<const unsigned char*>(source.data() + offset), chunkLength };
+
+        offset += chunkLength;
+    }
+
+    std::optional<JsonValue> json = JsonValue::Parse(jsonChunk);
+    if (!json || !json->IsObject())
+    {
+        std::cout << "ERROR::GLB::INVALID_JSON " << path << std::endl;
+        return modelData;
+    }
+
+    Document document { std::move(*json), binChunk };
+
+    if (const JsonValue* materials = document.json.Find("materials"))
+    {
+        for (const JsonValue& material : materials->GetElements())
+            modelData.materials.push_back(ReadMaterial(document.json, material, path));
+    }
+
+    /*
+     * Walk the default scene, files without scenes get every mesh once, untransformed
+     */
+    const JsonValue* scene = GetElement(document.json, "scenes", document.json.GetInt("scene", 0));
+    if (scene != nullptr)
+    {
+        if (const JsonValue* nodes = scene->Find("nodes"))
+        {
+            for (const JsonValue& node : nodes->GetElements())
+                ReadNode(document, node.GetInt(-1), glm::mat4(1.0f), 0, path, modelData);
+        }
+    }
+    else if (const JsonValue* meshes = document.json.Find("meshes"))
+    {
+        for (const JsonValue& mesh : meshes->GetElements())
+        {
+            if (const JsonValue* primitives = mesh.Find("primitives"))
+            {
+                for (const JsonValue& primitive : primitives->GetElements())
+                    ReadPrimitive(document, primitive, glm::mat4(1.0f), path, modelData);
+            }
+        }
+    }
+
+    modelData.cornerCount = static_cast<unsigned int>(modelData.indices.size());
+
+    return modelData;
+}
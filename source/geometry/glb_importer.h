@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+#include "model.h"
+
+namespace Geometry
+{
+    /*
+     * Binary glTF 2.0 reader. The file is mapped and its BIN chunk never copied: accessors are read in place,
+     * through their buffer views, straight into the engine's vertices and indices. Images have to be separate
+     * files next to the model, the texture loader streams them like OBJ material maps
+     */
+    namespace GlbImporter
+    {
+        constexpr std::uint32_t MAGIC = 0x46546C67;
+        constexpr std::uint32_t VERSION = 2;
+        constexpr std::uint32_t JSON_CHUNK = 0x4E4F534A;
+        constexpr std::uint32_t BIN_CHUNK = 0x004E4942;
+
+        /*
+         * Triangle primitives of every mesh the default scene reaches, moved into model space by their node
+         * transforms. Vertices, indices and materials are filled in, the optimization passes are left to
+         * Model::ImportGlb
+         */
+        ModelData Read(const char* path);
+    }
+}
@@ -0,0 +1,64 @@
+#include "lod_selector.h"
+
+#include <algorithm>
+
+#include <glad/glad.h>
+
+using Geometry::LodSelector;
+
+namespace
+{
+    float GetProjectedError(const Geometry::MeshLod& lod, const float pixelsPerUnit, const float scale)
+    {
+        return lod.error * scale * pixelsPerUnit;
+    }
+}
+
+void LodSelector::SetView(const glm::mat4& view, const glm::mat4& projection)
+{
+    mView = view;
+
+    int viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    mPixelsPerUnitAtOne = projection[1][1] * static_cast<float>(std::max(1, viewport[3])) * 0.5f;
+}
+
+void LodSelector::SetErrorThreshold(const float pixels)
+{
+    mErrorThreshold = pixels;
+}
+
+unsigned int LodSelector::SelectLevel(const std::span<const MeshLod> lods, const glm::vec3& center, const float radius,
+                                      const float scale, const unsigned int currentLevel) const
+{
+    if (lods.size() < 2)
+        return 0;
+
+    // The nearest point of the bounds decides how many pixels a model space error covers
+    float viewDepth = -(mView * glm::vec4(center, 1.0f)).z;
+    float pixelsPerUnit = mPixelsPerUnitAtOne / std::max(NEAR_DISTANCE, viewDepth - radius);
+
+    auto level = std::min(currentLevel, static_cast<unsigned int>(lods.size() - 1));
+    while (level > 0 && GetProjectedError(lods[level], pixelsPerUnit, scale) > mErrorThreshold * (1.0f + HYSTERESIS))
+        --level;
+    while (level + 1 < lods.size() && GetProjectedError(lods[level + 1], pixelsPerUnit, scale) < mErrorThreshold * (1.0f - HYSTERESIS))
+        ++level;
+
+    return level;
+}
+
+void LodSelector::RecordSubmission(const std::size_t triangles, const std::size_t fullDetailTriangles)
+{
+    mStats.submittedTriangles += triangles;
+    mStats.fullDetailTriangles += fullDetailTriangles;
+}
+
+Geometry::LodStats LodSelector::GetStats() const
+{
+    return mStats;
+}
+
+void LodSelector::ResetStats()
+{
+    mStats = {};
+}
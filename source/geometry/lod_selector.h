@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include <../../libraries/glm/glm.hpp>
+
+#include "geometry_structs.h"
+
+namespace Geometry
+{
+    struct LodStats
+    {
+        std::size_t submittedTriangles;
+        // What the same draws would have cost at level 0
+        std::size_t fullDetailTriangles;
+    };
+
+    /*
+     * Picks the coarsest level of detail whose error projects to at most the threshold in pixels. A level only
+     * changes once its error is clearly past the threshold, so models resting near a switching distance do
+     * not flicker between two levels
+     */
+    class LodSelector
+    {
+    public:
+        // Camera used for the following draws
+        void SetView(const glm::mat4& view, const glm::mat4& projection);
+        void SetErrorThreshold(float pixels);
+
+        // Bounds in world space, scale is the largest scale of the model matrix. Safe to call from worker threads
+        unsigned int SelectLevel(std::span<const MeshLod> lods, const glm::vec3& center, float radius, float scale,
+                                 unsigned int currentLevel) const;
+
+        void RecordSubmission(std::size_t triangles, std::size_t fullDetailTriangles);
+        // Counted over every submission since the last reset
+        LodStats GetStats() const;
+        void ResetStats();
+
+    private:
+        glm::mat4 mView = glm::mat4(1.0f);
+        float mPixelsPerUnitAtOne = 1.0f;
+        float mErrorThreshold = DEFAULT_ERROR_PIXELS;
+        LodStats mStats {};
+
+        static constexpr float DEFAULT_ERROR_PIXELS = 1.0f;
+        // Share of the threshold a level's error has to cross it by before the level changes
+        static constexpr float HYSTERESIS = 0.25f;
+        static constexpr float NEAR_DISTANCE = 0.1f;
+    };
+}
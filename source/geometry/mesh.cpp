@@ -1,10 +1,21 @@
 #include "mesh.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
 #include <../../libraries/glad/include/glad/glad.h>
 
-void Geometry::Mesh::SetupMesh(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices)
+void Geometry::Mesh::SetupMesh(const std::span<const Vertex> vertices, const std::span<const unsigned int> indices,
+                               const std::span<const MeshLod> lods, const VertexFormat format)
 {
-    this->indices = indices;
+    mRequestedVertexFormat = format;
+    indexCount = static_cast<unsigned int>(indices.size());
+    vertexCount = static_cast<unsigned int>(vertices.size());
+    SetLods(indices, lods);
+    ComputeBounds(vertices, indices.subspan(this->lods[0].firstIndex, this->lods[0].indexCount));
 
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
@@ -13,20 +24,286 @@ void Geometry::Mesh::SetupMesh(const std::vector<Vertex> &vertices, const std::v
     glBindVertexArray(VAO);
 
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
-
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+    SetBuffers(vertices, indices);
+}
+
+void Geometry::Mesh::UpdateMesh(const std::span<const Vertex> vertices, const std::span<const unsigned int> indices,
+                                const std::span<const MeshLod> lods)
+{
+    indexCount = static_cast<unsigned int>(indices.size());
+    vertexCount = static_cast<unsigned int>(vertices.size());
+    SetLods(indices, lods);
+    ComputeBounds(vertices, indices.subspan(this->lods[0].firstIndex, this->lods[0].indexCount));
+
+    std::vector<unsigned int> meshletIndices;
+    if (!meshlets.empty())
+        meshletIndices = OrderMeshlets(vertices, indices);
+
+    // The element buffer binding belongs to the vertex array, so it is bound while the indices are replaced
+    glBindVertexArray(VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    SetBuffers(vertices, meshlets.empty() ? indices : std::span<const unsigned int>(meshletIndices));
+
+    glBindVertexArray(0);
+}
+
+void Geometry::Mesh::BuildMeshlets(const std::span<const Vertex> vertices, const std::span<const unsigned int> indices)
+{
+    std::vector<unsigned int> meshletIndices = OrderMeshlets(vertices, indices);
+
+    glBindVertexArray(VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    SetBuffers(vertices, meshletIndices);
+
+    glBindVertexArray(0);
+}
+
+std::vector<unsigned int> Geometry::Mesh::OrderMeshlets(const std::span<const Vertex> vertices, const std::span<const unsigned int> indices)
+{
+    // Meshlet index ranges are relative to level 0, which starts the element buffer
+    std::vector<unsigned int> meshletIndices(indices.begin(), indices.end());
+    std::span<unsigned int> fullDetailIndices = std::span(meshletIndices).first(lods[0].indexCount);
+    meshlets = Meshlets::Build(vertices, fullDetailIndices);
+    meshletBounds = Meshlets::ComputeBounds(meshlets, vertices, fullDetailIndices);
+
+    return meshletIndices;
+}
+
+void Geometry::Mesh::DrawRange(const unsigned int firstIndex, const unsigned int count, const int instanceCount) const
+{
+    unsigned int end = firstIndex + count;
+    for (const Submesh& submesh : submeshes)
+    {
+        unsigned int first = std::max(firstIndex, submesh.firstIndex);
+        unsigned int last = std::min(end, submesh.firstIndex + submesh.indexCount);
+        if (first >= last)
+            continue;
+
+        auto offset = reinterpret_cast<const void*>(static_cast<std::uintptr_t>(first) * indexSize);
+        if (instanceCount == 1)
+            glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<int>(last - first), indexType, offset, submesh.baseVertex);
+        else
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<int>(last - first), indexType, offset, instanceCount,
+                                              submesh.baseVertex);
+    }
+}
+
+void Geometry::Mesh::DrawRanges(const std::span<const unsigned int> firstIndices, const std::span<const int> counts) const
+{
+    mDrawCounts.clear();
+    mDrawOffsets.clear();
+    mDrawBaseVertices.clear();
+
+    // Ranges are sorted, so the submesh of the next range is never before the current one
+    std::size_t submesh = 0;
+    for (std::size_t i = 0; i < firstIndices.size(); ++i)
+    {
+        unsigned int first = firstIndices[i];
+        unsigned int end = first + static_cast<unsigned int>(counts[i]);
+
+        while (first < end && submesh < submeshes.size())
+        {
+            unsigned int submeshEnd = submeshes[submesh].firstIndex + submeshes[submesh].indexCount;
+            if (first >= submeshEnd)
+            {
+                ++submesh;
+                continue;
+            }
+
+            unsigned int last = std::min(end, submeshEnd);
+            mDrawCounts.push_back(static_cast<int>(last - first));
+            mDrawOffsets.push_back(reinterpret_cast<const void*>(static_cast<std::uintptr_t>(first) * indexSize));
+            mDrawBaseVertices.push_back(submeshes[submesh].baseVertex);
+            first = last;
+        }
+    }
+
+    if (!mDrawCounts.empty())
+        glMultiDrawElementsBaseVertex(GL_TRIANGLES, mDrawCounts.data(), indexType, mDrawOffsets.data(),
+                                      static_cast<int>(mDrawCounts.size()), mDrawBaseVertices.data());
+}
+
+void Geometry::Mesh::SetVertices(const std::span<const Vertex> vertices)
+{
+    vertexFormat = mRequestedVertexFormat;
+
+    std::vector<QuantizedVertex> quantizedVertices;
+    if (vertexFormat == VertexFormat::Quantized)
+    {
+        materialRanges = VertexQuantization::GetMaterialRanges(vertices);
+        positionQuantization = VertexQuantization::GetPositionQuantization(vertices);
+        quantizedVertices = VertexQuantization::Quantize(vertices, positionQuantization);
+        QuantizationError error = VertexQuantization::MeasureError(vertices, quantizedVertices, positionQuantization);
+
+        if (materialRanges.size() > VertexQuantization::MAX_MATERIAL_RANGES)
+        {
+            std::cout << "ERROR::MESH::TOO_MANY_MATERIAL_RANGES " << materialRanges.size() << " ranges, using full vertices" << std::endl;
+            vertexFormat = VertexFormat::Full;
+        }
+        else if (!VertexQuantization::IsWithinLimits(error, positionQuantization))
+        {
+            std::cout << "ERROR::MESH::QUANTIZATION_ERROR_TOO_LARGE position " << error.position << ", normal "
+                      << error.normalDegrees << " degrees, texture coordinates " << error.textureCoordinates
+                      << ", using full vertices" << std::endl;
+            vertexFormat = VertexFormat::Full;
+        }
+    }
+
+    if (vertexFormat == VertexFormat::Full)
+    {
+        materialRanges.clear();
+        glBufferData(GL_ARRAY_BUFFER, vertices.size_bytes(), vertices.data(), GL_STATIC_DRAW);
+
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), nullptr);
+
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, normal)));
+
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, textureCoordinates)));
+
+        glEnableVertexAttribArray(3);
+        glVertexAttribIPointer(3, 1, GL_INT, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, materialIndex)));
+        return;
+    }
+
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(quantizedVertices.size() * sizeof(QuantizedVertex)),
+                 quantizedVertices.data(), GL_STATIC_DRAW);
 
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), nullptr);
+    glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(QuantizedVertex), nullptr);
 
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, normal)));
+    glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(QuantizedVertex), reinterpret_cast<void*>(offsetof(QuantizedVertex, normal)));
 
     glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, textureCoordinates)));
+    glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(QuantizedVertex),
+                          reinterpret_cast<void*>(offsetof(QuantizedVertex, textureCoordinates)));
+
+    // The vertex shader takes the material from materialRanges instead
+    glDisableVertexAttribArray(3);
+}
+
+void Geometry::Mesh::SetBuffers(const std::span<const Vertex> vertices, const std::span<const unsigned int> indices)
+{
+    constexpr unsigned int SHORT_INDEX_RANGE = std::numeric_limits<std::uint16_t>::max() + 1;
+    constexpr unsigned int UNUSED = std::numeric_limits<unsigned int>::max();
+
+    submeshes = { { 0, static_cast<unsigned int>(indices.size()), 0 } };
+    indexType = GL_UNSIGNED_SHORT;
+    indexSize = sizeof(std::uint16_t);
+
+    if (vertices.size() <= SHORT_INDEX_RANGE)
+    {
+        std::vector<std::uint16_t> shortIndices(indices.begin(), indices.end());
+        SetVertices(vertices);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(shortIndices.size() * sizeof(std::uint16_t)),
+                     shortIndices.data(), GL_STATIC_DRAW);
+        return;
+    }
+
+    /*
+     * Cut a new submesh whenever the next triangle would take the current one past 65536 vertices. Every submesh
+     * gets its own copy of the vertices it uses, in order of first use, so vertices on a cut are duplicated
+     */
+    submeshes.clear();
+    std::vector<Vertex> splitVertices;
+    std::vector<std::uint16_t> shortIndices(indices.size(), 0);
+    std::vector<unsigned int> localIndices(vertices.size(), UNUSED);
+    std::vector<unsigned int> submeshVertices;
+
+    for (std::size_t triangle = 0; triangle + 2 < indices.size(); triangle += 3)
+    {
+        unsigned int a = indices[triangle], b = indices[triangle + 1], c = indices[triangle + 2];
+        unsigned int newVertexCount = (localIndices[a] == UNUSED) + (b != a && localIndices[b] == UNUSED)
+            + (c != a && c != b && localIndices[c] == UNUSED);
+
+        if (submeshes.empty() || submeshVertices.size() + newVertexCount > SHORT_INDEX_RANGE)
+        {
+            for (unsigned int vertex : submeshVertices)
+                localIndices[vertex] = UNUSED;
+            submeshVertices.clear();
+
+            submeshes.push_back({ static_cast<unsigned int>(triangle), 0, static_cast<int>(splitVertices.size()) });
+        }
+
+        for (std::size_t corner = triangle; corner < triangle + 3; ++corner)
+        {
+            unsigned int vertex = indices[corner];
+            if (localIndices[vertex] == UNUSED)
+            {
+                localIndices[vertex] = static_cast<unsigned int>(submeshVertices.size());
+                submeshVertices.push_back(vertex);
+                splitVertices.push_back(vertices[vertex]);
+            }
+
+            shortIndices[corner] = static_cast<std::uint16_t>(localIndices[vertex]);
+        }
+
+        submeshes.back().indexCount += 3;
+    }
+
+    // Splitting pays for itself only while the copies cost less than the 16-bit indices save
+    if (static_cast<float>(splitVertices.size()) > static_cast<float>(vertices.size()) * MAX_SPLIT_VERTEX_GROWTH)
+    {
+        submeshes = { { 0, static_cast<unsigned int>(indices.size()), 0 } };
+        indexType = GL_UNSIGNED_INT;
+        indexSize = sizeof(unsigned int);
+
+        SetVertices(vertices);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size_bytes(), indices.data(), GL_STATIC_DRAW);
+        return;
+    }
+
+    SetVertices(splitVertices);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(shortIndices.size() * sizeof(std::uint16_t)),
+                 shortIndices.data(), GL_STATIC_DRAW);
+}
+
+void Geometry::Mesh::SetLods(const std::span<const unsigned int> indices, const std::span<const MeshLod> lods)
+{
+    if (lods.empty())
+        this->lods = { { 0, static_cast<unsigned int>(indices.size()), 0.0f } };
+    else
+        this->lods.assign(lods.begin(), lods.end());
+}
+
+void Geometry::Mesh::ComputeBounds(const std::span<const Vertex> vertices, const std::span<const unsigned int> indices)
+{
+    boundsCenter = glm::vec3(0.0f);
+    boundsRadius = 0.0f;
+    texelDensity = 1.0f;
+
+    if (vertices.empty())
+        return;
+
+    glm::vec3 minimum = vertices.front().position, maximum = minimum;
+    for (const Vertex& vertex : vertices)
+    {
+        minimum = glm::min(minimum, vertex.position);
+        maximum = glm::max(maximum, vertex.position);
+    }
+
+    boundsCenter = (minimum + maximum) * 0.5f;
+    for (const Vertex& vertex : vertices)
+        boundsRadius = std::max(boundsRadius, glm::length(vertex.position - boundsCenter));
+
+    double surfaceArea = 0.0, textureArea = 0.0;
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        const Vertex& a = vertices[indices[i]];
+        const Vertex& b = vertices[indices[i + 1]];
+        const Vertex& c = vertices[indices[i + 2]];
+
+        surfaceArea += glm::length(glm::cross(b.position - a.position, c.position - a.position));
+        glm::vec2 edge0 = b.textureCoordinates - a.textureCoordinates, edge1 = c.textureCoordinates - a.textureCoordinates;
+        textureArea += std::abs(edge0.x * edge1.y - edge0.y * edge1.x);
+    }
 
-    glEnableVertexAttribArray(3);
-    glVertexAttribIPointer(3, 1, GL_INT, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, materialIndex)));
-}
\ No newline at end of file
+    if (surfaceArea > 0.0 && textureArea > 0.0)
+        texelDensity = static_cast<float>(std::sqrt(textureArea / surfaceArea));
+}
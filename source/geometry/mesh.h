@@ -1,19 +1,92 @@
 #pragma once
 
 #include "geometry_structs.h"
+#include "meshlet.h"
+#include "vertex_quantization.h"
+#include <span>
 #include <vector>
 
 #include "../shading/shader_program.h"
 
 namespace Geometry
 {
+    // Part of the element buffer whose indices are relative to baseVertex
+    struct Submesh
+    {
+        unsigned int firstIndex;
+        unsigned int indexCount;
+        int baseVertex;
+    };
+
     class Mesh {
     public:
-        void SetupMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+        // indices holds every level of detail, an empty lods means a single level over all of them. Quantized
+        // meshes fall back to full vertices when their vertices switch material too often
+        void SetupMesh(std::span<const Vertex> vertices, std::span<const unsigned int> indices, std::span<const MeshLod> lods,
+                       VertexFormat format = VertexFormat::Full);
+        // Replaces the buffer contents in place, the vertex array and any attributes added to it stay valid
+        void UpdateMesh(std::span<const Vertex> vertices, std::span<const unsigned int> indices, std::span<const MeshLod> lods);
+        // Splits level 0 into meshlets for cluster culling, reloads rebuild them from then on. Level 0 is uploaded
+        // again in meshlet order
+        void BuildMeshlets(std::span<const Vertex> vertices, std::span<const unsigned int> indices);
+
+        // Draw calls for ranges of the element buffer, counted in indices. Ranges crossing a submesh boundary are
+        // split so every part gets its base vertex. The vertex array has to be bound
+        void DrawRange(unsigned int firstIndex, unsigned int count, int instanceCount = 1) const;
+        void DrawRanges(std::span<const unsigned int> firstIndices, std::span<const int> counts) const;
 
-        std::vector<unsigned int> indices;
+        unsigned int indexCount = 0;
+        // Finest first, all ranges of the one element buffer
+        std::vector<MeshLod> lods;
+        unsigned int vertexCount = 0;
         unsigned int VAO, VBO, EBO;
+
+        /*
+         * Indices are 16-bit whenever the vertices fit. Larger meshes are split into submeshes of at most 65536
+         * vertices each, placed one after another in the vertex buffer. A mesh whose submeshes would duplicate
+         * too many vertices keeps 32-bit indices in a single submesh
+         */
+        unsigned int indexType = 0;
+        unsigned int indexSize = 0;
+        std::vector<Submesh> submeshes;
+
+        // What the vertex shader needs to decode quantized vertices, unused for full ones. vertexFormat is the
+        // format of the current upload, Full after a fallback
+        VertexFormat vertexFormat = VertexFormat::Full;
+        PositionQuantization positionQuantization {};
+        std::vector<MaterialRange> materialRanges;
+
+        // Bounding sphere of level 0 in model space and texture coordinate units per model space unit, averaged by area
+        // over all triangles. The texture streamer turns them into a screen-space footprint per draw
+        glm::vec3 boundsCenter = glm::vec3(0.0f);
+        float boundsRadius = 0.0f;
+        float texelDensity = 1.0f;
+
+        // Empty unless BuildMeshlets was called
+        std::vector<Meshlet> meshlets;
+        MeshletBounds meshletBounds;
+
+    private:
+        // Uploads both buffers with the smallest index width, splitting the mesh into submeshes when needed
+        void SetBuffers(std::span<const Vertex> vertices, std::span<const unsigned int> indices);
+        // Uploads the vertices in the requested format, or full ones when it does not fit, and points attributes
+        // 0 to 3 at them
+        void SetVertices(std::span<const Vertex> vertices);
+        void SetLods(std::span<const unsigned int> indices, std::span<const MeshLod> lods);
+        void ComputeBounds(std::span<const Vertex> vertices, std::span<const unsigned int> indices);
+        // Builds the meshlets and returns indices with level 0 reordered to match them
+        std::vector<unsigned int> OrderMeshlets(std::span<const Vertex> vertices, std::span<const unsigned int> indices);
+
+        // Vertex count of the split mesh against the original
+        static constexpr float MAX_SPLIT_VERTEX_GROWTH = 1.5f;
+
+        // Every upload tries this format first, so a reload that fits the limits again is quantized again
+        VertexFormat mRequestedVertexFormat = VertexFormat::Full;
+
+        // Scratch for DrawRanges
+        mutable std::vector<int> mDrawCounts;
+        mutable std::vector<const void*> mDrawOffsets;
+        mutable std::vector<int> mDrawBaseVertices;
     };
 }
 
-
@@ -0,0 +1,275 @@
+#include "mesh_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+#include "model.h"
+#include "../utility/atomic_file.h"
+#include "../utility/hash.h"
+
+namespace
+{
+    constexpr char CACHE_MAGIC[4] = { 'M', 'M', 'S', 'H' };
+    constexpr std::uint32_t CACHE_VERSION = 4;
+    constexpr std::uint64_t PAYLOAD_ALIGNMENT = 16;
+
+    struct CacheHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t vertexSize;
+        std::uint32_t cornerCount;
+        std::int64_t sourceModifiedTime;
+        std::uint64_t sourceHash;
+        std::uint64_t vertexCount;
+        std::uint64_t indexCount;
+        std::uint64_t vertexOffset;
+        std::uint64_t indexOffset;
+        std::uint64_t metadataOffset;
+        std::uint64_t metadataSize;
+    };
+
+    class MetadataWriter
+    {
+    public:
+        template<typename T>
+        void Write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void WriteString(const std::string& value)
+        {
+            Write(static_cast<std::uint32_t>(value.size()));
+            bytes.append(value);
+        }
+
+        std::string bytes;
+    };
+
+    class MetadataReader
+    {
+    public:
+        explicit MetadataReader(const std::string_view bytes) : mBytes(bytes) {}
+
+        template<typename T>
+        bool Read(T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            if (mBytes.size() < sizeof(T))
+                return false;
+
+            std::memcpy(&value, mBytes.data(), sizeof(T));
+            mBytes.remove_prefix(sizeof(T));
+            return true;
+        }
+
+        bool ReadString(std::string& value)
+        {
+            std::uint32_t length;
+            if (!Read(length) || mBytes.size() < length)
+                return false;
+
+            value.assign(mBytes.substr(0, length));
+            mBytes.remove_prefix(length);
+            return true;
+        }
+
+    private:
+        std::string_view mBytes;
+    };
+
+    std::uint64_t AlignOffset(const std::uint64_t offset)
+    {
+        return (offset + PAYLOAD_ALIGNMENT - 1) & ~(PAYLOAD_ALIGNMENT - 1);
+    }
+
+    // Latest modification time over the model and every material file it references
+    std::int64_t GetSourceModifiedTime(const char* modelPath, const std::vector<std::string>& materialFiles)
+    {
+        std::int64_t modifiedTime = Assets::AssetFile::GetModifiedTime(modelPath);
+
+        for (const std::string& materialFile : materialFiles)
+            modifiedTime = std::max(modifiedTime, Assets::AssetFile::GetModifiedTime(materialFile));
+
+        return modifiedTime;
+    }
+
+    std::uint64_t HashSourceFiles(const char* modelPath, const std::vector<std::string>& materialFiles)
+    {
+        std::uint64_t hash = Utility::Hash64(Assets::AssetFile(modelPath).View());
+
+        for (const std::string& materialFile : materialFiles)
+            hash = Utility::Hash64(Assets::AssetFile(materialFile).View(), hash);
+
+        return hash;
+    }
+
+    void WriteMaterial(MetadataWriter& writer, const Geometry::Material& material)
+    {
+        writer.WriteString(material.name);
+        writer.Write(material.ambientColor);
+        writer.Write(material.diffuseColor);
+        writer.Write(material.specularColor);
+        writer.Write(material.emissiveColor);
+        writer.Write(material.shininess);
+        writer.Write(material.hasDiffuseMap);
+        writer.Write(material.hasSpecularMap);
+        writer.WriteString(material.diffuseMapPath);
+        writer.WriteString(material.specularMapPath);
+    }
+
+    bool ReadMaterial(MetadataReader& reader, Geometry::Material& material)
+    {
+        return reader.ReadString(material.name)
+            && reader.Read(material.ambientColor)
+            && reader.Read(material.diffuseColor)
+            && reader.Read(material.specularColor)
+            && reader.Read(material.emissiveColor)
+            && reader.Read(material.shininess)
+            && reader.Read(material.hasDiffuseMap)
+            && reader.Read(material.hasSpecularMap)
+            && reader.ReadString(material.diffuseMapPath)
+            && reader.ReadString(material.specularMapPath);
+    }
+}
+
+std::string Geometry::MeshCache::GetCachePath(const char* modelPath)
+{
+    return std::string(modelPath) + ".mmesh";
+}
+
+std::optional<Geometry::MeshCache::CachedModel> Geometry::MeshCache::Open(const char* modelPath)
+{
+    std::string cachePath = GetCachePath(modelPath);
+    Assets::AssetFile file(cachePath);
+    if (file.Size() < sizeof(CacheHeader))
+        return std::nullopt;
+
+    CacheHeader header;
+    std::memcpy(&header, file.Data(), sizeof(CacheHeader));
+
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION
+        || header.vertexSize != sizeof(Vertex))
+        return std::nullopt;
+
+    if (header.vertexOffset + header.vertexCount * sizeof(Vertex) > file.Size()
+        || header.indexOffset + header.indexCount * sizeof(unsigned int) > file.Size()
+        || header.metadataOffset + header.metadataSize > file.Size())
+        return std::nullopt;
+
+    /*
+     * The cache is keyed by source path, then by modification time with the content hash as fallback,
+     * so touching a file without changing it does not force a re-import
+     */
+    MetadataReader reader(file.View().substr(header.metadataOffset, header.metadataSize));
+    std::string sourcePath;
+    std::uint32_t materialFileCount;
+
+    if (!reader.ReadString(sourcePath) || sourcePath != modelPath || !reader.Read(materialFileCount))
+        return std::nullopt;
+
+    std::vector<std::string> materialFiles(materialFileCount);
+    for (std::string& materialFile : materialFiles)
+    {
+        if (!reader.ReadString(materialFile))
+            return std::nullopt;
+    }
+
+    if (header.sourceModifiedTime != GetSourceModifiedTime(modelPath, materialFiles)
+        && header.sourceHash != HashSourceFiles(modelPath, materialFiles))
+        return std::nullopt;
+
+    std::uint32_t materialCount;
+    if (!reader.Read(materialCount))
+        return std::nullopt;
+
+    CachedModel cachedModel {};
+    cachedModel.file = std::move(file);
+    cachedModel.materials.resize(materialCount);
+    for (Material& material : cachedModel.materials)
+    {
+        if (!ReadMaterial(reader, material))
+            return std::nullopt;
+    }
+
+    std::uint32_t lodCount;
+    if (!reader.Read(lodCount))
+        return std::nullopt;
+
+    cachedModel.lods.resize(lodCount);
+    for (MeshLod& lod : cachedModel.lods)
+    {
+        if (!reader.Read(lod.firstIndex) || !reader.Read(lod.indexCount) || !reader.Read(lod.error)
+            || lod.firstIndex + static_cast<std::uint64_t>(lod.indexCount) > header.indexCount)
+            return std::nullopt;
+    }
+
+    const char* data = cachedModel.file.Data();
+    cachedModel.vertices = { reinterpret_cast<const Vertex*>(data + header.vertexOffset), header.vertexCount };
+    cachedModel.indices = { reinterpret_cast<const unsigned int*>(data + header.indexOffset), header.indexCount };
+    cachedModel.cornerCount = header.cornerCount;
+
+    return cachedModel;
+}
+
+bool Geometry::MeshCache::Write(const char* modelPath, const ModelData& modelData)
+{
+    MetadataWriter metadata;
+    metadata.WriteString(modelPath);
+    metadata.Write(static_cast<std::uint32_t>(modelData.materialFiles.size()));
+    for (const std::string& materialFile : modelData.materialFiles)
+        metadata.WriteString(materialFile);
+
+    metadata.Write(static_cast<std::uint32_t>(modelData.materials.size()));
+    for (const Material& material : modelData.materials)
+        WriteMaterial(metadata, material);
+
+    metadata.Write(static_cast<std::uint32_t>(modelData.lods.size()));
+    for (const MeshLod& lod : modelData.lods)
+    {
+        metadata.Write(lod.firstIndex);
+        metadata.Write(lod.indexCount);
+        metadata.Write(lod.error);
+    }
+
+    CacheHeader header {};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.vertexSize = sizeof(Vertex);
+    header.cornerCount = modelData.cornerCount;
+    header.sourceModifiedTime = GetSourceModifiedTime(modelPath, modelData.materialFiles);
+    header.sourceHash = HashSourceFiles(modelPath, modelData.materialFiles);
+    header.vertexCount = modelData.vertices.size();
+    header.indexCount = modelData.indices.size();
+    header.vertexOffset = AlignOffset(sizeof(CacheHeader));
+    header.indexOffset = AlignOffset(header.vertexOffset + header.vertexCount * sizeof(Vertex));
+    header.metadataOffset = AlignOffset(header.indexOffset + header.indexCount * sizeof(unsigned int));
+    header.metadataSize = metadata.bytes.size();
+
+    std::string cachePath = GetCachePath(modelPath);
+    bool isWritten = Utility::WriteFileAtomically(cachePath, [&](std::ofstream& cacheFile)
+    {
+        auto writePadded = [&cacheFile](const void* data, const std::uint64_t size, const std::uint64_t offset)
+        {
+            cacheFile.seekp(static_cast<std::streamoff>(offset));
+            cacheFile.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        };
+
+        writePadded(&header, sizeof(CacheHeader), 0);
+        writePadded(modelData.vertices.data(), header.vertexCount * sizeof(Vertex), header.vertexOffset);
+        writePadded(modelData.indices.data(), header.indexCount * sizeof(unsigned int), header.indexOffset);
+        writePadded(metadata.bytes.data(), header.metadataSize, header.metadataOffset);
+        return true;
+    });
+
+    if (!isWritten)
+        std::cout << "ERROR::MESH_CACHE::WRITE_FAILED " << cachePath << std::endl;
+
+    return isWritten;
+}
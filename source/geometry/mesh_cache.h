@@ -0,0 +1,37 @@
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "geometry_structs.h"
+#include "../assets/asset_pack.h"
+
+namespace Geometry
+{
+    struct ModelData;
+
+    // Baked model stored next to its source as <source>.mmesh. Vertex and index arrays are laid out
+    // exactly as they are uploaded, so a valid cache is mapped, from disk or the asset pack, and handed
+    // to glBufferData as-is
+    namespace MeshCache
+    {
+        struct CachedModel
+        {
+            Assets::AssetFile file;
+            std::span<const Vertex> vertices;
+            std::span<const unsigned int> indices;
+            std::vector<Material> materials;
+            // Index ranges of the levels of detail inside indices
+            std::vector<MeshLod> lods;
+            unsigned int cornerCount;
+        };
+
+        std::string GetCachePath(const char* modelPath);
+
+        // Maps the cache of modelPath if it exists and still matches the model and material files
+        std::optional<CachedModel> Open(const char* modelPath);
+        bool Write(const char* modelPath, const ModelData& modelData);
+    }
+}
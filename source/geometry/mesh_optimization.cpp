@@ -0,0 +1,336 @@
+#include "mesh_optimization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+    constexpr int FORSYTH_CACHE_SIZE = 32;
+    constexpr float CACHE_DECAY_POWER = 1.5f;
+    constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+    constexpr float VALENCE_BOOST_SCALE = 2.0f;
+    constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+    // FIFO cache kept as timestamps, a vertex stays cached until cacheSize other vertices have missed after it
+    class FifoCache
+    {
+    public:
+        FifoCache(const std::size_t vertexCount, const unsigned int cacheSize)
+            : mTimestamps(vertexCount, 0), mTime(cacheSize + 1), mCacheSize(cacheSize) {}
+
+        // True when the vertex had to be transformed
+        bool Access(const unsigned int vertex)
+        {
+            if (mTime - mTimestamps[vertex] <= mCacheSize)
+                return false;
+
+            mTimestamps[vertex] = mTime++;
+            return true;
+        }
+
+        unsigned int AccessTriangle(const unsigned int* triangle)
+        {
+            return Access(triangle[0]) + Access(triangle[1]) + Access(triangle[2]);
+        }
+
+        void Flush()
+        {
+            mTime += mCacheSize + 1;
+        }
+
+    private:
+        std::vector<unsigned int> mTimestamps;
+        unsigned int mTime;
+        unsigned int mCacheSize;
+    };
+
+    // Vertices near the front of the cache and vertices with few triangles left score highest
+    float GetVertexScore(const int cachePosition, const unsigned int liveTriangleCount)
+    {
+        if (liveTriangleCount == 0)
+            return -1.0f;
+
+        float score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            // The last triangle's vertices score a fixed amount, so the next triangle does not simply repeat them
+            if (cachePosition < 3)
+                score = LAST_TRIANGLE_SCORE;
+            else
+                score = std::pow(1.0f - static_cast<float>(cachePosition - 3) / (FORSYTH_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+        }
+
+        return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(liveTriangleCount), -VALENCE_BOOST_POWER);
+    }
+}
+
+void Geometry::MeshOptimization::Optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+{
+    OptimizeVertexCache(indices, vertices.size());
+    OptimizeOverdraw(indices, vertices);
+    OptimizeVertexFetch(vertices, indices);
+}
+
+void Geometry::MeshOptimization::OptimizeVertexCache(const std::span<unsigned int> indices, const std::size_t vertexCount)
+{
+    std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    /*
+     * Triangles around every vertex, the live part of each list shrinks as triangles are emitted
+     */
+    std::vector<unsigned int> liveCounts(vertexCount, 0);
+    for (std::size_t i = 0; i < triangleCount * 3; ++i)
+        ++liveCounts[indices[i]];
+
+    std::vector<unsigned int> adjacencyOffsets(vertexCount + 1, 0);
+    std::inclusive_scan(liveCounts.begin(), liveCounts.end(), adjacencyOffsets.begin() + 1);
+
+    std::vector<unsigned int> adjacency(triangleCount * 3);
+    std::vector<unsigned int> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (std::size_t i = 0; i < triangleCount * 3; ++i)
+        adjacency[fillOffsets[indices[i]]++] = static_cast<unsigned int>(i / 3);
+
+    std::vector<int> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (std::size_t vertex = 0; vertex < vertexCount; ++vertex)
+        vertexScores[vertex] = GetVertexScore(-1, liveCounts[vertex]);
+
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> isEmitted(triangleCount, false);
+    int bestTriangle = 0;
+    for (std::size_t triangle = 0; triangle < triangleCount; ++triangle)
+    {
+        const unsigned int* corners = &indices[triangle * 3];
+        triangleScores[triangle] = vertexScores[corners[0]] + vertexScores[corners[1]] + vertexScores[corners[2]];
+        if (triangleScores[triangle] > triangleScores[bestTriangle])
+            bestTriangle = static_cast<int>(triangle);
+    }
+
+    /*
+     * Emit the best triangle touching the cache, update the cache and rescore only what it affected
+     */
+    std::vector<unsigned int> output;
+    output.reserve(triangleCount * 3);
+    std::vector<unsigned int> cache, nextCache;
+    std::size_t nextUnemitted = 0;
+
+    for (std::size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+    {
+        // Nothing in the cache has triangles left, continue with the first triangle in input order
+        if (bestTriangle < 0)
+        {
+            while (isEmitted[nextUnemitted])
+                ++nextUnemitted;
+            bestTriangle = static_cast<int>(nextUnemitted);
+        }
+
+        const unsigned int* corners = &indices[static_cast<std::size_t>(bestTriangle) * 3];
+        output.insert(output.end(), corners, corners + 3);
+        isEmitted[bestTriangle] = true;
+
+        nextCache.clear();
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            unsigned int vertex = corners[corner];
+            auto liveBegin = adjacency.begin() + adjacencyOffsets[vertex];
+            auto liveEnd = liveBegin + liveCounts[vertex];
+            std::iter_swap(std::find(liveBegin, liveEnd, static_cast<unsigned int>(bestTriangle)), liveEnd - 1);
+            --liveCounts[vertex];
+
+            if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end())
+                nextCache.push_back(vertex);
+        }
+
+        for (unsigned int vertex : cache)
+        {
+            if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end())
+                nextCache.push_back(vertex);
+        }
+
+        // Every vertex in the old or new cache changed position or fell out of it
+        for (std::size_t position = 0; position < nextCache.size(); ++position)
+        {
+            unsigned int vertex = nextCache[position];
+            cachePositions[vertex] = position < FORSYTH_CACHE_SIZE ? static_cast<int>(position) : -1;
+            vertexScores[vertex] = GetVertexScore(cachePositions[vertex], liveCounts[vertex]);
+        }
+
+        bestTriangle = -1;
+        float bestScore = -std::numeric_limits<float>::max();
+        for (unsigned int vertex : nextCache)
+        {
+            for (unsigned int i = 0; i < liveCounts[vertex]; ++i)
+            {
+                unsigned int triangle = adjacency[adjacencyOffsets[vertex] + i];
+                const unsigned int* triangleCorners = &indices[static_cast<std::size_t>(triangle) * 3];
+                triangleScores[triangle] = vertexScores[triangleCorners[0]] + vertexScores[triangleCorners[1]]
+                    + vertexScores[triangleCorners[2]];
+
+                if (triangleScores[triangle] > bestScore)
+                {
+                    bestScore = triangleScores[triangle];
+                    bestTriangle = static_cast<int>(triangle);
+                }
+            }
+        }
+
+        nextCache.resize(std::min<std::size_t>(nextCache.size(), FORSYTH_CACHE_SIZE));
+        cache.swap(nextCache);
+    }
+
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void Geometry::MeshOptimization::OptimizeOverdraw(const std::span<unsigned int> indices, const std::span<const Vertex> vertices,
+                                                  const float threshold)
+{
+    std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    /*
+     * Hard boundaries where a triangle misses on all three vertices, nothing connects it to the previous ones.
+     * Inside those, soft boundaries wherever a cold cache would already be back within threshold of the
+     * cluster's ACMR, so splitting there costs little vertex cache efficiency
+     */
+    FifoCache cache(vertices.size(), DEFAULT_CACHE_SIZE);
+    std::vector<std::size_t> hardBoundaries;
+    for (std::size_t triangle = 0; triangle < triangleCount; ++triangle)
+    {
+        if (cache.AccessTriangle(&indices[triangle * 3]) == 3 || triangle == 0)
+            hardBoundaries.push_back(triangle);
+    }
+    hardBoundaries.push_back(triangleCount);
+
+    std::vector<std::size_t> clusters;
+    for (std::size_t hard = 0; hard + 1 < hardBoundaries.size(); ++hard)
+    {
+        std::size_t start = hardBoundaries[hard], end = hardBoundaries[hard + 1];
+
+        cache.Flush();
+        unsigned int clusterMisses = 0;
+        for (std::size_t triangle = start; triangle < end; ++triangle)
+            clusterMisses += cache.AccessTriangle(&indices[triangle * 3]);
+        float clusterACMR = static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+        cache.Flush();
+        clusters.push_back(start);
+        std::size_t softStart = start;
+        unsigned int softMisses = 0;
+
+        for (std::size_t triangle = start; triangle + 1 < end; ++triangle)
+        {
+            softMisses += cache.AccessTriangle(&indices[triangle * 3]);
+            if (static_cast<float>(softMisses) / static_cast<float>(triangle + 1 - softStart) <= clusterACMR * threshold)
+            {
+                clusters.push_back(triangle + 1);
+                softStart = triangle + 1;
+                softMisses = 0;
+                cache.Flush();
+            }
+        }
+    }
+    clusters.push_back(triangleCount);
+
+    /*
+     * Clusters facing away from the mesh centre are in front of the rest from most views, so they go first
+     */
+    std::vector<glm::vec3> clusterCentroids(clusters.size() - 1, glm::vec3(0.0f));
+    std::vector<glm::vec3> clusterNormals(clusters.size() - 1, glm::vec3(0.0f));
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+
+    for (std::size_t cluster = 0; cluster + 1 < clusters.size(); ++cluster)
+    {
+        float clusterArea = 0.0f;
+        for (std::size_t triangle = clusters[cluster]; triangle < clusters[cluster + 1]; ++triangle)
+        {
+            const glm::vec3& a = vertices[indices[triangle * 3]].position;
+            const glm::vec3& b = vertices[indices[triangle * 3 + 1]].position;
+            const glm::vec3& c = vertices[indices[triangle * 3 + 2]].position;
+
+            // The cross product's length is twice the area, so summing it weights normals and centroids by area
+            glm::vec3 normal = glm::cross(b - a, c - a);
+            float area = glm::length(normal);
+            glm::vec3 centroid = (a + b + c) * (area / 3.0f);
+
+            clusterNormals[cluster] += normal;
+            clusterCentroids[cluster] += centroid;
+            clusterArea += area;
+            meshCentroid += centroid;
+        }
+
+        if (clusterArea > 0.0f)
+            clusterCentroids[cluster] /= clusterArea;
+        meshArea += clusterArea;
+    }
+
+    if (meshArea > 0.0f)
+        meshCentroid /= meshArea;
+
+    std::vector<float> sortKeys(clusters.size() - 1);
+    for (std::size_t cluster = 0; cluster < sortKeys.size(); ++cluster)
+    {
+        float normalLength = glm::length(clusterNormals[cluster]);
+        glm::vec3 normal = normalLength > 0.0f ? clusterNormals[cluster] / normalLength : glm::vec3(0.0f);
+        sortKeys[cluster] = glm::dot(clusterCentroids[cluster] - meshCentroid, normal);
+    }
+
+    std::vector<std::size_t> order(sortKeys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sortKeys](const std::size_t a, const std::size_t b)
+    {
+        return sortKeys[a] > sortKeys[b];
+    });
+
+    std::vector<unsigned int> output;
+    output.reserve(triangleCount * 3);
+    for (std::size_t cluster : order)
+        output.insert(output.end(), indices.begin() + clusters[cluster] * 3, indices.begin() + clusters[cluster + 1] * 3);
+
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void Geometry::MeshOptimization::OptimizeVertexFetch(std::vector<Vertex>& vertices, const std::span<unsigned int> indices)
+{
+    constexpr unsigned int UNUSED = std::numeric_limits<unsigned int>::max();
+
+    std::vector<unsigned int> remap(vertices.size(), UNUSED);
+    std::vector<Vertex> reordered;
+    reordered.reserve(vertices.size());
+
+    for (unsigned int& index : indices)
+    {
+        if (remap[index] == UNUSED)
+        {
+            remap[index] = static_cast<unsigned int>(reordered.size());
+            reordered.push_back(vertices[index]);
+        }
+
+        index = remap[index];
+    }
+
+    vertices = std::move(reordered);
+}
+
+Geometry::VertexCacheStatistics Geometry::MeshOptimization::AnalyzeVertexCache(const std::span<const unsigned int> indices,
+                                                                               const std::size_t vertexCount, const unsigned int cacheSize)
+{
+    std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0)
+        return { 0.0f, 0.0f };
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::size_t transformedCount = 0;
+    for (unsigned int index : indices)
+        transformedCount += cache.Access(index);
+
+    return {
+        static_cast<float>(transformedCount) / static_cast<float>(triangleCount),
+        static_cast<float>(transformedCount) / static_cast<float>(vertexCount)
+    };
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "geometry_structs.h"
+
+namespace Geometry
+{
+    struct VertexCacheStatistics
+    {
+        // Vertex shader runs per triangle and per vertex, 0.5 and 1.0 are the best a large closed mesh can do
+        float acmr;
+        float atvr;
+    };
+
+    /*
+     * Reordering passes run once at import, so the mesh cache keeps their result. Triangles are ordered for the
+     * post-transform vertex cache first, then regrouped into clusters that draw likely occluders first from any
+     * view, and vertices last so they are fetched in the order the indices reach them
+     */
+    namespace MeshOptimization
+    {
+        constexpr unsigned int DEFAULT_CACHE_SIZE = 16;
+
+        // Runs the three passes in order
+        void Optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+        // Forsyth's linear-speed optimizer, scoring vertices by their position in a simulated LRU cache
+        void OptimizeVertexCache(std::span<unsigned int> indices, std::size_t vertexCount);
+        // Splits the vertex cache order into clusters, at cache flushes and wherever the ACMR stays within threshold,
+        // then sorts the clusters so those facing away from the mesh centre are drawn first
+        void OptimizeOverdraw(std::span<unsigned int> indices, std::span<const Vertex> vertices, float threshold = 1.05f);
+        // Renumbers vertices by first use, vertices no index refers to are dropped
+        void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::span<unsigned int> indices);
+
+        // Simulates a FIFO post-transform cache of cacheSize vertices
+        VertexCacheStatistics AnalyzeVertexCache(std::span<const unsigned int> indices, std::size_t vertexCount,
+                                                 unsigned int cacheSize = DEFAULT_CACHE_SIZE);
+    }
+}
@@ -0,0 +1,348 @@
+#include "mesh_simplification.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <unordered_map>
+
+#include "mesh_optimization.h"
+
+namespace
+{
+    constexpr unsigned int NONE = ~0u;
+    // Levels stop once a pass removes less than this share of the previous level's triangles
+    constexpr float MIN_LOD_REDUCTION = 0.8f;
+    constexpr std::size_t MIN_LOD_TRIANGLES = 16;
+
+    // Sum of squared distances to a set of planes, weighted by triangle area
+    struct Quadric
+    {
+        double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+        double b0 = 0, b1 = 0, b2 = 0, c = 0;
+        double weight = 0;
+
+        void AddPlane(const glm::dvec3& normal, const double distance, const double area)
+        {
+            a00 += area * normal.x * normal.x; a01 += area * normal.x * normal.y; a02 += area * normal.x * normal.z;
+            a11 += area * normal.y * normal.y; a12 += area * normal.y * normal.z; a22 += area * normal.z * normal.z;
+            b0 += area * normal.x * distance; b1 += area * normal.y * distance; b2 += area * normal.z * distance;
+            c += area * distance * distance;
+            weight += area;
+        }
+
+        void Add(const Quadric& other)
+        {
+            a00 += other.a00; a01 += other.a01; a02 += other.a02; a11 += other.a11; a12 += other.a12; a22 += other.a22;
+            b0 += other.b0; b1 += other.b1; b2 += other.b2; c += other.c;
+            weight += other.weight;
+        }
+
+        // Unweighted sum at point
+        double Evaluate(const glm::dvec3& point) const
+        {
+            double x = point.x, y = point.y, z = point.z;
+            return a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + a11 * y * y + 2.0 * a12 * y * z + a22 * z * z
+                 + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        }
+    };
+
+    struct Collapse
+    {
+        unsigned int target;
+        double cost;
+    };
+
+    // Mean squared distance to the planes both quadrics hold, with the merged vertex at point
+    double GetCollapseCost(const Quadric& from, const Quadric& to, const glm::dvec3& point)
+    {
+        double weight = from.weight + to.weight;
+        return weight > 0.0 ? std::max(0.0, (from.Evaluate(point) + to.Evaluate(point)) / weight) : 0.0;
+    }
+
+    std::uint64_t GetEdgeKey(const unsigned int a, const unsigned int b)
+    {
+        return (static_cast<std::uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+    }
+}
+
+std::vector<unsigned int> Geometry::MeshSimplification::Simplify(const std::span<const Vertex> vertices, const std::span<const unsigned int> indices,
+                                                                 const std::size_t targetIndexCount, float& error)
+{
+    error = 0.0f;
+    std::vector<unsigned int> result(indices.begin(), indices.end());
+    if (result.size() <= targetIndexCount || vertices.empty())
+        return result;
+
+    /*
+     * Group vertices by position, the simplifier works on positions and moves the vertices at each along
+     */
+    std::vector<unsigned int> sortedVertices(vertices.size());
+    std::iota(sortedVertices.begin(), sortedVertices.end(), 0);
+    std::sort(sortedVertices.begin(), sortedVertices.end(), [&vertices](const unsigned int a, const unsigned int b)
+    {
+        const glm::vec3& left = vertices[a].position;
+        const glm::vec3& right = vertices[b].position;
+        return left.x != right.x ? left.x < right.x : left.y != right.y ? left.y < right.y : left.z < right.z;
+    });
+
+    std::vector<unsigned int> vertexPositions(vertices.size());
+    std::vector<unsigned int> wedgeOffsets;
+    std::vector<glm::dvec3> positions;
+    for (std::size_t i = 0; i < sortedVertices.size(); ++i)
+    {
+        if (i == 0 || vertices[sortedVertices[i]].position != vertices[sortedVertices[i - 1]].position)
+        {
+            wedgeOffsets.push_back(static_cast<unsigned int>(i));
+            positions.emplace_back(vertices[sortedVertices[i]].position);
+        }
+
+        vertexPositions[sortedVertices[i]] = static_cast<unsigned int>(positions.size() - 1);
+    }
+    wedgeOffsets.push_back(static_cast<unsigned int>(sortedVertices.size()));
+    const std::size_t positionCount = positions.size();
+
+    /*
+     * Quadrics from the original triangles, and locks for positions on open or non-manifold edges and for
+     * positions where more than two attribute sets meet, which have no single seam to slide along
+     */
+    std::vector<Quadric> quadrics(positionCount);
+    std::vector<unsigned char> isLocked(positionCount, 0);
+    std::unordered_map<std::uint64_t, unsigned int> edgeTriangleCounts;
+
+    for (std::size_t corner = 0; corner + 2 < result.size(); corner += 3)
+    {
+        unsigned int a = vertexPositions[result[corner]], b = vertexPositions[result[corner + 1]], c = vertexPositions[result[corner + 2]];
+        if (a == b || b == c || a == c)
+            continue;
+
+        glm::dvec3 normal = glm::cross(positions[b] - positions[a], positions[c] - positions[a]);
+        double length = glm::length(normal);
+        if (length > 0.0)
+        {
+            normal /= length;
+            double distance = -glm::dot(normal, positions[a]);
+            for (unsigned int position : { a, b, c })
+                quadrics[position].AddPlane(normal, distance, length * 0.5);
+        }
+
+        ++edgeTriangleCounts[GetEdgeKey(a, b)];
+        ++edgeTriangleCounts[GetEdgeKey(b, c)];
+        ++edgeTriangleCounts[GetEdgeKey(c, a)];
+    }
+
+    for (const auto& [edge, triangleCount] : edgeTriangleCounts)
+    {
+        if (triangleCount != 2)
+        {
+            isLocked[static_cast<unsigned int>(edge >> 32)] = 1;
+            isLocked[static_cast<unsigned int>(edge & 0xFFFFFFFFu)] = 1;
+        }
+    }
+
+    for (std::size_t position = 0; position < positionCount; ++position)
+    {
+        if (wedgeOffsets[position + 1] - wedgeOffsets[position] > 2)
+            isLocked[position] = 1;
+    }
+
+    /*
+     * Passes of independent collapses, cheapest first, until the target is reached or nothing can collapse
+     */
+    std::vector<unsigned int> triangleOffsets(vertices.size() + 1);
+    std::vector<unsigned int> vertexTriangles;
+    std::vector<Collapse> collapses(positionCount);
+    std::vector<unsigned int> candidates;
+    std::vector<unsigned char> isTouched(positionCount);
+    std::vector<unsigned int> vertexRemap(vertices.size());
+    std::vector<unsigned int> wedgeTargets;
+    double maxCost = 0.0;
+
+    while (result.size() > targetIndexCount)
+    {
+        // Triangles around every vertex of the current level
+        std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+        for (unsigned int index : result)
+            ++triangleOffsets[index + 1];
+        std::partial_sum(triangleOffsets.begin(), triangleOffsets.end(), triangleOffsets.begin());
+
+        vertexTriangles.resize(result.size());
+        std::vector<unsigned int> fillOffsets(triangleOffsets.begin(), triangleOffsets.end() - 1);
+        for (std::size_t corner = 0; corner < result.size(); ++corner)
+            vertexTriangles[fillOffsets[result[corner]]++] = static_cast<unsigned int>(corner / 3);
+
+        // Cheapest collapse out of every unlocked position along its edges
+        std::fill(collapses.begin(), collapses.end(), Collapse { NONE, 0.0 });
+        for (std::size_t corner = 0; corner < result.size(); corner += 3)
+        {
+            for (int edge = 0; edge < 3; ++edge)
+            {
+                unsigned int from = vertexPositions[result[corner + edge]];
+                unsigned int to = vertexPositions[result[corner + (edge + 1) % 3]];
+
+                for (int direction = 0; direction < 2; ++direction, std::swap(from, to))
+                {
+                    if (isLocked[from] || from == to)
+                        continue;
+
+                    double cost = GetCollapseCost(quadrics[from], quadrics[to], positions[to]);
+                    if (collapses[from].target == NONE || cost < collapses[from].cost)
+                        collapses[from] = { to, cost };
+                }
+            }
+        }
+
+        candidates.clear();
+        for (unsigned int position = 0; position < positionCount; ++position)
+        {
+            if (collapses[position].target != NONE)
+                candidates.push_back(position);
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [&collapses](const unsigned int a, const unsigned int b)
+        {
+            return collapses[a].cost < collapses[b].cost;
+        });
+
+        std::fill(isTouched.begin(), isTouched.end(), 0);
+        std::iota(vertexRemap.begin(), vertexRemap.end(), 0);
+
+        // Manifold collapses remove two triangles each, half the remaining budget keeps every pass to the cheapest ones
+        std::size_t collapseBudget = (result.size() - targetIndexCount) / 6 + 1;
+        std::size_t collapseCount = 0;
+
+        for (unsigned int from : candidates)
+        {
+            if (collapseCount >= collapseBudget)
+                break;
+
+            unsigned int to = collapses[from].target;
+            if (isTouched[from] || isTouched[to])
+                continue;
+
+            /*
+             * Every vertex at from needs a vertex at to it shares an edge with, so each side of a seam
+             * moves along with its own attributes. Triangles that survive must not flip over
+             */
+            bool isValid = true;
+            bool hasTriangles = false;
+            wedgeTargets.clear();
+
+            for (unsigned int wedge = wedgeOffsets[from]; wedge < wedgeOffsets[from + 1] && isValid; ++wedge)
+            {
+                unsigned int vertex = sortedVertices[wedge];
+                unsigned int target = NONE;
+
+                for (unsigned int i = triangleOffsets[vertex]; i < triangleOffsets[vertex + 1] && isValid; ++i)
+                {
+                    const unsigned int* triangle = &result[static_cast<std::size_t>(vertexTriangles[i]) * 3];
+                    hasTriangles = true;
+
+                    int fromCorner = 0;
+                    bool containsTarget = false;
+                    for (int corner = 0; corner < 3; ++corner)
+                    {
+                        if (triangle[corner] == vertex)
+                            fromCorner = corner;
+                        if (vertexPositions[triangle[corner]] == to)
+                        {
+                            containsTarget = true;
+                            target = triangle[corner];
+                        }
+                    }
+
+                    if (containsTarget)
+                        continue;
+
+                    const glm::dvec3& a = positions[vertexPositions[triangle[(fromCorner + 1) % 3]]];
+                    const glm::dvec3& b = positions[vertexPositions[triangle[(fromCorner + 2) % 3]]];
+                    glm::dvec3 normalBefore = glm::cross(a - positions[from], b - positions[from]);
+                    glm::dvec3 normalAfter = glm::cross(a - positions[to], b - positions[to]);
+                    isValid = glm::dot(normalBefore, normalAfter) > 0.0;
+                }
+
+                // A vertex no triangle uses any more has nothing to move
+                bool isUsed = triangleOffsets[vertex + 1] > triangleOffsets[vertex];
+                if (isUsed && target == NONE)
+                    isValid = false;
+
+                wedgeTargets.push_back(isUsed ? target : NONE);
+            }
+
+            if (!isValid || !hasTriangles)
+                continue;
+
+            for (unsigned int wedge = wedgeOffsets[from]; wedge < wedgeOffsets[from + 1]; ++wedge)
+            {
+                unsigned int target = wedgeTargets[wedge - wedgeOffsets[from]];
+                if (target != NONE)
+                    vertexRemap[sortedVertices[wedge]] = target;
+            }
+
+            // Neighbours keep their geometry for the rest of the pass, so the flip tests above stay valid
+            for (unsigned int wedge = wedgeOffsets[from]; wedge < wedgeOffsets[from + 1]; ++wedge)
+            {
+                unsigned int vertex = sortedVertices[wedge];
+                for (unsigned int i = triangleOffsets[vertex]; i < triangleOffsets[vertex + 1]; ++i)
+                {
+                    for (int corner = 0; corner < 3; ++corner)
+                        isTouched[vertexPositions[result[static_cast<std::size_t>(vertexTriangles[i]) * 3 + corner]]] = 1;
+                }
+            }
+
+            quadrics[to].Add(quadrics[from]);
+            isLocked[from] = 1;
+            maxCost = std::max(maxCost, collapses[from].cost);
+            ++collapseCount;
+        }
+
+        if (collapseCount == 0)
+            break;
+
+        // Apply the pass and drop the triangles that collapsed to a line
+        std::size_t writeOffset = 0;
+        for (std::size_t corner = 0; corner < result.size(); corner += 3)
+        {
+            unsigned int a = vertexRemap[result[corner]], b = vertexRemap[result[corner + 1]], c = vertexRemap[result[corner + 2]];
+            unsigned int positionA = vertexPositions[a], positionB = vertexPositions[b], positionC = vertexPositions[c];
+            if (positionA == positionB || positionB == positionC || positionA == positionC)
+                continue;
+
+            result[writeOffset++] = a;
+            result[writeOffset++] = b;
+            result[writeOffset++] = c;
+        }
+        result.resize(writeOffset);
+    }
+
+    error = static_cast<float>(std::sqrt(maxCost));
+    return result;
+}
+
+std::vector<Geometry::MeshLod> Geometry::MeshSimplification::GenerateLods(const std::span<const Vertex> vertices, std::vector<unsigned int>& indices)
+{
+    std::vector<MeshLod> lods { { 0, static_cast<unsigned int>(indices.size()), 0.0f } };
+    const std::size_t fullIndexCount = indices.size();
+
+    // Every level is simplified from the full mesh, so errors are measured against the real surface
+    while (lods.size() < MAX_LOD_COUNT)
+    {
+        std::size_t previousIndexCount = lods.back().indexCount;
+        std::size_t targetIndexCount = previousIndexCount / 6 * 3;
+        if (targetIndexCount < MIN_LOD_TRIANGLES * 3)
+            break;
+
+        float error;
+        std::vector<unsigned int> levelIndices = Simplify(vertices, std::span(indices).first(fullIndexCount), targetIndexCount, error);
+        if (static_cast<float>(levelIndices.size()) > static_cast<float>(previousIndexCount) * MIN_LOD_REDUCTION)
+            break;
+
+        MeshOptimization::OptimizeVertexCache(levelIndices, vertices.size());
+
+        lods.push_back({ static_cast<unsigned int>(indices.size()), static_cast<unsigned int>(levelIndices.size()),
+                         std::max(error, lods.back().error) });
+        indices.insert(indices.end(), levelIndices.begin(), levelIndices.end());
+    }
+
+    return lods;
+}
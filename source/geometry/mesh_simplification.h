@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "geometry_structs.h"
+
+namespace Geometry
+{
+    /*
+     * Quadric error metric simplification by half-edge collapses, so every level keeps using the vertices of the
+     * full mesh and all levels fit in one vertex buffer. Vertices sharing a position but not their attributes form
+     * a seam and only collapse along it, together, so normal and texture coordinate seams stay where they are.
+     * Open borders are locked
+     */
+    namespace MeshSimplification
+    {
+        constexpr std::size_t MAX_LOD_COUNT = 5;
+
+        // Indices of a simplified copy with at most targetIndexCount indices, or as close as the constraints allow.
+        // error receives the root mean square distance to the planes of the original triangles that were merged
+        std::vector<unsigned int> Simplify(std::span<const Vertex> vertices, std::span<const unsigned int> indices,
+                                           std::size_t targetIndexCount, float& error);
+
+        // indices holds level 0 and gets every coarser level appended, each halving the triangles of the last
+        std::vector<MeshLod> GenerateLods(std::span<const Vertex> vertices, std::vector<unsigned int>& indices);
+    }
+}
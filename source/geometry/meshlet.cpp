@@ -0,0 +1,234 @@
+#include "meshlet.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // Below this the normals spread over more than a hemisphere and a cone test would reject visible triangles
+    constexpr float MIN_CONE_SPREAD = 0.1f;
+}
+
+std::vector<Geometry::Meshlet> Geometry::Meshlets::Build(const std::span<const Vertex> vertices, const std::span<unsigned int> indices)
+{
+    constexpr unsigned int NONE = std::numeric_limits<unsigned int>::max();
+    auto triangleCount = static_cast<unsigned int>(indices.size() / 3);
+
+    /*
+
+        TRIANGLE ADJACENCY
+
+    */
+    // Triangles of each vertex, vertex v's are vertexTriangles[vertexTriangleOffsets[v]] up to those of v + 1
+    std::vector<unsigned int> vertexTriangleOffsets(vertices.size() + 1, 0);
+    for (std::size_t corner = 0; corner < triangleCount * 3; ++corner)
+        ++vertexTriangleOffsets[indices[corner] + 1];
+    for (std::size_t vertex = 0; vertex < vertices.size(); ++vertex)
+        vertexTriangleOffsets[vertex + 1] += vertexTriangleOffsets[vertex];
+
+    std::vector<unsigned int> vertexTriangles(triangleCount * 3);
+    std::vector<unsigned int> vertexTriangleCounts(vertices.size(), 0);
+    std::vector<glm::vec3> triangleCentroids(triangleCount);
+    for (unsigned int triangle = 0; triangle < triangleCount; ++triangle)
+    {
+        const unsigned int* corners = &indices[triangle * 3];
+        for (int corner = 0; corner < 3; ++corner)
+            vertexTriangles[vertexTriangleOffsets[corners[corner]] + vertexTriangleCounts[corners[corner]]++] = triangle;
+
+        triangleCentroids[triangle] = (vertices[corners[0]].position + vertices[corners[1]].position
+                                       + vertices[corners[2]].position) / 3.0f;
+    }
+
+    /*
+
+        GROW MESHLETS
+
+    */
+    std::vector<Meshlet> meshlets;
+    std::vector<unsigned int> orderedIndices;
+    orderedIndices.reserve(triangleCount * 3);
+    std::vector<bool> isEmitted(triangleCount, false);
+    // Last meshlet each vertex was counted in, plus one so zero means none
+    std::vector<unsigned int> vertexMeshlets(vertices.size(), 0);
+    std::vector<unsigned int> meshletVertices, previousMeshletVertices;
+    glm::vec3 centroidSum(0.0f), previousCentroid(0.0f);
+    Meshlet meshlet { 0, 0, 0 };
+    unsigned int firstUnemitted = 0;
+
+    auto countNewVertices = [&](const unsigned int triangle)
+    {
+        const unsigned int* corners = &indices[triangle * 3];
+        auto meshletId = static_cast<unsigned int>(meshlets.size() + 1);
+
+        unsigned int newVertexCount = 0;
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            bool isRepeated = (corner > 0 && corners[corner] == corners[0]) || (corner > 1 && corners[corner] == corners[1]);
+            if (vertexMeshlets[corners[corner]] != meshletId && !isRepeated)
+                ++newVertexCount;
+        }
+
+        return newVertexCount;
+    };
+
+    // The unemitted triangle around the given vertices that adds the fewest vertices, then lies closest to center
+    auto findNeighbour = [&](const std::span<const unsigned int> aroundVertices, const glm::vec3 center)
+    {
+        unsigned int best = NONE, bestNewVertices = 0;
+        float bestDistance = 0.0f;
+        for (unsigned int vertex : aroundVertices)
+        {
+            for (unsigned int i = vertexTriangleOffsets[vertex]; i < vertexTriangleOffsets[vertex + 1]; ++i)
+            {
+                unsigned int triangle = vertexTriangles[i];
+                if (isEmitted[triangle])
+                    continue;
+
+                unsigned int newVertices = countNewVertices(triangle);
+                if (meshlet.vertexCount + newVertices > MAX_VERTICES)
+                    continue;
+
+                glm::vec3 offset = triangleCentroids[triangle] - center;
+                float distance = glm::dot(offset, offset);
+                if (best == NONE || newVertices < bestNewVertices || (newVertices == bestNewVertices && distance < bestDistance))
+                {
+                    best = triangle;
+                    bestNewVertices = newVertices;
+                    bestDistance = distance;
+                }
+            }
+        }
+
+        return best;
+    };
+
+    for (unsigned int emitted = 0; emitted < triangleCount; ++emitted)
+    {
+        unsigned int next = NONE;
+        if (meshlet.triangleCount > 0 && meshlet.triangleCount < MAX_TRIANGLES)
+            next = findNeighbour(meshletVertices, centroidSum / static_cast<float>(meshlet.triangleCount));
+
+        if (next == NONE)
+        {
+            // Full or cut off from the rest, the next meshlet starts next to this one where it can
+            if (meshlet.triangleCount > 0)
+            {
+                meshlets.push_back(meshlet);
+                previousCentroid = centroidSum / static_cast<float>(meshlet.triangleCount);
+                std::swap(previousMeshletVertices, meshletVertices);
+
+                meshlet = { static_cast<unsigned int>(orderedIndices.size()), 0, 0 };
+                meshletVertices.clear();
+                centroidSum = glm::vec3(0.0f);
+            }
+
+            next = findNeighbour(previousMeshletVertices, previousCentroid);
+            if (next == NONE)
+            {
+                while (isEmitted[firstUnemitted])
+                    ++firstUnemitted;
+                next = firstUnemitted;
+            }
+        }
+
+        auto meshletId = static_cast<unsigned int>(meshlets.size() + 1);
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            unsigned int vertex = indices[next * 3 + corner];
+            if (vertexMeshlets[vertex] != meshletId)
+            {
+                vertexMeshlets[vertex] = meshletId;
+                meshletVertices.push_back(vertex);
+                ++meshlet.vertexCount;
+            }
+
+            orderedIndices.push_back(vertex);
+        }
+
+        isEmitted[next] = true;
+        centroidSum += triangleCentroids[next];
+        ++meshlet.triangleCount;
+    }
+
+    if (meshlet.triangleCount > 0)
+        meshlets.push_back(meshlet);
+
+    std::copy(orderedIndices.begin(), orderedIndices.end(), indices.begin());
+    return meshlets;
+}
+
+Geometry::MeshletBounds Geometry::Meshlets::ComputeBounds(const std::span<const Meshlet> meshlets, const std::span<const Vertex> vertices,
+                                                          const std::span<const unsigned int> indices)
+{
+    std::size_t paddedCount = (meshlets.size() + BOUNDS_ALIGNMENT - 1) / BOUNDS_ALIGNMENT * BOUNDS_ALIGNMENT;
+
+    MeshletBounds bounds;
+    for (std::vector<float>* values : { &bounds.centerX, &bounds.centerY, &bounds.centerZ, &bounds.radius,
+                                        &bounds.coneAxisX, &bounds.coneAxisY, &bounds.coneAxisZ })
+        values->assign(paddedCount, 0.0f);
+    bounds.coneCutoff.assign(paddedCount, 1.0f);
+
+    std::vector<glm::vec3> normals;
+    for (std::size_t i = 0; i < meshlets.size(); ++i)
+    {
+        std::span<const unsigned int> meshletIndices = indices.subspan(meshlets[i].firstIndex, meshlets[i].triangleCount * 3);
+
+        /*
+         * Sphere around the centre of the bounding box, the same fit Mesh uses for the whole mesh
+         */
+        glm::vec3 minimum = vertices[meshletIndices.front()].position, maximum = minimum;
+        for (unsigned int index : meshletIndices)
+        {
+            minimum = glm::min(minimum, vertices[index].position);
+            maximum = glm::max(maximum, vertices[index].position);
+        }
+
+        glm::vec3 center = (minimum + maximum) * 0.5f;
+        float radius = 0.0f;
+        for (unsigned int index : meshletIndices)
+            radius = std::max(radius, glm::length(vertices[index].position - center));
+
+        bounds.centerX[i] = center.x;
+        bounds.centerY[i] = center.y;
+        bounds.centerZ[i] = center.z;
+        bounds.radius[i] = radius;
+
+        /*
+         * Cone around the average face normal, wide enough for the normal furthest from it
+         */
+        normals.clear();
+        glm::vec3 normalSum(0.0f);
+        for (std::size_t corner = 0; corner < meshletIndices.size(); corner += 3)
+        {
+            const glm::vec3& a = vertices[meshletIndices[corner]].position;
+            const glm::vec3& b = vertices[meshletIndices[corner + 1]].position;
+            const glm::vec3& c = vertices[meshletIndices[corner + 2]].position;
+
+            glm::vec3 normal = glm::cross(b - a, c - a);
+            float length = glm::length(normal);
+            if (length <= 0.0f)
+                continue;
+
+            normals.push_back(normal / length);
+            normalSum += normals.back();
+        }
+
+        float sumLength = glm::length(normalSum);
+        if (normals.empty() || sumLength <= 0.0f)
+            continue;
+
+        glm::vec3 axis = normalSum / sumLength;
+        float minimumDot = 1.0f;
+        for (const glm::vec3& normal : normals)
+            minimumDot = std::min(minimumDot, glm::dot(axis, normal));
+
+        bounds.coneAxisX[i] = axis.x;
+        bounds.coneAxisY[i] = axis.y;
+        bounds.coneAxisZ[i] = axis.z;
+        // Sine of the cone's half angle, which the culler compares against directly
+        bounds.coneCutoff[i] = minimumDot <= MIN_CONE_SPREAD ? 1.0f : std::sqrt(1.0f - minimumDot * minimumDot);
+    }
+
+    return bounds;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "geometry_structs.h"
+
+namespace Geometry
+{
+    // A run of consecutive triangles in the index buffer, grown over shared vertices so its surface is local and
+    // close to flat
+    struct Meshlet
+    {
+        unsigned int firstIndex;
+        unsigned int triangleCount;
+        unsigned int vertexCount;
+    };
+
+    /*
+     * Model space bounds of every meshlet as a structure of arrays, padded to a multiple of four so the culler
+     * tests four meshlets per step without a remainder loop. The cone holds every triangle normal, a cutoff of one
+     * disables back-face culling for meshlets whose normals spread too far for it
+     */
+    struct MeshletBounds
+    {
+        std::vector<float> centerX, centerY, centerZ, radius;
+        std::vector<float> coneAxisX, coneAxisY, coneAxisZ, coneCutoff;
+    };
+
+    namespace Meshlets
+    {
+        constexpr unsigned int MAX_VERTICES = 64;
+        constexpr unsigned int MAX_TRIANGLES = 124;
+        constexpr std::size_t BOUNDS_ALIGNMENT = 4;
+
+        /*
+         * Grows each meshlet from a seed triangle, always adding the neighbouring triangle that brings the fewest
+         * new vertices and lies closest to the meshlet's centre, and starts the next one beside it. indices is
+         * reordered so every meshlet is one index range
+         */
+        std::vector<Meshlet> Build(std::span<const Vertex> vertices, std::span<unsigned int> indices);
+        MeshletBounds ComputeBounds(std::span<const Meshlet> meshlets, std::span<const Vertex> vertices,
+                                    std::span<const unsigned int> indices);
+    }
+}
@@ -1,116 +1,269 @@
 #include "model.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <string>
-#include <utility>
+#include <unordered_map>
 
+#include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
 
-#include "../assets/import_functions.h"
+#include "cluster_culler.h"
+#include "glb_importer.h"
+#include "lod_selector.h"
+#include "mesh_simplification.h"
+#include "obj_parser.h"
+#include "vertex_welding.h"
+#include "../assets/asset_pack.h"
+#include "../assets/texture_streamer.h"
+#include "../utility/thread_pool.h"
+
+Geometry::Model::Model(const std::span<const Vertex> vertices, const std::span<const unsigned int> indices,
+                       const std::span<const MeshLod> lods, const unsigned int cornerCount, const unsigned int materialOffset,
+                       const VertexFormat vertexFormat)
+    : position(0.0f, 0.0f, 0.0f), scale(1.0f, 1.0f, 1.0f), mInstanceAmount(0), mCornerCount(cornerCount),
+      mMaterialOffset(materialOffset), mMesh(std::make_shared<Mesh>())
+{
+    mMesh->SetupMesh(vertices, indices, lods, vertexFormat);
+}
 
-Geometry::Model::Model(const char *path, std::vector<Material>* materials, unsigned int modelIndex)
-    : position(0.0f, 0.0f, 0.0f), scale(1.0f, 1.0f, 1.0f), mInstanceAmount(0), mModelIndex(modelIndex)
+Geometry::Model::LastCopyCallback::~LastCopyCallback()
 {
-    std::ifstream object;
-    object.exceptions(std::ifstream::badbit);
+    if (onDestroyed)
+        onDestroyed();
+}
 
-    try
-    {
-        object.open(path);
-    } catch (std::ifstream::failure &exception)
-    {
+Geometry::ModelData Geometry::Model::ImportObj(const char *path)
+{
+    ModelData modelData;
+
+    Assets::AssetFile object(path);
+    if (!object.IsOpen())
         std::cout << "ERROR::ASSET::OBJ_FILE_NOT_SUCCESSFULLY_READ" << std::endl;
-    }
 
-    std::vector<glm::vec3> vertexPositions;
-    std::vector<glm::vec3> vertexNormals;
-    std::vector<glm::vec2> textureCoordinates;
-    std::vector<Face> faces;
-    std::string currentLine;
-    std::string currentMaterialName;
+    Utility::ThreadPool& threadPool = Utility::ThreadPool::GetShared();
+    ObjData data = ObjParser::ParseParallel(object.View(), threadPool, threadPool.GetThreadCount() + 1);
 
-    while (object.is_open() && !object.eof())
+    for (const std::string& materialLibrary : data.materialLibraries)
     {
-        std::getline(object, currentLine);
-        if (currentLine.empty() || currentLine[0] == '#')
-            continue;
-
-        std::stringstream lineStream(currentLine);
-        std::string lineWord;
-        lineStream >> lineWord;
+        modelData.materialFiles.push_back(GetSiblingPath(path, materialLibrary));
 
-        if (lineWord == "mtllib")
+        for (auto& material : ReadMaterialFile(modelData.materialFiles.back(), path))
         {
-            for (const auto& material : ReadMaterialFile(lineStream, path))
-            {
-                materials->push_back(material);
-            }
+            modelData.materials.push_back(std::move(material));
         }
-        else if (lineWord == "v")
-            vertexPositions.push_back(ReadVec3FromLine(lineStream));
-        else if (lineWord == "vn")
-            vertexNormals.push_back(ReadVec3FromLine(lineStream));
-        else if (lineWord == "vt")
-            textureCoordinates.push_back(ReadVec2FromLine(lineStream));
-        else if (lineWord == "usemtl")
-            lineStream >> currentMaterialName;
-        else if (lineWord == "f")
-            faces.push_back(ReadFaceFromLine(lineStream, currentMaterialName));
     }
 
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
+    /*
+     * Resolve usemtl names once per group instead of once per vertex
+     */
+    std::unordered_map<std::string_view, int> materialIndices;
+    for (std::size_t i = 0; i < modelData.materials.size(); ++i)
+    {
+        materialIndices.emplace(modelData.materials[i].name, static_cast<int>(i));
+    }
+
+    std::vector<int> groupMaterialIndices;
+    groupMaterialIndices.reserve(data.materialGroups.size());
+    for (const ObjMaterialGroup& group : data.materialGroups)
+    {
+        auto material = materialIndices.find(group.materialName);
+        groupMaterialIndices.push_back(material != materialIndices.end() ? material->second : -1);
+    }
+
+    /*
+     * Weld identical face corners so faces share vertices in the index buffer
+     */
+    std::size_t attributeCount = std::max({ data.positions.size(), data.normals.size(), data.textureCoordinates.size() });
+    VertexWelder welder(attributeCount);
+    std::vector<unsigned int>& indices = modelData.indices;
+    indices.reserve(3 * data.corners.size());
+
+    int materialIndex = -1;
+    std::size_t nextGroup = 0;
+    const unsigned int faceCount = data.GetFaceCount();
 
-    for (const Face &face: faces)
+    for (unsigned int face = 0; face < faceCount; ++face)
     {
-        unsigned int baseIndex = vertices.size();
+        while (nextGroup < data.materialGroups.size() && data.materialGroups[nextGroup].firstFace <= face)
+            materialIndex = groupMaterialIndices[nextGroup++];
 
-        for (int i = 0; i < face.vertexIndices.size(); ++i)
+        const unsigned int firstCorner = data.faceOffsets[face];
+        const unsigned int cornerCount = data.faceOffsets[face + 1] - firstCorner;
+        unsigned int fanStartIndex = 0;
+        unsigned int previousIndex = 0;
+
+        for (unsigned int i = 0; i < cornerCount; ++i)
         {
-            unsigned int vertexPosIndex = face.vertexIndices[i] - 1;
-            unsigned int vertexNormIndex = face.normalIndices[i] - 1;
-            unsigned int texCoordIndex = face.textureCoordinateIndices[i] - 1;
-
-            vertices.push_back({
-                vertexPositions[vertexPosIndex],
-                vertexNormals[vertexNormIndex],
-                textureCoordinates[texCoordIndex],
-                GetMaterialIndex(face.materialName, *materials)
+            const ObjCorner& corner = data.corners[firstCorner + i];
+
+            unsigned int index = welder.Add({
+                corner.position >= 0 && static_cast<std::size_t>(corner.position) < data.positions.size()
+                    ? data.positions[corner.position] : glm::vec3(0.0f),
+                corner.normal >= 0 && static_cast<std::size_t>(corner.normal) < data.normals.size()
+                    ? data.normals[corner.normal] : glm::vec3(0.0f),
+                corner.textureCoordinates >= 0 && static_cast<std::size_t>(corner.textureCoordinates) < data.textureCoordinates.size()
+                    ? data.textureCoordinates[corner.textureCoordinates] : glm::vec2(0.0f),
+                materialIndex
             });
-        }
 
-        for (int i = 1; i < face.vertexIndices.size() - 1; ++i)
-        {
-            indices.push_back(baseIndex);
-            indices.push_back(baseIndex + i);
-            indices.push_back(baseIndex + i + 1);
+            if (i == 0)
+                fanStartIndex = index;
+            else if (i >= 2)
+            {
+                indices.push_back(fanStartIndex);
+                indices.push_back(previousIndex);
+                indices.push_back(index);
+            }
+
+            previousIndex = index;
         }
     }
 
-    mMesh.SetupMesh(vertices, indices);
+    modelData.vertices = std::move(welder.vertices);
+    modelData.cornerCount = static_cast<unsigned int>(data.corners.size());
+    OptimizeForGpu(modelData);
+
+    return modelData;
+}
+
+Geometry::ModelData Geometry::Model::ImportGlb(const char* path)
+{
+    // Already indexed, so there is nothing to weld
+    ModelData modelData = GlbImporter::Read(path);
+    OptimizeForGpu(modelData);
+
+    return modelData;
+}
+
+Geometry::ModelData Geometry::Model::Import(const char* path)
+{
+    std::string_view extension = path;
+    extension = extension.substr(std::min(extension.find_last_of('.'), extension.size()));
+    bool isGlb = extension.size() == 4 && std::equal(extension.begin(), extension.end(), ".glb", [](const char a, const char b)
+    {
+        return std::tolower(static_cast<unsigned char>(a)) == b;
+    });
+
+    return isGlb ? ImportGlb(path) : ImportObj(path);
+}
+
+void Geometry::Model::OptimizeForGpu(ModelData& modelData)
+{
+    std::vector<unsigned int>& indices = modelData.indices;
+
+    /*
+     * Reorder triangles and vertices for the GPU, the mesh cache stores the optimized order
+     */
+    modelData.importedCacheStatistics = MeshOptimization::AnalyzeVertexCache(indices, modelData.vertices.size());
+    MeshOptimization::Optimize(modelData.vertices, indices);
+    VertexQuantization::SortByMaterial(modelData.vertices, indices);
+    modelData.optimizedCacheStatistics = MeshOptimization::AnalyzeVertexCache(indices, modelData.vertices.size());
+
+    // Coarser levels go after level 0 in the same index buffer and reuse its vertices
+    modelData.lods = MeshSimplification::GenerateLods(modelData.vertices, indices);
 }
 
-void Geometry::Model::Draw(const Shading::ShaderProgram* shaderProgram) const
+void Geometry::Model::Draw(const Shading::ShaderProgram* shaderProgram)
 {
     glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
     model = glm::scale(model, scale);
     shaderProgram->SetMat4("model", model);
+    shaderProgram->SetInt("materialOffset", static_cast<int>(mMaterialOffset));
+    SetVertexFormatUniforms(shaderProgram);
+
+    if (mTextureStreamer != nullptr)
+        mTextureStreamer->RecordDraw(mStreamedTextures, model, mMesh->boundsCenter, mMesh->boundsRadius, mMesh->texelDensity);
+
+    const std::vector<MeshLod>& lods = mMesh->lods;
+    if (mLodSelector != nullptr)
+    {
+        float modelScale = std::max({ std::abs(scale.x), std::abs(scale.y), std::abs(scale.z) });
+        glm::vec3 center = glm::vec3(model * glm::vec4(mMesh->boundsCenter, 1.0f));
+        mLodLevel = mLodSelector->SelectLevel(lods, center, mMesh->boundsRadius * modelScale, modelScale, mLodLevel);
+        mLodSelector->RecordSubmission(lods[mLodLevel].indexCount / 3, lods[0].indexCount / 3);
+    }
+    else
+        mLodLevel = 0;
+
+    glBindVertexArray(mMesh->VAO);
+
+    // Meshlets cover level 0 only, coarser levels are small enough to draw whole
+    if (mClusterCuller != nullptr && !mMesh->meshlets.empty() && mLodLevel == 0)
+    {
+        const ClusterDrawList& drawList = mClusterCuller->BuildDrawList(mMesh->meshlets, mMesh->meshletBounds, model);
+        mMesh->DrawRanges(drawList.firstIndices, drawList.counts);
+    }
+    else
+        mMesh->DrawRange(lods[mLodLevel].firstIndex, lods[mLodLevel].indexCount);
 
-    glBindVertexArray(mMesh.VAO);
-    glDrawElements(GL_TRIANGLES, mMesh.indices.size(), GL_UNSIGNED_INT, nullptr);
     glBindVertexArray(0);
 }
 
+void Geometry::Model::SetTextureStreaming(Assets::TextureStreamer* textureStreamer, std::vector<unsigned int> textures)
+{
+    mTextureStreamer = textureStreamer;
+    mStreamedTextures = std::move(textures);
+}
+
+void Geometry::Model::SetClusterCulling(ClusterCuller* clusterCuller)
+{
+    mClusterCuller = clusterCuller;
+}
+
+void Geometry::Model::SetLodSelection(LodSelector* lodSelector)
+{
+    mLodSelector = lodSelector;
+}
+
+void Geometry::Model::SetOnLastCopyDestroyed(std::function<void()> onDestroyed)
+{
+    mLastCopyCallback = std::make_shared<LastCopyCallback>(std::move(onDestroyed));
+}
+
+unsigned int Geometry::Model::GetVertexCount() const
+{
+    return mMesh->vertexCount;
+}
+
+std::shared_ptr<Geometry::Mesh> Geometry::Model::GetMesh() const
+{
+    return mMesh;
+}
+
+unsigned int Geometry::Model::GetCornerCount() const
+{
+    return mCornerCount;
+}
+
 void Geometry::Model::SetupInstancing(const int amount, const glm::mat4* modelMatrices)
 {
-    unsigned int buffer;
-    glGenBuffers(1, &buffer);
-    glBindBuffer(GL_ARRAY_BUFFER, buffer);
-    glBufferData(GL_ARRAY_BUFFER, amount * sizeof(glm::mat4), &modelMatrices[0], GL_STATIC_DRAW);
+    mInstanceMatrices.assign(modelMatrices, modelMatrices + amount);
+    mInstanceBounds.resize(amount);
+    mInstanceScales.resize(amount);
+    for (int i = 0; i < amount; ++i)
+    {
+        const glm::mat4& matrix = modelMatrices[i];
+        mInstanceScales[i] = std::sqrt(std::max({ glm::dot(glm::vec3(matrix[0]), glm::vec3(matrix[0])),
+                                                  glm::dot(glm::vec3(matrix[1]), glm::vec3(matrix[1])),
+                                                  glm::dot(glm::vec3(matrix[2]), glm::vec3(matrix[2])) }));
+        mInstanceBounds[i] = glm::vec4(glm::vec3(matrix * glm::vec4(mMesh->boundsCenter, 1.0f)), mMesh->boundsRadius * mInstanceScales[i]);
+    }
+
+    // Every instance starts at level 0, in the order it was given
+    mInstanceLevels.assign(amount, 0);
+    mLevelInstanceCounts.assign(1, amount);
+
+    glGenBuffers(1, &mInstanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, amount * sizeof(glm::mat4), &modelMatrices[0], GL_DYNAMIC_DRAW);
 
-    glBindVertexArray(mMesh.VAO);
+    glBindVertexArray(mMesh->VAO);
     std::size_t vec4Size = sizeof(glm::vec4);
     glEnableVertexAttribArray(4);
     glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, 4 * vec4Size, nullptr);
@@ -132,7 +285,7 @@ void Geometry::Model::SetupInstancing(const int amount, const glm::mat4* modelMa
     mInstanceAmount = amount;
 }
 
-void Geometry::Model::DrawInstanced() const
+void Geometry::Model::DrawInstanced(const Shading::ShaderProgram* shaderProgram)
 {
     if (!mIsInstancingEnabled)
     {
@@ -140,70 +293,160 @@ void Geometry::Model::DrawInstanced() const
         return;
     }
 
-    glBindVertexArray(mMesh.VAO);
-    glDrawElementsInstanced(GL_TRIANGLES, mMesh.indices.size(), GL_UNSIGNED_INT, nullptr, mInstanceAmount);
+    shaderProgram->SetInt("materialOffset", static_cast<int>(mMaterialOffset));
+    SetVertexFormatUniforms(shaderProgram);
+
+    // Instances are spread over the scene without a shared transform, so their textures stay fully resident
+    if (mTextureStreamer != nullptr)
+        mTextureStreamer->RecordFullResolution(mStreamedTextures);
+
+    if (mLodSelector != nullptr && mMesh->lods.size() > 1)
+        UpdateInstanceLevels();
+
+    /*
+     * One instanced draw per level. Without base instances in OpenGL 3.3 each level's instances are reached by
+     * pointing the matrix attributes at the level's first matrix
+     */
+    glBindVertexArray(mMesh->VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+
+    std::size_t firstInstance = 0, submittedTriangles = 0;
+    for (std::size_t level = 0; level < mLevelInstanceCounts.size(); ++level)
+    {
+        unsigned int instanceCount = mLevelInstanceCounts[level];
+        if (instanceCount == 0)
+            continue;
+
+        for (unsigned int column = 0; column < 4; ++column)
+        {
+            std::uintptr_t offset = firstInstance * sizeof(glm::mat4) + column * sizeof(glm::vec4);
+            glVertexAttribPointer(4 + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), reinterpret_cast<void*>(offset));
+        }
+
+        const MeshLod& lod = mMesh->lods[std::min(level, mMesh->lods.size() - 1)];
+        mMesh->DrawRange(lod.firstIndex, lod.indexCount, static_cast<int>(instanceCount));
+
+        firstInstance += instanceCount;
+        submittedTriangles += static_cast<std::size_t>(lod.indexCount / 3) * instanceCount;
+    }
+
     glBindVertexArray(0);
+
+    if (mLodSelector != nullptr)
+        mLodSelector->RecordSubmission(submittedTriangles, static_cast<std::size_t>(mMesh->lods[0].indexCount / 3) * mInstanceAmount);
 }
 
-std::vector<Geometry::Material> Geometry::Model::ReadMaterialFile(std::stringstream &objLineStream, const char *objPath) const
+void Geometry::Model::SetVertexFormatUniforms(const Shading::ShaderProgram* shaderProgram) const
 {
-    std::string fileName;
-    std::string path = objPath;
-    path = path.substr(0, path.find_last_of('/') + 1);
+    // Set on every draw, the uniforms stay in the program for the next model drawn with it
+    bool isQuantized = mMesh->vertexFormat == VertexFormat::Quantized;
+    shaderProgram->SetBool("isVertexQuantized", isQuantized);
+    if (!isQuantized)
+        return;
 
-    objLineStream >> fileName;
-    path += fileName;
+    shaderProgram->SetVec3("positionOffset", mMesh->positionQuantization.offset);
+    shaderProgram->SetVec3("positionScale", mMesh->positionQuantization.scale);
 
-    std::ifstream material;
-    material.exceptions(std::ifstream::badbit);
+    std::array<glm::ivec2, VertexQuantization::MAX_MATERIAL_RANGES> materialRanges;
+    std::size_t rangeCount = std::min(mMesh->materialRanges.size(), materialRanges.size());
+    for (std::size_t i = 0; i < rangeCount; ++i)
+        materialRanges[i] = glm::ivec2(mMesh->materialRanges[i].firstVertex, mMesh->materialRanges[i].materialIndex);
 
-    try
-    {
-        material.open(path);
-    }
-    catch (std::ifstream::failure& exception)
+    shaderProgram->SetInt("materialRangeCount", static_cast<int>(rangeCount));
+    if (rangeCount > 0)
+        shaderProgram->SetIVec2Array("materialRanges", std::span(materialRanges.data(), rangeCount));
+}
+
+void Geometry::Model::UpdateInstanceLevels()
+{
+    constexpr std::size_t INSTANCES_PER_TASK = 8192;
+    const std::vector<MeshLod>& lods = mMesh->lods;
+
+    // Levels only move when an instance's error crosses the hysteresis band, so a still camera changes nothing
+    std::atomic<bool> hasChanged = false;
+    std::size_t taskCount = (mInstanceAmount + INSTANCES_PER_TASK - 1) / INSTANCES_PER_TASK;
+    Utility::ThreadPool::GetShared().ParallelFor(taskCount, [this, &lods, &hasChanged](const std::size_t task)
     {
+        std::size_t end = std::min<std::size_t>((task + 1) * INSTANCES_PER_TASK, mInstanceAmount);
+        for (std::size_t i = task * INSTANCES_PER_TASK; i < end; ++i)
+        {
+            const glm::vec4& bounds = mInstanceBounds[i];
+            unsigned int level = mLodSelector->SelectLevel(lods, glm::vec3(bounds), bounds.w, mInstanceScales[i], mInstanceLevels[i]);
+            if (level != mInstanceLevels[i])
+            {
+                mInstanceLevels[i] = static_cast<unsigned char>(level);
+                hasChanged.store(true, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    if (!hasChanged && mLevelInstanceCounts.size() == lods.size())
+        return;
+
+    /*
+     * Counting sort of the matrices by level, then one upload of the whole buffer
+     */
+    mLevelInstanceCounts.assign(lods.size(), 0);
+    for (unsigned char level : mInstanceLevels)
+        ++mLevelInstanceCounts[level];
+
+    std::vector<unsigned int> levelOffsets(lods.size(), 0);
+    for (std::size_t level = 1; level < lods.size(); ++level)
+        levelOffsets[level] = levelOffsets[level - 1] + mLevelInstanceCounts[level - 1];
+
+    mSortedInstanceMatrices.resize(mInstanceMatrices.size());
+    for (std::size_t i = 0; i < mInstanceMatrices.size(); ++i)
+        mSortedInstanceMatrices[levelOffsets[mInstanceLevels[i]]++] = mInstanceMatrices[i];
+
+    glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(mSortedInstanceMatrices.size() * sizeof(glm::mat4)),
+                    mSortedInstanceMatrices.data());
+}
+
+std::vector<Geometry::Material> Geometry::Model::ReadMaterialFile(const std::string& path, const char *objPath)
+{
+    Assets::AssetFile material(path);
+    if (!material.IsOpen())
         std::cout << "ERROR::ASSET::MTL_FILE_NOT_SUCCESSFULLY_READ" << std::endl;
-    }
 
-    std::string currentLine;
+    std::string_view source = material.View();
+    std::string_view line;
     int currentMaterial = -1;
     std::vector<Material> materials;
 
-    while (material.is_open() && !material.eof())
+    while (ObjParser::ReadLine(source, line))
     {
-        std::getline(material, currentLine);
-        if (currentLine.empty() || currentLine[0] == '#')
+        std::string_view lineWord = ObjParser::ReadWordFromLine(line);
+        if (lineWord.empty() || lineWord[0] == '#')
             continue;
 
-        std::stringstream lineStream (currentLine);
-        std::string lineWord;
-        lineStream >> lineWord;
-
         if (lineWord == "newmtl")
         {
-            lineStream >> lineWord;
-            materials.push_back({ lineWord, mModelIndex });
+            Material material {};
+            material.name = std::string(ObjParser::ReadWordFromLine(line));
+            materials.push_back(std::move(material));
             ++currentMaterial;
         }
+        else if (currentMaterial < 0)
+            continue;
         else if (lineWord == "Ns")
-            materials[currentMaterial].shininess = ReadFloatFromLine(lineStream);
+            materials[currentMaterial].shininess = ObjParser::ReadFloatFromLine(line);
         else if (lineWord == "Ka")
-            materials[currentMaterial].ambientColor = ReadVec3FromLine(lineStream);
+            materials[currentMaterial].ambientColor = ObjParser::ReadVec3FromLine(line);
         else if (lineWord == "Kd")
-            materials[currentMaterial].diffuseColor = ReadVec3FromLine(lineStream);
+            materials[currentMaterial].diffuseColor = ObjParser::ReadVec3FromLine(line);
         else if (lineWord == "Ks")
-            materials[currentMaterial].specularColor = ReadVec3FromLine(lineStream);
+            materials[currentMaterial].specularColor = ObjParser::ReadVec3FromLine(line);
         else if (lineWord == "Ke")
-            materials[currentMaterial].emissiveColor = ReadVec3FromLine(lineStream);
+            materials[currentMaterial].emissiveColor = ObjParser::ReadVec3FromLine(line);
         else if (lineWord == "map_Kd")
         {
-            materials[currentMaterial].diffuseMap = ReadTextureFromLine(lineStream, objPath, true);
+            materials[currentMaterial].diffuseMapPath = ReadTexturePathFromLine(line, objPath);
             materials[currentMaterial].hasDiffuseMap = true;
         }
         else if (lineWord == "map_Ks")
         {
-            materials[currentMaterial].specularMap = ReadTextureFromLine(lineStream, objPath, false);
+            materials[currentMaterial].specularMapPath = ReadTexturePathFromLine(line, objPath);
             materials[currentMaterial].hasSpecularMap = true;
         }
     }
@@ -211,93 +454,16 @@ std::vector<Geometry::Material> Geometry::Model::ReadMaterialFile(std::stringstr
     return materials;
 }
 
-unsigned int Geometry::Model::ReadTextureFromLine(std::stringstream &mtlLineStream, const char *objPath, const bool &isDiffuse)
-{
-    std::string fileName;
-    std::string path = objPath;
-    path = path.substr(0, path.find_last_of('/') + 1);
-
-    mtlLineStream >> fileName;
-    path += fileName;
-
-    return Assets::LoadTexture(path, isDiffuse);
-}
-
-Geometry::Face Geometry::Model::ReadFaceFromLine(std::stringstream &lineStream, std::string materialName)
+std::string Geometry::Model::ReadTexturePathFromLine(std::string_view &mtlLine, const char *objPath)
 {
-    Face newFace;
-    newFace.materialName = std::move(materialName);
-    std::string lineWord;
-
-    while (!lineStream.eof())
-    {
-        lineStream >> lineWord;
-        std::stringstream wordStream(lineWord);
-
-        unsigned int values[3];
-        for (int i = 0; i < 3 && !wordStream.eof(); ++i)
-        {
-            std::getline(wordStream, lineWord, '/');
-            if (!lineWord.empty())
-                values[i] = std::stoi(lineWord);
-        }
-
-        newFace.vertexIndices.push_back(values[0]);
-        newFace.textureCoordinateIndices.push_back(values[1]);
-        newFace.normalIndices.push_back(values[2]);
-    }
-
-    return newFace;
-}
-
-float Geometry::Model::ReadFloatFromLine(std::stringstream &lineStream)
-{
-    std::string lineWord;
-    lineStream >> lineWord;
-
-    return std::stof(lineWord);
+    return GetSiblingPath(objPath, ObjParser::ReadWordFromLine(mtlLine));
 }
 
-glm::vec2 Geometry::Model::ReadVec2FromLine(std::stringstream &lineStream)
+std::string Geometry::Model::GetSiblingPath(const char* objPath, const std::string_view fileName)
 {
-    glm::vec2 newVector;
-    std::string lineWord;
-
-    lineStream >> lineWord;
-    newVector.x = std::stof(lineWord);
-    lineStream >> lineWord;
-    newVector.y = std::stof(lineWord);
-
-    return newVector;
-}
-
-glm::vec3 Geometry::Model::ReadVec3FromLine(std::stringstream& lineStream)
-{
-    glm::vec3 newVector;
-    std::string lineWord;
-
-    lineStream >> lineWord;
-    newVector.x = std::stof(lineWord);
-    lineStream >> lineWord;
-    newVector.y = std::stof(lineWord);
-    lineStream >> lineWord;
-    newVector.z = std::stof(lineWord);
-
-    return newVector;
-}
-
-int Geometry::Model::GetMaterialIndex(const std::string& name, const std::vector<Material> &materials) const
-{
-    int result = -1;
-
-    for (int i = 0; i < materials.size(); ++i)
-    {
-        if (materials[i].name == name && materials[i].modelIndex == mModelIndex)
-        {
-            result = i;
-            break;
-        }
-    }
+    std::string path = objPath;
+    path = path.substr(0, path.find_last_of('/') + 1);
+    path += fileName;
 
-    return result;
+    return path;
 }
@@ -1,34 +1,120 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
 #include "mesh.h"
+#include "mesh_optimization.h"
+
+namespace Assets
+{
+    class TextureStreamer;
+}
 
 namespace Geometry
 {
+    class ClusterCuller;
+    class LodSelector;
+
+    // CPU-side result of importing a model file, vertex material indices are local to materials
+    struct ModelData
+    {
+        std::vector<Vertex> vertices;
+        // Every level of detail back to back, lods holds their ranges
+        std::vector<unsigned int> indices;
+        std::vector<MeshLod> lods;
+        std::vector<Material> materials;
+        std::vector<std::string> materialFiles;
+        unsigned int cornerCount = 0;
+        // Vertex cache behaviour of the imported order and of the order after MeshOptimization
+        VertexCacheStatistics importedCacheStatistics {};
+        VertexCacheStatistics optimizedCacheStatistics {};
+    };
+
     class Model {
     public:
-        explicit Model(const char* path, std::vector<Material>* materials, unsigned int modelIndex);
+        Model(std::span<const Vertex> vertices, std::span<const unsigned int> indices, std::span<const MeshLod> lods,
+              unsigned int cornerCount, unsigned int materialOffset, VertexFormat vertexFormat = VertexFormat::Full);
 
-        void Draw(const Shading::ShaderProgram* shaderProgram) const;
+        // Picks the importer by extension, .glb files are binary glTF and everything else is read as OBJ
+        static ModelData Import(const char* path);
+        static ModelData ImportObj(const char* path);
+        static ModelData ImportGlb(const char* path);
+
+        // Draws keep the level of detail they chose last, which is what the selector's hysteresis starts from
+        void Draw(const Shading::ShaderProgram* shaderProgram);
 
         void SetupInstancing(int amount, const glm::mat4* modelMatrices);
-        void DrawInstanced() const;
+        void DrawInstanced(const Shading::ShaderProgram* shaderProgram);
+
+        // Draws report the footprint of these textures to the streamer from then on
+        void SetTextureStreaming(Assets::TextureStreamer* textureStreamer, std::vector<unsigned int> textures);
+        // Draws skip the mesh's meshlets the culler rejects from then on, the mesh needs meshlets built
+        void SetClusterCulling(ClusterCuller* clusterCuller);
+        // Draws pick a level of detail through the selector from then on, otherwise they draw level 0
+        void SetLodSelection(LodSelector* lodSelector);
+        // Runs once the last copy of the model is destroyed, to release what its loader acquired for it
+        void SetOnLastCopyDestroyed(std::function<void()> onDestroyed);
+
+        // Copies of a model share one mesh, so reloading its buffers in place reaches every copy
+        std::shared_ptr<Mesh> GetMesh() const;
+        unsigned int GetVertexCount() const;
+        // Number of face corners in the source file, i.e. the vertex count without welding
+        unsigned int GetCornerCount() const;
 
         glm::vec3 position;
         glm::vec3 scale;
 
     private:
-        static unsigned int             ReadTextureFromLine(std::stringstream& mtlLineStream, const char* objPath, const bool &isDiffuse);
-        static Face                     ReadFaceFromLine(std::stringstream& lineStream, std::string materialName);
-        static float                    ReadFloatFromLine(std::stringstream& lineStream);
-        static glm::vec2                ReadVec2FromLine(std::stringstream& lineStream);
-        static glm::vec3                ReadVec3FromLine(std::stringstream& lineStream);
+        // Shared by every copy, calls onDestroyed when the last one lets go of it
+        struct LastCopyCallback
+        {
+            std::function<void()> onDestroyed;
+
+            ~LastCopyCallback();
+        };
 
-        std::vector<Material>    ReadMaterialFile(std::stringstream &objLineStream, const char *objPath) const;
-        int                      GetMaterialIndex(const std::string& name, const std::vector<Material> &materials) const;
+        static std::string              ReadTexturePathFromLine(std::string_view& mtlLine, const char* objPath);
+        static std::string              GetSiblingPath(const char* objPath, std::string_view fileName);
+        static std::vector<Material>    ReadMaterialFile(const std::string& path, const char* objPath);
+        // Vertex cache, material sort and level of detail passes every importer ends with
+        static void                     OptimizeForGpu(ModelData& modelData);
+
+        // Tells the vertex shader whether and how to decode quantized vertices
+        void SetVertexFormatUniforms(const Shading::ShaderProgram* shaderProgram) const;
+        // Regroups the instance buffer by level when any instance changed level
+        void UpdateInstanceLevels();
 
-        Mesh mMesh;
         bool mIsInstancingEnabled = false;
         unsigned int mInstanceAmount;
-        unsigned int mModelIndex;
+        unsigned int mCornerCount;
+        // Position of this model's first material in the shared material list
+        unsigned int mMaterialOffset;
+        std::shared_ptr<Mesh> mMesh;
+
+        Assets::TextureStreamer* mTextureStreamer = nullptr;
+        std::vector<unsigned int> mStreamedTextures;
+
+        ClusterCuller* mClusterCuller = nullptr;
+
+        LodSelector* mLodSelector = nullptr;
+        unsigned int mLodLevel = 0;
+
+        std::shared_ptr<LastCopyCallback> mLastCopyCallback;
+
+        /*
+         * Instances sorted by level of detail, each level is drawn from its own offset into the instance buffer
+         */
+        unsigned int mInstanceBuffer = 0;
+        std::vector<glm::mat4> mInstanceMatrices;
+        // World space bounding sphere of every instance with the radius in w, and the largest scale of its matrix
+        std::vector<glm::vec4> mInstanceBounds;
+        std::vector<float> mInstanceScales;
+        std::vector<unsigned char> mInstanceLevels;
+        std::vector<glm::mat4> mSortedInstanceMatrices;
+        std::vector<unsigned int> mLevelInstanceCounts;
     };
 }
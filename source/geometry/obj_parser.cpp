@@ -0,0 +1,324 @@
+#include "obj_parser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#include "../utility/thread_pool.h"
+
+namespace
+{
+    enum ObjAttribute
+    {
+        Position,
+        TextureCoordinates,
+        Normal
+    };
+
+    // Negative OBJ indices count back from the attributes read so far, which a chunk only knows locally
+    struct RelativeIndex
+    {
+        unsigned int corner;
+        ObjAttribute attribute;
+    };
+
+    struct ObjChunk
+    {
+        Geometry::ObjData data;
+        std::vector<RelativeIndex> relativeIndices;
+    };
+
+    bool IsSpace(const char character)
+    {
+        return character == ' ' || character == '\t' || character == '\r';
+    }
+
+    int& GetAttributeIndex(Geometry::ObjCorner& corner, const ObjAttribute attribute)
+    {
+        switch (attribute)
+        {
+            case Position:              return corner.position;
+            case TextureCoordinates:    return corner.textureCoordinates;
+            default:                    return corner.normal;
+        }
+    }
+
+    // Converts a 1-based OBJ index into a zero-based one, -1 if missing or invalid. Relative indices are
+    // resolved against attributeCount and may stay negative until the chunk's global offset is known
+    int ReadIndex(const char*& cursor, const char* end, const int attributeCount, bool& isRelative)
+    {
+        isRelative = false;
+        if (cursor == end || *cursor == '/')
+            return -1;
+
+        int value = 0;
+        auto [next, error] = std::from_chars(cursor, end, value);
+        cursor = next;
+
+        if (error != std::errc() || value == 0)
+            return -1;
+
+        isRelative = value < 0;
+        return value > 0 ? value - 1 : attributeCount + value;
+    }
+
+    void ReadFace(std::string_view& line, Geometry::ObjData& data, std::vector<RelativeIndex>* relativeIndices)
+    {
+        const int attributeCounts[] = {
+            static_cast<int>(data.positions.size()),
+            static_cast<int>(data.textureCoordinates.size()),
+            static_cast<int>(data.normals.size())
+        };
+
+        for (std::string_view word = Geometry::ObjParser::ReadWordFromLine(line); !word.empty();
+             word = Geometry::ObjParser::ReadWordFromLine(line))
+        {
+            const char* cursor = word.data();
+            const char* end = word.data() + word.size();
+            Geometry::ObjCorner corner { -1, -1, -1 };
+
+            for (int attribute = Position; attribute <= Normal; ++attribute)
+            {
+                if (attribute != Position)
+                {
+                    if (cursor == end || *cursor != '/')
+                        break;
+                    ++cursor;
+                }
+
+                bool isRelative;
+                int& index = GetAttributeIndex(corner, static_cast<ObjAttribute>(attribute));
+                index = ReadIndex(cursor, end, attributeCounts[attribute], isRelative);
+
+                if (isRelative && relativeIndices != nullptr)
+                    relativeIndices->push_back({ static_cast<unsigned int>(data.corners.size()), static_cast<ObjAttribute>(attribute) });
+                else if (index < 0)
+                    index = -1;
+            }
+
+            data.corners.push_back(corner);
+        }
+
+        data.faceOffsets.push_back(static_cast<unsigned int>(data.corners.size()));
+    }
+
+    void ParseChunk(std::string_view source, ObjChunk& chunk)
+    {
+        Geometry::ObjData& data = chunk.data;
+        data.faceOffsets.push_back(0);
+
+        std::string_view line;
+        while (Geometry::ObjParser::ReadLine(source, line))
+        {
+            std::string_view keyword = Geometry::ObjParser::ReadWordFromLine(line);
+            if (keyword.empty() || keyword[0] == '#')
+                continue;
+
+            if (keyword == "v")
+                data.positions.push_back(Geometry::ObjParser::ReadVec3FromLine(line));
+            else if (keyword == "vt")
+                data.textureCoordinates.push_back(Geometry::ObjParser::ReadVec2FromLine(line));
+            else if (keyword == "vn")
+                data.normals.push_back(Geometry::ObjParser::ReadVec3FromLine(line));
+            else if (keyword == "f")
+                ReadFace(line, data, &chunk.relativeIndices);
+            else if (keyword == "usemtl")
+                data.materialGroups.push_back({ std::string(Geometry::ObjParser::ReadWordFromLine(line)), data.GetFaceCount() });
+            else if (keyword == "mtllib")
+                data.materialLibraries.emplace_back(Geometry::ObjParser::ReadWordFromLine(line));
+        }
+    }
+
+    void OffsetRelativeIndices(Geometry::ObjCorner* corners, const std::vector<RelativeIndex>& relativeIndices,
+                               const int positionOffset, const int textureCoordinateOffset, const int normalOffset)
+    {
+        const int offsets[] = { positionOffset, textureCoordinateOffset, normalOffset };
+
+        for (const RelativeIndex& relativeIndex : relativeIndices)
+        {
+            int& index = GetAttributeIndex(corners[relativeIndex.corner], relativeIndex.attribute);
+            index += offsets[relativeIndex.attribute];
+            if (index < 0)
+                index = -1;
+        }
+    }
+
+    // Splits source into roughly equal pieces that all start at the beginning of a line
+    std::vector<std::string_view> SplitAtLines(const std::string_view source, const std::size_t chunkCount)
+    {
+        std::vector<std::string_view> chunks;
+        std::size_t chunkStart = 0;
+
+        for (std::size_t i = 1; i <= chunkCount && chunkStart < source.size(); ++i)
+        {
+            std::size_t chunkEnd = source.size();
+            if (i < chunkCount)
+            {
+                chunkEnd = std::max(chunkStart, source.size() * i / chunkCount);
+                chunkEnd = source.find('\n', chunkEnd);
+                chunkEnd = chunkEnd == std::string_view::npos ? source.size() : chunkEnd + 1;
+            }
+
+            chunks.push_back(source.substr(chunkStart, chunkEnd - chunkStart));
+            chunkStart = chunkEnd;
+        }
+
+        return chunks;
+    }
+}
+
+unsigned int Geometry::ObjData::GetFaceCount() const
+{
+    return faceOffsets.empty() ? 0 : static_cast<unsigned int>(faceOffsets.size() - 1);
+}
+
+Geometry::ObjData Geometry::ObjParser::Parse(std::string_view source)
+{
+    ObjChunk chunk;
+    ParseChunk(source, chunk);
+    OffsetRelativeIndices(chunk.data.corners.data(), chunk.relativeIndices, 0, 0, 0);
+
+    return std::move(chunk.data);
+}
+
+Geometry::ObjData Geometry::ObjParser::ParseParallel(std::string_view source, Utility::ThreadPool& threadPool, std::size_t chunkCount)
+{
+    chunkCount = std::min(chunkCount, source.size() / MIN_CHUNK_SIZE);
+    if (chunkCount <= 1)
+        return Parse(source);
+
+    std::vector<std::string_view> chunkSources = SplitAtLines(source, chunkCount);
+    std::vector<ObjChunk> chunks(chunkSources.size());
+
+    threadPool.ParallelFor(chunks.size(), [&](const std::size_t i)
+    {
+        ParseChunk(chunkSources[i], chunks[i]);
+    });
+
+    /*
+     * Prefix sums give every chunk its place in the merged arrays
+     */
+    struct ChunkOffsets
+    {
+        std::size_t positions, textureCoordinates, normals, corners, faces;
+    };
+
+    std::vector<ChunkOffsets> offsets(chunks.size() + 1, ChunkOffsets {});
+    for (std::size_t i = 0; i < chunks.size(); ++i)
+    {
+        const ObjData& chunkData = chunks[i].data;
+        offsets[i + 1] = {
+            offsets[i].positions + chunkData.positions.size(),
+            offsets[i].textureCoordinates + chunkData.textureCoordinates.size(),
+            offsets[i].normals + chunkData.normals.size(),
+            offsets[i].corners + chunkData.corners.size(),
+            offsets[i].faces + chunkData.GetFaceCount()
+        };
+    }
+
+    const ChunkOffsets& totals = offsets.back();
+    ObjData data;
+    data.positions.resize(totals.positions);
+    data.textureCoordinates.resize(totals.textureCoordinates);
+    data.normals.resize(totals.normals);
+    data.corners.resize(totals.corners);
+    data.faceOffsets.resize(totals.faces + 1);
+    data.faceOffsets[0] = 0;
+
+    threadPool.ParallelFor(chunks.size(), [&](const std::size_t i)
+    {
+        const ObjChunk& chunk = chunks[i];
+        const ChunkOffsets& offset = offsets[i];
+
+        std::copy(chunk.data.positions.begin(), chunk.data.positions.end(), data.positions.begin() + offset.positions);
+        std::copy(chunk.data.textureCoordinates.begin(), chunk.data.textureCoordinates.end(), data.textureCoordinates.begin() + offset.textureCoordinates);
+        std::copy(chunk.data.normals.begin(), chunk.data.normals.end(), data.normals.begin() + offset.normals);
+        std::copy(chunk.data.corners.begin(), chunk.data.corners.end(), data.corners.begin() + offset.corners);
+
+        OffsetRelativeIndices(data.corners.data() + offset.corners, chunk.relativeIndices,
+            static_cast<int>(offset.positions), static_cast<int>(offset.textureCoordinates), static_cast<int>(offset.normals));
+
+        for (unsigned int face = 1; face <= chunk.data.GetFaceCount(); ++face)
+            data.faceOffsets[offset.faces + face] = chunk.data.faceOffsets[face] + static_cast<unsigned int>(offset.corners);
+    });
+
+    for (std::size_t i = 0; i < chunks.size(); ++i)
+    {
+        for (ObjMaterialGroup& group : chunks[i].data.materialGroups)
+        {
+            group.firstFace += static_cast<unsigned int>(offsets[i].faces);
+            data.materialGroups.push_back(std::move(group));
+        }
+
+        for (std::string& materialLibrary : chunks[i].data.materialLibraries)
+            data.materialLibraries.push_back(std::move(materialLibrary));
+    }
+
+    return data;
+}
+
+bool Geometry::ObjParser::ReadLine(std::string_view& source, std::string_view& line)
+{
+    if (source.empty())
+        return false;
+
+    const void* newline = std::memchr(source.data(), '\n', source.size());
+    std::size_t lineLength = newline != nullptr ? static_cast<const char*>(newline) - source.data() : source.size();
+
+    line = source.substr(0, lineLength);
+    source.remove_prefix(lineLength < source.size() ? lineLength + 1 : lineLength);
+
+    return true;
+}
+
+std::string_view Geometry::ObjParser::ReadWordFromLine(std::string_view& line)
+{
+    std::size_t start = 0;
+    while (start < line.size() && IsSpace(line[start]))
+        ++start;
+
+    std::size_t end = start;
+    while (end < line.size() && !IsSpace(line[end]))
+        ++end;
+
+    std::string_view word = line.substr(start, end - start);
+    line.remove_prefix(end);
+
+    return word;
+}
+
+float Geometry::ObjParser::ReadFloatFromLine(std::string_view& line)
+{
+    std::string_view word = ReadWordFromLine(line);
+    if (!word.empty() && word[0] == '+')
+        word.remove_prefix(1);
+
+    float value = 0.0f;
+    std::from_chars(word.data(), word.data() + word.size(), value);
+
+    return value;
+}
+
+glm::vec2 Geometry::ObjParser::ReadVec2FromLine(std::string_view& line)
+{
+    glm::vec2 newVector;
+    newVector.x = ReadFloatFromLine(line);
+    newVector.y = ReadFloatFromLine(line);
+
+    return newVector;
+}
+
+glm::vec3 Geometry::ObjParser::ReadVec3FromLine(std::string_view& line)
+{
+    glm::vec3 newVector;
+    newVector.x = ReadFloatFromLine(line);
+    newVector.y = ReadFloatFromLine(line);
+    newVector.z = ReadFloatFromLine(line);
+
+    return newVector;
+}
+
+void Geometry::ObjParser::ReadFaceFromLine(std::string_view& line, ObjData& data)
+{
+    ReadFace(line, data, nullptr);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Utility
+{
+    class ThreadPool;
+}
+
+namespace Geometry
+{
+    // Zero-based attribute indices of a single face corner, -1 when the attribute is absent
+    struct ObjCorner
+    {
+        int position;
+        int textureCoordinates;
+        int normal;
+    };
+
+    struct ObjMaterialGroup
+    {
+        std::string materialName;
+        unsigned int firstFace;
+    };
+
+    struct ObjData
+    {
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec3> normals;
+        std::vector<glm::vec2> textureCoordinates;
+
+        // Face i owns corners [faceOffsets[i], faceOffsets[i + 1])
+        std::vector<ObjCorner> corners;
+        std::vector<unsigned int> faceOffsets;
+
+        std::vector<ObjMaterialGroup> materialGroups;
+        std::vector<std::string> materialLibraries;
+
+        unsigned int GetFaceCount() const;
+    };
+
+    // In-place OBJ/MTL tokenizer working directly on the file bytes, no per-line allocations
+    namespace ObjParser
+    {
+        // Files are only split when every chunk gets at least this many bytes
+        constexpr std::size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+        ObjData Parse(std::string_view source);
+        // Parses line-aligned chunks concurrently and merges them, the result is identical to Parse
+        ObjData ParseParallel(std::string_view source, Utility::ThreadPool& threadPool, std::size_t chunkCount);
+
+        bool                ReadLine(std::string_view& source, std::string_view& line);
+        std::string_view    ReadWordFromLine(std::string_view& line);
+        float               ReadFloatFromLine(std::string_view& line);
+        glm::vec2           ReadVec2FromLine(std::string_view& line);
+        glm::vec3           ReadVec3FromLine(std::string_view& line);
+        void                ReadFaceFromLine(std::string_view& line, ObjData& data);
+    }
+}
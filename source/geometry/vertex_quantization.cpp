@@ -0,0 +1,181 @@
+#include "vertex_quantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include <glm/gtc/packing.hpp>
+
+namespace
+{
+    constexpr float UNSIGNED_SHORT_MAX = 65535.0f;
+    constexpr float SHORT_MAX = 32767.0f;
+
+    std::int16_t PackSnorm16(const float value)
+    {
+        return static_cast<std::int16_t>(std::round(std::clamp(value, -1.0f, 1.0f) * SHORT_MAX));
+    }
+
+    float UnpackSnorm16(const std::int16_t value)
+    {
+        return std::max(static_cast<float>(value) / SHORT_MAX, -1.0f);
+    }
+
+    float SignNotZero(const float value)
+    {
+        return value >= 0.0f ? 1.0f : -1.0f;
+    }
+
+    // Projects the normal onto the octahedron |x| + |y| + |z| = 1 and folds the lower half over the upper one
+    glm::vec2 EncodeOctahedral(const glm::vec3& normal)
+    {
+        float sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+        if (sum == 0.0f)
+            return glm::vec2(0.0f);
+
+        glm::vec2 encoded = glm::vec2(normal) / sum;
+        if (normal.z < 0.0f)
+            encoded = (1.0f - glm::abs(glm::vec2(encoded.y, encoded.x))) * glm::vec2(SignNotZero(encoded.x), SignNotZero(encoded.y));
+
+        return encoded;
+    }
+
+    // Same as DecodeNormal in the vertex shaders
+    glm::vec3 DecodeOctahedral(const glm::vec2& encoded)
+    {
+        glm::vec3 normal(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+        float fold = std::max(-normal.z, 0.0f);
+        normal.x += normal.x >= 0.0f ? -fold : fold;
+        normal.y += normal.y >= 0.0f ? -fold : fold;
+
+        return glm::normalize(normal);
+    }
+}
+
+void Geometry::VertexQuantization::SortByMaterial(std::vector<Vertex>& vertices, const std::span<unsigned int> indices)
+{
+    std::vector<unsigned int> order(vertices.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&vertices](const unsigned int a, const unsigned int b)
+    {
+        return vertices[a].materialIndex < vertices[b].materialIndex;
+    });
+
+    std::vector<unsigned int> remap(vertices.size());
+    std::vector<Vertex> sorted(vertices.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        remap[order[i]] = static_cast<unsigned int>(i);
+        sorted[i] = vertices[order[i]];
+    }
+
+    for (unsigned int& index : indices)
+        index = remap[index];
+
+    vertices = std::move(sorted);
+}
+
+std::vector<Geometry::MaterialRange> Geometry::VertexQuantization::GetMaterialRanges(const std::span<const Vertex> vertices)
+{
+    std::vector<MaterialRange> ranges;
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+    {
+        if (ranges.empty() || ranges.back().materialIndex != vertices[i].materialIndex)
+            ranges.push_back({ static_cast<unsigned int>(i), vertices[i].materialIndex });
+    }
+
+    return ranges;
+}
+
+Geometry::PositionQuantization Geometry::VertexQuantization::GetPositionQuantization(const std::span<const Vertex> vertices)
+{
+    if (vertices.empty())
+        return { glm::vec3(0.0f), glm::vec3(1.0f) };
+
+    glm::vec3 minimum = vertices.front().position, maximum = minimum;
+    for (const Vertex& vertex : vertices)
+    {
+        minimum = glm::min(minimum, vertex.position);
+        maximum = glm::max(maximum, vertex.position);
+    }
+
+    return { minimum, maximum - minimum };
+}
+
+std::vector<Geometry::QuantizedVertex> Geometry::VertexQuantization::Quantize(const std::span<const Vertex> vertices,
+                                                                              const PositionQuantization& quantization)
+{
+    // A flat axis keeps a scale of zero, every position then decodes to the offset
+    glm::vec3 inverseScale(0.0f);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (quantization.scale[axis] > 0.0f)
+            inverseScale[axis] = 1.0f / quantization.scale[axis];
+    }
+
+    std::vector<QuantizedVertex> quantizedVertices(vertices.size());
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+    {
+        const Vertex& vertex = vertices[i];
+        QuantizedVertex& quantizedVertex = quantizedVertices[i];
+
+        glm::vec3 position = glm::clamp((vertex.position - quantization.offset) * inverseScale, 0.0f, 1.0f);
+        for (int axis = 0; axis < 3; ++axis)
+            quantizedVertex.position[axis] = static_cast<std::uint16_t>(std::round(position[axis] * UNSIGNED_SHORT_MAX));
+        quantizedVertex.position[3] = 0;
+
+        glm::vec2 normal = EncodeOctahedral(vertex.normal);
+        quantizedVertex.normal[0] = PackSnorm16(normal.x);
+        quantizedVertex.normal[1] = PackSnorm16(normal.y);
+
+        quantizedVertex.textureCoordinates[0] = glm::packHalf1x16(vertex.textureCoordinates.x);
+        quantizedVertex.textureCoordinates[1] = glm::packHalf1x16(vertex.textureCoordinates.y);
+    }
+
+    return quantizedVertices;
+}
+
+Geometry::Vertex Geometry::VertexQuantization::Dequantize(const QuantizedVertex& vertex, const PositionQuantization& quantization)
+{
+    glm::vec3 position(vertex.position[0], vertex.position[1], vertex.position[2]);
+
+    return {
+        quantization.offset + quantization.scale * position / UNSIGNED_SHORT_MAX,
+        DecodeOctahedral(glm::vec2(UnpackSnorm16(vertex.normal[0]), UnpackSnorm16(vertex.normal[1]))),
+        glm::vec2(glm::unpackHalf1x16(vertex.textureCoordinates[0]), glm::unpackHalf1x16(vertex.textureCoordinates[1])),
+        -1
+    };
+}
+
+Geometry::QuantizationError Geometry::VertexQuantization::MeasureError(const std::span<const Vertex> vertices,
+                                                                        const std::span<const QuantizedVertex> quantizedVertices,
+                                                                        const PositionQuantization& quantization)
+{
+    QuantizationError error {};
+    for (std::size_t i = 0; i < vertices.size() && i < quantizedVertices.size(); ++i)
+    {
+        const Vertex& vertex = vertices[i];
+        Vertex decoded = Dequantize(quantizedVertices[i], quantization);
+
+        error.position = std::max(error.position, glm::length(decoded.position - vertex.position));
+        error.textureCoordinates = std::max(error.textureCoordinates,
+                                            glm::length(decoded.textureCoordinates - vertex.textureCoordinates));
+
+        // Files without normals leave them at zero, which has no direction to keep
+        float normalLength = glm::length(vertex.normal);
+        if (normalLength > 0.0f)
+        {
+            float cosine = std::clamp(glm::dot(decoded.normal, vertex.normal / normalLength), -1.0f, 1.0f);
+            error.normalDegrees = std::max(error.normalDegrees, glm::degrees(std::acos(cosine)));
+        }
+    }
+
+    return error;
+}
+
+bool Geometry::VertexQuantization::IsWithinLimits(const QuantizationError& error, const PositionQuantization& quantization)
+{
+    return error.position <= MAX_RELATIVE_POSITION_ERROR * glm::length(quantization.scale)
+        && error.normalDegrees <= MAX_NORMAL_DEGREES
+        && error.textureCoordinates <= MAX_TEXTURE_COORDINATE_ERROR;
+}
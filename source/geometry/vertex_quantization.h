@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <../../libraries/glm/glm.hpp>
+
+#include "geometry_structs.h"
+
+namespace Geometry
+{
+    /*
+     * 16 bytes against the 36 of Vertex. Positions are 16-bit fractions of the mesh's bounding box, normals are
+     * octahedral encoded into two signed 16-bit values and texture coordinates are half floats. The material index
+     * is not stored, vertices are sorted by material and the vertex shader finds it from gl_VertexID
+     */
+    struct QuantizedVertex
+    {
+        // The fourth component keeps the next attribute 4-byte aligned
+        std::uint16_t position[4];
+        std::int16_t normal[2];
+        std::uint16_t textureCoordinates[2];
+    };
+
+    static_assert(sizeof(QuantizedVertex) == 16);
+
+    // Decoded position = offset + scale * normalized position
+    struct PositionQuantization
+    {
+        glm::vec3 offset;
+        glm::vec3 scale;
+    };
+
+    // Vertices from firstVertex up to the next range's firstVertex use materialIndex
+    struct MaterialRange
+    {
+        unsigned int firstVertex;
+        int materialIndex;
+    };
+
+    // Largest difference between a vertex and its quantized copy
+    struct QuantizationError
+    {
+        float position;
+        float normalDegrees;
+        float textureCoordinates;
+    };
+
+    namespace VertexQuantization
+    {
+        // Length of the material range array in the vertex shaders, defined there as MAX_MATERIAL_RANGES
+        constexpr std::size_t MAX_MATERIAL_RANGES = 16;
+
+        /*
+         * Largest errors a quantized mesh may have. Positions are relative to the bounding box diagonal, half a
+         * 16-bit step on every axis. Texture coordinates allow half a texel of a 1024 texture, which half floats
+         * keep up to coordinates of about 2, so tiled meshes usually need full vertices
+         */
+        constexpr float MAX_RELATIVE_POSITION_ERROR = 0.5f / 65535.0f;
+        constexpr float MAX_NORMAL_DEGREES = 0.05f;
+        constexpr float MAX_TEXTURE_COORDINATE_ERROR = 1.0f / 2048.0f;
+
+        // Stable, so vertices keep their fetch order within each material
+        void SortByMaterial(std::vector<Vertex>& vertices, std::span<unsigned int> indices);
+        std::vector<MaterialRange> GetMaterialRanges(std::span<const Vertex> vertices);
+
+        PositionQuantization GetPositionQuantization(std::span<const Vertex> vertices);
+        std::vector<QuantizedVertex> Quantize(std::span<const Vertex> vertices, const PositionQuantization& quantization);
+        // The material index comes back as -1
+        Vertex Dequantize(const QuantizedVertex& vertex, const PositionQuantization& quantization);
+
+        QuantizationError MeasureError(std::span<const Vertex> vertices, std::span<const QuantizedVertex> quantizedVertices,
+                                       const PositionQuantization& quantization);
+        bool IsWithinLimits(const QuantizationError& error, const PositionQuantization& quantization);
+    }
+}
@@ -0,0 +1,94 @@
+#include "vertex_welding.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+using Geometry::VertexWelder;
+
+namespace
+{
+    // -0.0 and 0.0 compare equal but differ bitwise, so both are stored as 0.0
+    Geometry::Vertex Canonicalize(Geometry::Vertex vertex)
+    {
+        vertex.position += 0.0f;
+        vertex.normal += 0.0f;
+        vertex.textureCoordinates += 0.0f;
+
+        return vertex;
+    }
+
+    bool IsEqual(const Geometry::Vertex& a, const Geometry::Vertex& b)
+    {
+        return std::memcmp(&a, &b, sizeof(Geometry::Vertex)) == 0;
+    }
+}
+
+static_assert(sizeof(Geometry::Vertex) % sizeof(std::uint32_t) == 0, "Vertex must hash as whole 32-bit words");
+
+VertexWelder::VertexWelder(const std::size_t expectedVertexCount)
+{
+    // Keep the load factor at or below one half to keep probe sequences short
+    std::size_t slotCount = std::bit_ceil(std::max<std::size_t>(16, expectedVertexCount * 2));
+    mSlots.assign(slotCount, 0);
+    mSlotMask = slotCount - 1;
+
+    vertices.reserve(expectedVertexCount);
+}
+
+unsigned int VertexWelder::Add(const Vertex& vertex)
+{
+    const Vertex canonicalVertex = Canonicalize(vertex);
+
+    for (std::size_t slot = Hash(canonicalVertex) & mSlotMask;; slot = (slot + 1) & mSlotMask)
+    {
+        unsigned int entry = mSlots[slot];
+
+        if (entry == 0)
+        {
+            auto index = static_cast<unsigned int>(vertices.size());
+            vertices.push_back(canonicalVertex);
+            mSlots[slot] = index + 1;
+
+            if (vertices.size() * 2 > mSlots.size())
+                Grow();
+
+            return index;
+        }
+
+        if (IsEqual(vertices[entry - 1], canonicalVertex))
+            return entry - 1;
+    }
+}
+
+std::size_t VertexWelder::Hash(const Vertex& vertex)
+{
+    std::uint32_t words[sizeof(Vertex) / sizeof(std::uint32_t)];
+    std::memcpy(words, &vertex, sizeof(Vertex));
+
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (std::uint32_t word : words)
+        hash = (hash ^ word) * 0x100000001b3ull;
+
+    hash ^= hash >> 29;
+    hash *= 0xbf58476d1ce4e5b9ull;
+    hash ^= hash >> 32;
+
+    return static_cast<std::size_t>(hash);
+}
+
+void VertexWelder::Grow()
+{
+    mSlots.assign(mSlots.size() * 2, 0);
+    mSlotMask = mSlots.size() - 1;
+
+    for (unsigned int i = 0; i < vertices.size(); ++i)
+    {
+        std::size_t slot = Hash(vertices[i]) & mSlotMask;
+        while (mSlots[slot] != 0)
+            slot = (slot + 1) & mSlotMask;
+
+        mSlots[slot] = i + 1;
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+#include "geometry_structs.h"
+
+namespace Geometry
+{
+    // Deduplicates vertices through an open-addressing hash table so faces can share them in the index buffer
+    class VertexWelder
+    {
+    public:
+        explicit VertexWelder(std::size_t expectedVertexCount);
+
+        // Returns the index of the unique vertex equal to vertex, adding it if it has not been seen yet
+        unsigned int Add(const Vertex& vertex);
+
+        std::vector<Vertex> vertices;
+
+    private:
+        static std::size_t Hash(const Vertex& vertex);
+        void Grow();
+
+        // Slots hold a vertex index + 1, zero marks an empty slot
+        std::vector<unsigned int> mSlots;
+        std::size_t mSlotMask;
+    };
+}
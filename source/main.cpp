@@ -1,21 +1,22 @@
+#include <chrono>
 #include <iostream>
 #include <random>
-#include <map>
 
 #include <glad/glad.h>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
-#include "stb_image.h"
 
 #include "constants.h"
 #include "camera.h"
 #include "utility/utility_functions.h"
-#include "assets/import_functions.h"
 #include "geometry/geometry_functions.h"
 #include "resource_manager.h"
 #include "geometry/model.h"
 #include "scenes/scene.h"
+#include "scenes/scene_layout.h"
+#include "shading/parallel_compile.h"
+#include "shading/stage_cache.h"
 
 using Shading::ShaderProgram;
 using Geometry::Model;
@@ -52,6 +53,9 @@ namespace MainFunctions
     void GeometryHousesScene(GLFWwindow* window, ResourceManager& resourceManager);
     void ModelViewer(GLFWwindow* window, ResourceManager& resourceManager);
 
+    // Loading stuff
+    void ReportSceneReady(const char* sceneName, std::chrono::steady_clock::time_point loadStart);
+
     // Input stuff
     void ProcessInput(GLFWwindow* window);
     void MouseCallback(GLFWwindow* window, double xpos, double ypos);
@@ -70,6 +74,8 @@ int main()
     if (window == nullptr || Utility::InitializeGLADLoader() < 0)
         return -1;
 
+    Shading::ParallelCompile::Initialize(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
+
     glfwSwapInterval(0);
     glfwSetFramebufferSizeCallback(window, MainFunctions::FramebufferSizeCallback);
     glViewport(0, 0, Constants::SCREEN_WIDTH, Constants::SCREEN_HEIGHT);
@@ -79,10 +85,14 @@ int main()
     glfwSetCursorPosCallback(window, MainFunctions::MouseCallback);
     glfwSetScrollCallback(window, MainFunctions::ScrollCallback);
 
-    ResourceManager shaderManager = ResourceManager();
+    // Destroyed before the context, which deleting its GL objects needs
+    {
+        ResourceManager shaderManager = ResourceManager();
 
-    MainFunctions::GrassScene(window, shaderManager);
+        MainFunctions::GrassScene(window, shaderManager);
+    }
 
+    Shading::StageCache::Clear();
     glfwTerminate();
     return 0;
 }
@@ -100,6 +110,7 @@ void MainFunctions::EmptyScene(GLFWwindow *window, ResourceManager &resourceMana
         previousTime = currentTime;
 
         ProcessInput(window);
+        resourceManager.Update();
 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -115,6 +126,10 @@ void MainFunctions::EmptyScene(GLFWwindow *window, ResourceManager &resourceMana
 
 void MainFunctions::GrassScene(GLFWwindow *window, ResourceManager &resourceManager)
 {
+    auto loadStart = std::chrono::steady_clock::now();
+    Utility::Task<Model> skysphereLoad = resourceManager.LoadModelAsync("assets/shapes/inverse_sphere.obj");
+    Utility::Task<Model> groundLoad = resourceManager.LoadModelAsync("assets/shapes/plane.obj");
+
     ShaderProgram* skysphereShader = resourceManager.CreateShaderProgram(
         "shaders/shaderdev/skysphere.vert",
         "shaders/shaderdev/skysphere.frag",
@@ -123,6 +138,10 @@ void MainFunctions::GrassScene(GLFWwindow *window, ResourceManager &resourceMana
         "shaders/shaderdev/ground.vert",
         "shaders/shaderdev/ground.frag",
         { Matrices });
+    ShaderProgram* grassShader = resourceManager.CreateShaderProgram(
+        "shaders/shaderdev/grass.vert",
+        "shaders/shaderdev/grass.frag",
+        { Matrices });
 
     const int GRASS_COUNT = 32 * 2048;
     const int GRASS_SEGMENTS = 6;
@@ -134,12 +153,16 @@ void MainFunctions::GrassScene(GLFWwindow *window, ResourceManager &resourceMana
     Geometry::CreateGrassGeometry(GRASS_SEGMENTS, grassVAO, grassIndicesCount);
 
     camera = Camera(glm::vec3(0.0f, 3.5f, 15.0f));
-    Model skysphere = resourceManager.LoadModel("assets/shapes/inverse_sphere.obj");
-    Model ground = resourceManager.LoadModel("assets/shapes/plane.obj");
+    unsigned int gridSquare = resourceManager.textureCache.AcquireTexture("assets/textures/square.png", GL_SRGB_ALPHA, GL_RGB, GL_REPEAT);
+
+    Model skysphere = resourceManager.Wait(skysphereLoad);
+    Model ground = resourceManager.Wait(groundLoad);
+    resourceManager.WaitForTextures();
+    resourceManager.WaitForShaderPrograms();
+    ReportSceneReady("GrassScene", loadStart);
     ground.scale = glm::vec3(GRASS_PATCH_SIZE);
     skysphere.scale = glm::vec3(100.0);
 
-    unsigned int gridSquare = Assets::LoadTexture("assets/textures/square.png", GL_SRGB_ALPHA, GL_RGB, GL_REPEAT);
     groundShader->Use();
     groundShader->SetInt("diffuseTexture", 0);
 
@@ -158,14 +181,7 @@ void MainFunctions::GrassScene(GLFWwindow *window, ResourceManager &resourceMana
         previousTime = currentTime;
 
         ProcessInput(window);
-
-        ShaderProgram grassShader = ShaderProgram("shaders/shaderdev/grass.vert", "shaders/shaderdev/grass.frag");
-
-        int returnValue;
-        glGetProgramiv(grassShader.mID, GL_ACTIVE_UNIFORM_BLOCKS, &returnValue);
-
-        int uniformBlockIndex = glGetUniformBlockIndex(grassShader.mID, "Matrices");
-        glUniformBlockBinding(grassShader.mID, uniformBlockIndex, 0);
+        resourceManager.Update();
 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -182,12 +198,12 @@ void MainFunctions::GrassScene(GLFWwindow *window, ResourceManager &resourceMana
         glBindTexture(GL_TEXTURE_2D, gridSquare);
         ground.Draw(groundShader);
 
-        grassShader.Use();
-        grassShader.SetVec4("grassParams", glm::vec4(GRASS_SEGMENTS, GRASS_PATCH_SIZE, GRASS_WIDTH, GRASS_HEIGHT));
-        grassShader.SetMat4("model", glm::mat4(1.0));
-        grassShader.SetFloat("time", currentTime);
-        grassShader.SetVec2("resolution", screenWidth, screenHeight);
-        grassShader.SetVec3("cameraPosition", camera.Position);
+        grassShader->Use();
+        grassShader->SetVec4("grassParams", glm::vec4(GRASS_SEGMENTS, GRASS_PATCH_SIZE, GRASS_WIDTH, GRASS_HEIGHT));
+        grassShader->SetMat4("model", glm::mat4(1.0));
+        grassShader->SetFloat("time", currentTime);
+        grassShader->SetVec2("resolution", screenWidth, screenHeight);
+        grassShader->SetVec3("cameraPosition", camera.Position);
 
         glBindVertexArray(grassVAO);
         glDrawElementsInstanced(GL_TRIANGLES, grassIndicesCount, GL_UNSIGNED_INT, nullptr, GRASS_COUNT);
@@ -196,15 +212,25 @@ void MainFunctions::GrassScene(GLFWwindow *window, ResourceManager &resourceMana
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
+
+    resourceManager.textureCache.Release(gridSquare);
 }
 
 void MainFunctions::VertexColors(GLFWwindow *window, ResourceManager &resourceManager)
 {
+    auto loadStart = std::chrono::steady_clock::now();
+    Utility::Task<Model> suzanneLoad = resourceManager.LoadModelAsync("assets/shapes/cube.obj");
+
     ShaderProgram* skyboxShader         = resourceManager.CreateShaderProgram(
     "shaders/general/skybox.vert",
     "shaders/general/skybox.frag",
     { Matrices });
 
+    ShaderProgram* objectShader         = resourceManager.CreateShaderProgram(
+        "shaders/shaderdev/vertex_colors.vert",
+        "shaders/shaderdev/vertex_colors.frag",
+        { Matrices });
+
     unsigned int windowVAO, windowVBO, windowEBO, windowIndicesCount;
     Geometry::CreateSquare(1.0f, windowVAO, windowVBO, windowEBO, windowIndicesCount);
 
@@ -220,9 +246,12 @@ void MainFunctions::VertexColors(GLFWwindow *window, ResourceManager &resourceMa
         "assets/textures/ocean_mountains/front.jpg",
         "assets/textures/ocean_mountains/back.jpg"
     };
-    unsigned int skyboxTexture = Assets::LoadCubemap(skyboxFaces, GL_SRGB, GL_RGB);
+    unsigned int skyboxTexture = resourceManager.textureCache.AcquireCubemap(skyboxFaces, GL_SRGB, GL_RGB);
 
-    Model suzanne = resourceManager.LoadModel("assets/shapes/cube.obj");
+    Model suzanne = resourceManager.Wait(suzanneLoad);
+    resourceManager.WaitForTextures();
+    resourceManager.WaitForShaderPrograms();
+    ReportSceneReady("VertexColors", loadStart);
 
     glEnable(GL_DEPTH_TEST);
     glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
@@ -230,14 +259,12 @@ void MainFunctions::VertexColors(GLFWwindow *window, ResourceManager &resourceMa
 
     while (!glfwWindowShouldClose(window))
     {
-        ShaderProgram objectShader = ShaderProgram(
-            "shaders/shaderdev/vertex_colors.vert", "shaders/shaderdev/vertex_colors.frag");
-
         float currentTime = glfwGetTime();
         deltaTime = currentTime - previousTime;
         previousTime = currentTime;
 
         ProcessInput(window);
+        resourceManager.Update();
 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -246,9 +273,9 @@ void MainFunctions::VertexColors(GLFWwindow *window, ResourceManager &resourceMa
 
         resourceManager.SetMatrices(view, projection);
 
-        objectShader.Use();
-        objectShader.SetFloat("time", currentTime);
-        suzanne.Draw(&objectShader);
+        objectShader->Use();
+        objectShader->SetFloat("time", currentTime);
+        suzanne.Draw(objectShader);
 
         /*
         * Draw skybox
@@ -268,15 +295,25 @@ void MainFunctions::VertexColors(GLFWwindow *window, ResourceManager &resourceMa
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
+
+    resourceManager.textureCache.Release(skyboxTexture);
 }
 
 void MainFunctions::CelShader(GLFWwindow *window, ResourceManager &resourceManager)
 {
+    auto loadStart = std::chrono::steady_clock::now();
+    Utility::Task<Model> suzanneLoad = resourceManager.LoadModelAsync("assets/shapes/suzanne.obj");
+
     ShaderProgram* skyboxShader         = resourceManager.CreateShaderProgram(
         "shaders/general/skybox.vert",
         "shaders/general/skybox.frag",
     { Matrices });
 
+    ShaderProgram* objectShader         = resourceManager.CreateShaderProgram(
+        "shaders/shaderdev/model.vert",
+        "shaders/shaderdev/cel_shading.frag",
+        { Matrices });
+
     unsigned int windowVAO, windowVBO, windowEBO, windowIndicesCount;
     Geometry::CreateSquare(1.0f, windowVAO, windowVBO, windowEBO, windowIndicesCount);
 
@@ -292,9 +329,12 @@ void MainFunctions::CelShader(GLFWwindow *window, ResourceManager &resourceManag
         "assets/textures/ocean_mountains/front.jpg",
         "assets/textures/ocean_mountains/back.jpg"
     };
-    unsigned int skyboxTexture = Assets::LoadCubemap(skyboxFaces, GL_SRGB, GL_RGB);
+    unsigned int skyboxTexture = resourceManager.textureCache.AcquireCubemap(skyboxFaces, GL_SRGB, GL_RGB);
 
-    Model suzanne = resourceManager.LoadModel("assets/shapes/suzanne.obj");
+    Model suzanne = resourceManager.Wait(suzanneLoad);
+    resourceManager.WaitForTextures();
+    resourceManager.WaitForShaderPrograms();
+    ReportSceneReady("CelShader", loadStart);
 
     glEnable(GL_DEPTH_TEST);
     glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
@@ -302,14 +342,12 @@ void MainFunctions::CelShader(GLFWwindow *window, ResourceManager &resourceManag
 
     while (!glfwWindowShouldClose(window))
     {
-        ShaderProgram objectShader = ShaderProgram(
-            "shaders/shaderdev/model.vert", "shaders/shaderdev/cel_shading.frag");
-
         float currentTime = glfwGetTime();
         deltaTime = currentTime - previousTime;
         previousTime = currentTime;
 
         ProcessInput(window);
+        resourceManager.Update();
 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -318,9 +356,9 @@ void MainFunctions::CelShader(GLFWwindow *window, ResourceManager &resourceManag
 
         resourceManager.SetMatrices(view, projection);
 
-        objectShader.Use();
-        objectShader.SetFloat("time", currentTime);
-        suzanne.Draw(&objectShader);
+        objectShader->Use();
+        objectShader->SetFloat("time", currentTime);
+        suzanne.Draw(objectShader);
 
         /*
         * Draw skybox
@@ -340,15 +378,25 @@ void MainFunctions::CelShader(GLFWwindow *window, ResourceManager &resourceManag
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
+
+    resourceManager.textureCache.Release(skyboxTexture);
 }
 
 void MainFunctions::LightingShaderDev(GLFWwindow *window, ResourceManager &resourceManager)
 {
+    auto loadStart = std::chrono::steady_clock::now();
+    Utility::Task<Model> suzanneLoad = resourceManager.LoadModelAsync("assets/shapes/suzanne.obj");
+
     ShaderProgram* skyboxShader         = resourceManager.CreateShaderProgram(
         "shaders/general/skybox.vert",
         "shaders/general/skybox.frag",
     { Matrices });
 
+    ShaderProgram* objectShader         = resourceManager.CreateShaderProgram(
+        "shaders/shaderdev/model.vert",
+        "shaders/shaderdev/lighting.frag",
+        { Matrices });
+
     unsigned int windowVAO, windowVBO, windowEBO, windowIndicesCount;
     Geometry::CreateSquare(1.0f, windowVAO, windowVBO, windowEBO, windowIndicesCount);
 
@@ -364,9 +412,12 @@ void MainFunctions::LightingShaderDev(GLFWwindow *window, ResourceManager &resou
         "assets/textures/ocean_mountains/front.jpg",
         "assets/textures/ocean_mountains/back.jpg"
     };
-    unsigned int skyboxTexture = Assets::LoadCubemap(skyboxFaces, GL_SRGB, GL_RGB);
+    unsigned int skyboxTexture = resourceManager.textureCache.AcquireCubemap(skyboxFaces, GL_SRGB, GL_RGB);
 
-    Model suzanne = resourceManager.LoadModel("assets/shapes/suzanne.obj");
+    Model suzanne = resourceManager.Wait(suzanneLoad);
+    resourceManager.WaitForTextures();
+    resourceManager.WaitForShaderPrograms();
+    ReportSceneReady("LightingShaderDev", loadStart);
 
     glEnable(GL_DEPTH_TEST);
     glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
@@ -374,14 +425,12 @@ void MainFunctions::LightingShaderDev(GLFWwindow *window, ResourceManager &resou
 
     while (!glfwWindowShouldClose(window))
     {
-        ShaderProgram objectShader = ShaderProgram(
-            "shaders/shaderdev/model.vert", "shaders/shaderdev/lighting.frag");
-
         float currentTime = glfwGetTime();
         deltaTime = currentTime - previousTime;
         previousTime = currentTime;
 
         ProcessInput(window);
+        resourceManager.Update();
 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -390,9 +439,9 @@ void MainFunctions::LightingShaderDev(GLFWwindow *window, ResourceManager &resou
 
         resourceManager.SetMatrices(view, projection);
 
-        objectShader.Use();
-        objectShader.SetFloat("time", currentTime);
-        suzanne.Draw(&objectShader);
+        objectShader->Use();
+        objectShader->SetFloat("time", currentTime);
+        suzanne.Draw(objectShader);
 
         /*
         * Draw skybox
@@ -412,16 +461,22 @@ void MainFunctions::LightingShaderDev(GLFWwindow *window, ResourceManager &resou
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
+
+    resourceManager.textureCache.Release(skyboxTexture);
 }
 
 void MainFunctions::ScreenShader(GLFWwindow *window, ResourceManager &resourceManager)
 {
+    ShaderProgram* windowShader = resourceManager.CreateShaderProgram(
+        "shaders/shaderdev/screen_space.vert",
+        "shaders/shaderdev/cloudy_day.frag");
+
     unsigned int windowVAO, windowVBO, windowEBO, windowIndicesCount;
     Geometry::CreateSquare(1.0f, windowVAO, windowVBO, windowEBO, windowIndicesCount);
 
-    stbi_set_flip_vertically_on_load(true);
-    unsigned int diffuse1 = Assets::LoadTexture("assets/textures/flower.jpg", GL_SRGB, GL_RGB, GL_REPEAT);
-    unsigned int diffuse2 = Assets::LoadTexture("assets/textures/flower.jpg", GL_SRGB, GL_RGB, GL_REPEAT);
+    resourceManager.textureLoader.SetFlipVertically(true);
+    unsigned int diffuse1 = resourceManager.textureCache.AcquireTexture("assets/textures/flower.jpg", GL_SRGB, GL_RGB, GL_REPEAT);
+    unsigned int diffuse2 = resourceManager.textureCache.AcquireTexture("assets/textures/flower.jpg", GL_SRGB, GL_RGB, GL_REPEAT);
 
     glEnable(GL_DEPTH_TEST);
     glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
@@ -429,14 +484,12 @@ void MainFunctions::ScreenShader(GLFWwindow *window, ResourceManager &resourceMa
 
     while (!glfwWindowShouldClose(window))
     {
-        ShaderProgram windowShader = ShaderProgram(
-            "shaders/shaderdev/screen_space.vert", "shaders/shaderdev/cloudy_day.frag");
-
         float currentTime = glfwGetTime();
         deltaTime = currentTime - previousTime;
         previousTime = currentTime;
 
         ProcessInput(window);
+        resourceManager.Update();
 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -445,11 +498,11 @@ void MainFunctions::ScreenShader(GLFWwindow *window, ResourceManager &resourceMa
 
         resourceManager.SetMatrices(view, projection);
 
-        windowShader.Use();
-        windowShader.SetInt("diffuse1", 0);
-        windowShader.SetInt("diffuse2", 1);
-        windowShader.SetVec2("resolution", screenWidth, screenHeight);
-        windowShader.SetFloat("time", currentTime);
+        windowShader->Use();
+        windowShader->SetInt("diffuse1", 0);
+        windowShader->SetInt("diffuse2", 1);
+        windowShader->SetVec2("resolution", screenWidth, screenHeight);
+        windowShader->SetFloat("time", currentTime);
 
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, diffuse1);
@@ -462,6 +515,9 @@ void MainFunctions::ScreenShader(GLFWwindow *window, ResourceManager &resourceMa
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
+
+    resourceManager.textureCache.Release(diffuse1);
+    resourceManager.textureCache.Release(diffuse2);
 }
 
 void MainFunctions::SpaceScene(GLFWwindow *window, ResourceManager &resourceManager)
@@ -471,12 +527,19 @@ void MainFunctions::SpaceScene(GLFWwindow *window, ResourceManager &resourceMana
         "shaders/lighting/simple_diffuse_unlit.frag",
         { Matrices });
     ShaderProgram* instancedUnlitShader = resourceManager.CreateShaderProgram(
-        "shaders/general/default_instanced.vert",
+        "shaders/general/default.vert",
         "shaders/lighting/simple_diffuse_unlit.frag",
-        { Matrices });
-
-    Model planet = resourceManager.LoadModel("assets/models/planet/planet.obj");
-    Model asteroid = resourceManager.LoadModel("assets/models/rock/rock.obj");
+        { Matrices },
+        { { "INSTANCED" } });
+
+    auto loadStart = std::chrono::steady_clock::now();
+    Utility::Task<Model> planetLoad = resourceManager.LoadModelAsync("assets/models/planet/planet.obj", true, Geometry::VertexFormat::Quantized);
+    Utility::Task<Model> asteroidLoad = resourceManager.LoadModelAsync("assets/models/rock/rock.obj", false, Geometry::VertexFormat::Quantized);
+    Model planet = resourceManager.Wait(planetLoad);
+    Model asteroid = resourceManager.Wait(asteroidLoad);
+    resourceManager.WaitForTextures();
+    resourceManager.WaitForShaderPrograms();
+    ReportSceneReady("SpaceScene", loadStart);
     resourceManager.ApplyMaterials(unlitShader);
     resourceManager.ApplyMaterials(instancedUnlitShader);
 
@@ -485,42 +548,19 @@ void MainFunctions::SpaceScene(GLFWwindow *window, ResourceManager &resourceMana
 
     std::random_device randomDevice;
     std::mt19937 randomEngine(randomDevice());
-    std::uniform_int_distribution scaleDist(0, 19);
-    std::uniform_int_distribution rotationDist(0, 359);
 
     unsigned int amount = 200000;
-    glm::mat4* modelMatrices = new glm::mat4[amount];
     float radius = 120.0f;
     float offset = 50.0f;
+    std::vector<glm::mat4> modelMatrices = SceneLayout::CreateAsteroidRing(amount, radius, offset, randomEngine);
 
-    for (unsigned int i = 0; i < amount; ++i)
-    {
-        float angle = static_cast<float>(i) / static_cast<float>(amount) * 360.0f;
-        glm::mat4 model = glm::mat4(1.0f);
-        std::uniform_int_distribution positionDist(0, static_cast<int>(2 * offset * 100));
-
-        float displacement = positionDist(randomEngine) / 100.0f - offset;
-        float x = sin(angle) * radius + displacement;
-        displacement = positionDist(randomEngine) / 100.0f - offset;
-        float y = displacement * 0.02f;
-        displacement = positionDist(randomEngine) / 100.0f - offset;
-        float z = cos(angle) * radius + displacement;
-        model = translate(model, glm::vec3(x, y, z));
-
-        float scale = scaleDist(randomEngine) / 100.0f + 0.05f;
-        model = glm::scale(model, glm::vec3(scale));
-
-        float rotAngle = rotationDist(randomEngine) % 360;
-        model = rotate(model, rotAngle, glm::vec3(0.4, 0.6f, 0.8f));
-
-        modelMatrices[i] = model;
-    }
-
-    asteroid.SetupInstancing(amount, modelMatrices);
+    asteroid.SetupInstancing(amount, modelMatrices.data());
 
     glEnable(GL_FRAMEBUFFER_SRGB);
     glEnable(GL_DEPTH_TEST);
 
+    float lodReportTime = 0.0f;
+
     while (!glfwWindowShouldClose(window))
     {
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
@@ -531,6 +571,9 @@ void MainFunctions::SpaceScene(GLFWwindow *window, ResourceManager &resourceMana
         previousTime = currentTime;
 
         ProcessInput(window);
+        resourceManager.Update();
+        resourceManager.lodSelector.ResetStats();
+        ShaderProgram::ResetUniformStats();
 
         view = camera.GetViewMatrix();
         projection = glm::perspective(glm::radians(camera.Zoom), static_cast<float>(screenWidth) / static_cast<float>(screenHeight), 0.1f, 500.0f);
@@ -541,21 +584,48 @@ void MainFunctions::SpaceScene(GLFWwindow *window, ResourceManager &resourceMana
         planet.Draw(unlitShader);
 
         instancedUnlitShader->Use();
-        asteroid.DrawInstanced();
+        asteroid.DrawInstanced(instancedUnlitShader);
+
+        if (currentTime - lodReportTime >= 1.0f)
+        {
+            Geometry::LodStats lodStats = resourceManager.lodSelector.GetStats();
+            std::cout << "LOD::TRIANGLES " << lodStats.submittedTriangles << " submitted this frame, "
+                      << lodStats.fullDetailTriangles << " without levels of detail" << std::endl;
+
+            Shading::UniformStats uniformStats = ShaderProgram::GetUniformStats();
+            std::cout << "SHADER::UNIFORM_CALLS " << uniformStats.issuedCalls << " issued this frame, "
+                      << uniformStats.skippedCalls << " skipped as redundant" << std::endl;
+            lodReportTime = currentTime;
+        }
 
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
-    delete[] modelMatrices;
 }
 
 void MainFunctions::Playground(GLFWwindow *window, ResourceManager& resourceManager)
 {
+    auto loadStart = std::chrono::steady_clock::now();
+    Utility::Task<Model> backpackLoad = resourceManager.LoadModelAsync("assets/models/backpack/backpack.obj");
+    Utility::Task<Model> floorLoad = resourceManager.LoadModelAsync("assets/models/floor/floor.obj", true);
+
+    // Before the object shader, which is specialized for their count
+    resourceManager.lightManager.AddPointLight(glm::vec3(0.0f),
+                                             glm::vec3(0.03f), glm::vec3(0.5f), glm::vec3(1.0f),
+                                             1.0f, 0.09f, 0.032f);
+    resourceManager.lightManager.AddPointLight(glm::vec3(0.0f),
+                                             glm::vec3(0.03f), glm::vec3(0.5f), glm::vec3(1.0f),
+                                             1.0f, 0.09f, 0.032f);
+    resourceManager.lightManager.AddPointLight(glm::vec3(-15.0f, -1.0f, -15.0f),
+                                             glm::vec3(0.03f), glm::vec3(0.5f),glm::vec3(1.0f),
+                                             1.0f, 0.09f, 0.032f);
+
     ShaderProgram* objectShader         = resourceManager.CreateShaderProgram(
         "shaders/general/default.vert",
         "shaders/lighting/point_lights.frag",
-        { Matrices, PointLights });
+        { Matrices, PointLights },
+        { resourceManager.GetPointLightCountDefine() });
     ShaderProgram* windowShader         = resourceManager.CreateShaderProgram(
         "shaders/general/default.vert",
         "shaders/general/transparent_texture.frag",
@@ -580,22 +650,12 @@ void MainFunctions::Playground(GLFWwindow *window, ResourceManager& resourceMana
         "shaders/post_processing/default_screen_space.vert",
         "shaders/post_processing/default_screen_space.frag");
 
-    resourceManager.lightManager.AddPointLight(glm::vec3(0.0f),
-                                             glm::vec3(0.03f), glm::vec3(0.5f), glm::vec3(1.0f),
-                                             1.0f, 0.09f, 0.032f);
-    resourceManager.lightManager.AddPointLight(glm::vec3(0.0f),
-                                             glm::vec3(0.03f), glm::vec3(0.5f), glm::vec3(1.0f),
-                                             1.0f, 0.09f, 0.032f);
-    resourceManager.lightManager.AddPointLight(glm::vec3(-15.0f, -1.0f, -15.0f),
-                                             glm::vec3(0.03f), glm::vec3(0.5f),glm::vec3(1.0f),
-                                             1.0f, 0.09f, 0.032f);
-
     SetupFramebuffer();
     unsigned int drawBuffer = Constants::MSAA > 0 ? msaaFramebuffer : framebuffer;
 
     unsigned int windowVAO, windowVBO, windowEBO, windowIndicesCount, windowTexture;
     Geometry::CreateSquare(0.5f, windowVAO, windowVBO, windowEBO, windowIndicesCount);
-    windowTexture = Assets::LoadTexture("assets/textures/window.png", GL_SRGB_ALPHA, GL_RGBA, GL_CLAMP_TO_EDGE);
+    windowTexture = resourceManager.textureCache.AcquireTexture("assets/textures/window.png", GL_SRGB_ALPHA, GL_RGBA, GL_CLAMP_TO_EDGE);
 
     unsigned int screenVAO, screenVBO, screenEBO, screenIndicesCount;
     Geometry::CreateSquare(1.0f, screenVAO, screenVBO, screenEBO, screenIndicesCount);
@@ -612,14 +672,18 @@ void MainFunctions::Playground(GLFWwindow *window, ResourceManager& resourceMana
         "assets/textures/yokohama/front.jpg",
         "assets/textures/yokohama/back.jpg"
     };
-    skyboxTexture = Assets::LoadCubemap(skyboxFaces, GL_SRGB, GL_RGB);
+    skyboxTexture = resourceManager.textureCache.AcquireCubemap(skyboxFaces, GL_SRGB, GL_RGB);
 
     std::vector<glm::vec3> windowObjects;
     windowObjects.emplace_back(0.0f, -1.0f, -5.0f);
     windowObjects.emplace_back(0.0f, -1.0f,  7.0f);
+    std::vector<glm::vec3> sortedWindowObjects;
 
-    Model backpack = resourceManager.LoadModel("assets/models/backpack/backpack.obj");
-    Model floor = resourceManager.LoadModel("assets/models/floor/floor.obj");
+    Model backpack = resourceManager.Wait(backpackLoad);
+    Model floor = resourceManager.Wait(floorLoad);
+    resourceManager.WaitForTextures();
+    resourceManager.WaitForShaderPrograms();
+    ReportSceneReady("Playground", loadStart);
 
     int textureCount = resourceManager.GetTextureCount();
     screenSpaceShader->Use();
@@ -664,6 +728,7 @@ void MainFunctions::Playground(GLFWwindow *window, ResourceManager& resourceMana
         previousTime = currentTime;
 
         ProcessInput(window);
+        resourceManager.Update();
 
         /*
          * Common shader setup
@@ -736,17 +801,11 @@ void MainFunctions::Playground(GLFWwindow *window, ResourceManager& resourceMana
         glBindVertexArray(windowVAO);
         glDisable(GL_CULL_FACE);
 
-        std::map<float, glm::vec3> sorted;
-        for (glm::vec3 windowObject : windowObjects)
-        {
-            float distance = glm::length(camera.Position - windowObject);
-            sorted[distance] = windowObject;
-        }
-
-        for (std::map<float, glm::vec3>::reverse_iterator it = sorted.rbegin(); it != sorted.rend(); ++it)
+        SceneLayout::SortBackToFront(windowObjects, camera.Position, sortedWindowObjects);
+        for (const glm::vec3& windowObject : sortedWindowObjects)
         {
             glm::mat4 model = glm::mat4(1.0f);
-            model = translate(model, it->second);
+            model = translate(model, windowObject);
             model = scale(model, glm::vec3(3.0f));
 
             windowShader->SetMat4("model", model);
@@ -788,10 +847,16 @@ void MainFunctions::Playground(GLFWwindow *window, ResourceManager& resourceMana
     }
 
     CleanupFramebuffer();
+    resourceManager.textureCache.Release(windowTexture);
+    resourceManager.textureCache.Release(skyboxTexture);
 }
 
 void MainFunctions::ShadowsScene(GLFWwindow *window, ResourceManager& resourceManager)
 {
+    auto loadStart = std::chrono::steady_clock::now();
+    Utility::Task<Model> modelLoad = resourceManager.LoadModelAsync("assets/models/rock/rock.obj");
+    Utility::Task<Model> floorLoad = resourceManager.LoadModelAsync("assets/models/floor/floor.obj");
+
     ShaderProgram* objectShader         = resourceManager.CreateShaderProgram(
         "shaders/general/default.vert",
         "shaders/lighting/directional_light.frag",
@@ -821,9 +886,12 @@ void MainFunctions::ShadowsScene(GLFWwindow *window, ResourceManager& resourceMa
         "assets/textures/ocean_mountains/front.jpg",
         "assets/textures/ocean_mountains/back.jpg"
     };
-    skyboxTexture = Assets::LoadCubemap(skyboxFaces, GL_SRGB, GL_RGB);
-    Model model = resourceManager.LoadModel("assets/models/rock/rock.obj");
-    Model floor = resourceManager.LoadModel("assets/models/floor/floor.obj");
+    skyboxTexture = resourceManager.textureCache.AcquireCubemap(skyboxFaces, GL_SRGB, GL_RGB);
+    Model model = resourceManager.Wait(modelLoad);
+    Model floor = resourceManager.Wait(floorLoad);
+    resourceManager.WaitForTextures();
+    resourceManager.WaitForShaderPrograms();
+    ReportSceneReady("ShadowsScene", loadStart);
 
     Scene scene;
     scene.AddObject(&floor, glm::vec3(0.0f, -3.5f, 0.0f));
@@ -851,6 +919,7 @@ void MainFunctions::ShadowsScene(GLFWwindow *window, ResourceManager& resourceMa
         previousTime = currentTime;
 
         ProcessInput(window);
+        resourceManager.Update();
 
         /*
          *
@@ -925,6 +994,7 @@ void MainFunctions::ShadowsScene(GLFWwindow *window, ResourceManager& resourceMa
     }
 
     CleanupFramebuffer();
+    resourceManager.textureCache.Release(skyboxTexture);
 }
 
 void MainFunctions::GeometryHousesScene(GLFWwindow* window, ResourceManager& resourceManager)
@@ -962,6 +1032,7 @@ void MainFunctions::GeometryHousesScene(GLFWwindow* window, ResourceManager& res
         glClear(GL_COLOR_BUFFER_BIT);
 
         ProcessInput(window);
+        resourceManager.Update();
 
         pointsShader->Use();
         glBindVertexArray(VAO);
@@ -979,8 +1050,13 @@ void MainFunctions::ModelViewer(GLFWwindow *window, ResourceManager &resourceMan
         "shaders/lighting/simple_diffuse_unlit.frag",
         { Matrices, PointLights });
 
-    stbi_set_flip_vertically_on_load(true);
-    Model loadedModel = resourceManager.LoadModel("assets/models/shanalotte/Shanalotte.obj");
+    resourceManager.textureLoader.SetFlipVertically(true);
+    auto loadStart = std::chrono::steady_clock::now();
+    Utility::Task<Model> loadedModelLoad = resourceManager.LoadModelAsync("assets/models/shanalotte/Shanalotte.obj");
+    Model loadedModel = resourceManager.Wait(loadedModelLoad);
+    resourceManager.WaitForTextures();
+    resourceManager.WaitForShaderPrograms();
+    ReportSceneReady("ModelViewer", loadStart);
     loadedModel.scale = glm::vec3(0.2f);
     resourceManager.ApplyMaterials(objectShader);
 
@@ -1001,6 +1077,7 @@ void MainFunctions::ModelViewer(GLFWwindow *window, ResourceManager &resourceMan
         previousTime = currentTime;
 
         ProcessInput(window);
+        resourceManager.Update();
 
         view = camera.GetViewMatrix();
         projection = glm::perspective(glm::radians(camera.Zoom), static_cast<float>(screenWidth) / static_cast<float>(screenHeight), 0.1f, 100.0f);
@@ -1020,6 +1097,22 @@ void MainFunctions::ModelViewer(GLFWwindow *window, ResourceManager &resourceMan
     }
 }
 
+void MainFunctions::ReportSceneReady(const char* sceneName, const std::chrono::steady_clock::time_point loadStart)
+{
+    std::chrono::duration<double, std::milli> loadTime = std::chrono::steady_clock::now() - loadStart;
+    std::cout << "SCENE::READY " << sceneName << " in " << loadTime.count() << " ms" << std::endl;
+
+    Shading::ProgramBuildStats buildStats = ShaderProgram::GetBuildStats();
+    std::cout << "SHADER::STARTUP " << buildStats.cachedPrograms << " programs from the binary cache in "
+              << buildStats.cachedMilliseconds << " ms, " << buildStats.compiledPrograms << " compiled from source in "
+              << buildStats.compiledMilliseconds << " ms" << std::endl;
+
+    Shading::StageCacheStats stageStats = Shading::StageCache::GetStats();
+    std::cout << "SHADER::STAGES " << stageStats.compiledStages << " compiled in " << stageStats.compileMilliseconds
+              << " ms, " << stageStats.sharedStages << " shared between programs, saving " << stageStats.savedMilliseconds
+              << " ms" << std::endl;
+}
+
 void MainFunctions::ProcessInput(GLFWwindow* window)
 {
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
@@ -1,144 +1,414 @@
 #include "resource_manager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <thread>
+
 #include <../libraries/glm/gtc/type_ptr.hpp>
 #include "../libraries/glad/include/glad/glad.h"
 
+#include "geometry/mesh_cache.h"
+#include "shading/parallel_compile.h"
+#include "utility/hash.h"
+
 using Shading::ShaderProgram;
 
-ResourceManager::ResourceManager() : lightManager(MAX_POINT_LIGHTS), mModelIndex(0)
+ResourceManager::ResourceManager() : lightManager(MAX_POINT_LIGHTS), textureCache(textureLoader), textureStreamer(textureLoader)
+{
+    // Before anything is loaded, so every asset can come from the pack
+    Assets::AssetPack::GetShared().Mount(ASSET_PACK_PATH);
+    textureLoader.SetFileWatcher(&fileWatcher);
+
+    // Each buffer takes the next binding point
+    for (const Shading::UniformBlockLayout* layout : UNIFORM_BLOCK_LAYOUTS)
+        mUniformBuffers.emplace_back(*layout);
+}
+
+ShaderProgram* ResourceManager::CreateShaderProgram(const char *vertexPath, const char *fragmentPath)
+{
+    return AddShaderProgram(vertexPath, nullptr, fragmentPath, {}, {});
+}
+
+ShaderProgram* ResourceManager::CreateShaderProgram(const char* vertexPath, const char* fragmentPath,
+    const std::initializer_list<ShaderUniformBlock> uniformBlocks, const std::initializer_list<Shading::ShaderDefine> defines)
+{
+    return AddShaderProgram(vertexPath, nullptr, fragmentPath, uniformBlocks, defines);
+}
+
+ShaderProgram * ResourceManager::CreateShaderProgram(const char *vertexPath,const char *geometryPath, const char *fragmentPath)
+{
+    return AddShaderProgram(vertexPath, geometryPath, fragmentPath, {}, {});
+}
+
+ShaderProgram * ResourceManager::CreateShaderProgram(const char *vertexPath, const char *geometryPath, const char *fragmentPath,
+    std::initializer_list<ShaderUniformBlock> uniformBlocks, const std::initializer_list<Shading::ShaderDefine> defines)
+{
+    return AddShaderProgram(vertexPath, geometryPath, fragmentPath, uniformBlocks, defines);
+}
+
+Shading::ShaderDefine ResourceManager::GetPointLightCountDefine() const
+{
+    unsigned int bucket = MIN_POINT_LIGHT_BUCKET;
+    while (bucket < lightManager.GetNumberOfPointLights() && bucket < MAX_POINT_LIGHTS)
+        bucket *= 4;
+
+    return { "POINT_LIGHT_COUNT", std::to_string(std::min(bucket, MAX_POINT_LIGHTS)) };
+}
+
+ShaderProgram* ResourceManager::AddShaderProgram(const char* vertexPath, const char* geometryPath, const char* fragmentPath,
+    const std::vector<ShaderUniformBlock>& uniformBlocks, std::vector<Shading::ShaderDefine> defines)
 {
     /*
-     * Create Matrices buffer
+     * Programs are kept by stage paths and defines, a variant asked for again is the one built the first time
      */
-    glGenBuffers(1, &mUBOMatrices);
+    std::uint64_t variantKey = Utility::HASH_SEED;
+    for (const char* path : { vertexPath, geometryPath, fragmentPath })
+        variantKey = Utility::Hash64("\n", Utility::Hash64(path != nullptr ? path : "", variantKey));
+    variantKey = Utility::Hash64(Shading::ShaderPreprocessor::DescribeDefines(defines), variantKey);
+
+    auto variant = mShaderProgramVariants.find(variantKey);
+    if (variant != mShaderProgramVariants.end())
+    {
+        BindUniformBlocks(variant->second, uniformBlocks);
+        return variant->second;
+    }
+
+    // Limits the GLSL side shares with this class come first, so variants cannot redefine them
+    defines.insert(defines.begin(), {
+        { "MAX_POINT_LIGHTS", std::to_string(MAX_POINT_LIGHTS) },
+        { "MAX_MATERIALS", std::to_string(MAX_MATERIALS) },
+        { "MAX_MATERIAL_RANGES", std::to_string(MAX_MATERIAL_RANGES) }
+    });
+
+    if (geometryPath != nullptr)
+        mShaderProgramList.push_back(std::make_unique<ShaderProgram>(vertexPath, geometryPath, fragmentPath, std::move(defines)));
+    else
+        mShaderProgramList.push_back(std::make_unique<ShaderProgram>(vertexPath, fragmentPath, std::move(defines)));
+
+    ShaderProgram* newShader = mShaderProgramList.back().get();
+    mShaderProgramVariants.emplace(variantKey, newShader);
+    BindUniformBlocks(newShader, uniformBlocks);
+
+    // Included files reload the program too
+    for (const std::string& dependencyPath : newShader->GetDependencyPaths())
+        fileWatcher.Watch(dependencyPath, [newShader] { newShader->Reload(); });
+
+    return newShader;
+}
+
+void ResourceManager::BindUniformBlocks(ShaderProgram* shader, const std::vector<ShaderUniformBlock>& uniformBlocks) const
+{
+    // Bound by the program once it links, and again after every reload
+    for (ShaderUniformBlock uniformBlock : uniformBlocks)
+        shader->BindUniformBlock(mUniformBuffers[uniformBlock]);
+}
+
+Geometry::Model ResourceManager::LoadModel(const char *modelPath, const bool isClusterCulled, const Geometry::VertexFormat vertexFormat)
+{
+    auto loadStart = std::chrono::steady_clock::now();
+    return CreateModel(modelPath, ReadModelSource(modelPath), isClusterCulled, vertexFormat, loadStart);
+}
+
+Utility::Task<Geometry::Model> ResourceManager::LoadModelAsync(const std::string modelPath, const bool isClusterCulled,
+                                                                const Geometry::VertexFormat vertexFormat)
+{
+    auto loadStart = std::chrono::steady_clock::now();
+
+    ModelSource source = co_await Utility::RunOnThreadPool(mResumeQueue, [modelPath] { return ReadModelSource(modelPath.c_str()); });
+    co_return CreateModel(modelPath.c_str(), std::move(source), isClusterCulled, vertexFormat, loadStart);
+}
+
+void ResourceManager::WaitForTextures()
+{
+    while (textureLoader.GetPendingCount() > 0)
+    {
+        Update();
+        std::this_thread::sleep_for(WAIT_INTERVAL);
+    }
+}
 
-    unsigned int matricesSize = MATRICES_COUNT * sizeof(glm::mat4);
-    glBindBuffer(GL_UNIFORM_BUFFER, mUBOMatrices);
-    glBufferData(GL_UNIFORM_BUFFER, matricesSize, nullptr, GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+void ResourceManager::WaitForShaderPrograms()
+{
+    // With parallel compiling the driver reports when it is done, other loads keep going meanwhile
+    auto isPending = [this]
+    {
+        return std::any_of(mShaderProgramList.begin(), mShaderProgramList.end(), [](const auto& shader)
+        {
+            return !shader->IsBuildComplete();
+        });
+    };
 
-    glBindBufferBase(GL_UNIFORM_BUFFER, Matrices, mUBOMatrices);
+    while (Shading::ParallelCompile::IsAvailable() && isPending())
+    {
+        Update();
+        std::this_thread::sleep_for(WAIT_INTERVAL);
+    }
 
+    WarmUpShaderPrograms();
+}
+
+void ResourceManager::WarmUpShaderPrograms()
+{
     /*
-     * Create PointLights buffer
+     * Drivers finish some programs only at their first draw, for the state they are drawn with. One draw per
+     * program, with nothing rasterized, moves that stall from the first frames to loading
      */
-    glGenBuffers(1, &mUBOPointLights);
+    if (mWarmUpVertexArray == 0)
+        glGenVertexArrays(1, &mWarmUpVertexArray);
+
+    int previousProgram, previousVertexArray;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previousVertexArray);
+    glBindVertexArray(mWarmUpVertexArray);
+    glEnable(GL_RASTERIZER_DISCARD);
+
+    for (; mWarmedUpProgramCount < mShaderProgramList.size(); ++mWarmedUpProgramCount)
+    {
+        const ShaderProgram* shader = mShaderProgramList[mWarmedUpProgramCount].get();
+        if (!shader->IsLinked())
+            continue;
 
-    unsigned int pointlightsSize = MAX_POINT_LIGHTS * sizeof(Shading::Lighting::PointLight) + sizeof(int);
-    glBindBuffer(GL_UNIFORM_BUFFER, mUBOPointLights);
-    glBufferData(GL_UNIFORM_BUFFER, pointlightsSize, nullptr, GL_DYNAMIC_DRAW);
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        // A geometry stage only takes the primitive it was written for
+        int primitive = GL_TRIANGLES;
+        if (shader->GetSourcePaths().size() == 3)
+            glGetProgramiv(shader->mID, GL_GEOMETRY_INPUT_TYPE, &primitive);
 
-    glBindBufferBase(GL_UNIFORM_BUFFER, PointLights, mUBOPointLights);
+        shader->Use();
+        glDrawArrays(primitive, 0, WARM_UP_VERTEX_COUNT);
+    }
+
+    glDisable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(previousVertexArray);
+    glUseProgram(previousProgram);
 }
 
-ShaderProgram* ResourceManager::CreateShaderProgram(const char *vertexPath, const char *fragmentPath)
+ResourceManager::ModelSource ResourceManager::ReadModelSource(const char* modelPath)
 {
-    mShaderProgramList.push_back(std::make_unique<ShaderProgram>(vertexPath, fragmentPath));
+    /*
+     * Use the baked mesh cache when it is still valid, otherwise import the source file and bake it
+     */
+    ModelSource source { Geometry::MeshCache::Open(modelPath), {} };
+    if (!source.cachedModel)
+    {
+        source.importedModel = Geometry::Model::Import(modelPath);
 
-    return mShaderProgramList.back().get();
+        // An empty bake would be served until the source changes
+        if (source.importedModel.vertices.empty())
+            std::cout << "ERROR::MODEL::IMPORT_FAILED " << modelPath << " is not cached" << std::endl;
+        else
+            Geometry::MeshCache::Write(modelPath, source.importedModel);
+    }
+
+    return source;
 }
 
-ShaderProgram* ResourceManager::CreateShaderProgram(const char* vertexPath, const char* fragmentPath,
-    const std::initializer_list<ShaderUniformBlock> uniformBlocks)
+Geometry::Model ResourceManager::CreateModel(const char* modelPath, ModelSource source, const bool isClusterCulled,
+                                             const Geometry::VertexFormat vertexFormat,
+                                             const std::chrono::steady_clock::time_point loadStart)
 {
-    mShaderProgramList.push_back(std::make_unique<ShaderProgram>(vertexPath, fragmentPath));
-    ShaderProgram* newShader = mShaderProgramList.back().get();
+    std::optional<Geometry::MeshCache::CachedModel>& cachedModel = source.cachedModel;
+    Geometry::ModelData& importedModel = source.importedModel;
+
+    std::span<const Geometry::Vertex> vertices = cachedModel ? cachedModel->vertices : std::span<const Geometry::Vertex>(importedModel.vertices);
+    std::span<const unsigned int> indices = cachedModel ? cachedModel->indices : std::span<const unsigned int>(importedModel.indices);
+    std::vector<Geometry::Material>& materials = cachedModel ? cachedModel->materials : importedModel.materials;
+    std::span<const Geometry::MeshLod> lods = cachedModel ? cachedModel->lods : std::span<const Geometry::MeshLod>(importedModel.lods);
+    unsigned int cornerCount = cachedModel ? cachedModel->cornerCount : importedModel.cornerCount;
+
+    unsigned int materialOffset = AllocateMaterials(materials.size());
+    std::vector<unsigned int> materialTextures;
+    for (std::size_t i = 0; i < materials.size(); ++i)
+    {
+        Geometry::Material& material = materials[i];
+        material.modelIndex = mModelIndex;
+        if (material.hasDiffuseMap)
+        {
+            material.diffuseMap = textureCache.AcquireStreamedTexture(material.diffuseMapPath, true);
+            materialTextures.push_back(material.diffuseMap);
+        }
+        if (material.hasSpecularMap)
+        {
+            material.specularMap = textureCache.AcquireStreamedTexture(material.specularMapPath, false);
+            materialTextures.push_back(material.specularMap);
+        }
+
+        mMaterials[materialOffset + i] = std::move(material);
+    }
+    ++mModelIndex;
 
-    int returnValue;
-    glGetProgramiv(newShader->mID, GL_ACTIVE_UNIFORM_BLOCKS, &returnValue);
+    Geometry::Model newModel = Geometry::Model(vertices, indices, lods, cornerCount, materialOffset, vertexFormat);
+    newModel.SetTextureStreaming(&textureStreamer, materialTextures);
+    newModel.SetLodSelection(&lodSelector);
+    if (isClusterCulled)
+    {
+        newModel.GetMesh()->BuildMeshlets(vertices, indices);
+        newModel.SetClusterCulling(&clusterCuller);
+    }
 
-    for (ShaderUniformBlock uniformBlock : uniformBlocks)
+    std::weak_ptr<Geometry::Mesh> mesh = newModel.GetMesh();
+    unsigned int watchId = fileWatcher.Watch(modelPath, [this, path = std::string(modelPath), mesh] { ReloadModel(path, mesh); });
+    newModel.SetOnLastCopyDestroyed([this, materialOffset, materialCount = materials.size(), materialTextures = std::move(materialTextures), watchId]
+    {
+        ReleaseModel(materialOffset, materialCount, materialTextures, watchId);
+    });
+    std::chrono::duration<double, std::milli> loadTime = std::chrono::steady_clock::now() - loadStart;
+
+    unsigned int vertexCount = newModel.GetVertexCount();
+    float weldRatio = vertexCount > 0 ? static_cast<float>(newModel.GetCornerCount()) / static_cast<float>(vertexCount) : 1.0f;
+
+    std::shared_ptr<Geometry::Mesh> loadedMesh = newModel.GetMesh();
+    std::cout << "MODEL::LOADED " << modelPath << (cachedModel ? " from cache" : "") << " in " << loadTime.count() << " ms, "
+              << newModel.GetCornerCount() << " corners welded into " << vertexCount << " vertices ("
+              << weldRatio << "x reduction), " << loadedMesh->lods.size() << " levels of detail, "
+              << loadedMesh->indexSize * 8 << "-bit indices";
+    if (loadedMesh->submeshes.size() > 1)
+        std::cout << " in " << loadedMesh->submeshes.size() << " submeshes";
+    if (loadedMesh->vertexFormat == Geometry::VertexFormat::Quantized)
+        std::cout << ", " << sizeof(Geometry::QuantizedVertex) << " byte quantized vertices";
+    if (!cachedModel)
     {
-        int uniformBlockIndex = glGetUniformBlockIndex(newShader->mID, GetUniformBlockLayoutName(uniformBlock));
-        glUniformBlockBinding(newShader->mID, uniformBlockIndex, uniformBlock);
+        const Geometry::VertexCacheStatistics& imported = importedModel.importedCacheStatistics;
+        const Geometry::VertexCacheStatistics& optimized = importedModel.optimizedCacheStatistics;
+        std::cout << ", ACMR " << imported.acmr << " -> " << optimized.acmr << ", ATVR " << imported.atvr << " -> " << optimized.atvr;
     }
+    std::cout << std::endl;
 
-    return newShader;
+    return newModel;
 }
 
-ShaderProgram * ResourceManager::CreateShaderProgram(const char *vertexPath,const char *geometryPath, const char *fragmentPath)
+void ResourceManager::Update()
 {
-    mShaderProgramList.push_back(std::make_unique<ShaderProgram>(vertexPath, geometryPath, fragmentPath));
+    mResumeQueue.ResumeAll();
+    fileWatcher.Poll();
 
-    return mShaderProgramList.back().get();
+    bool wasLoadingTextures = textureLoader.GetPendingCount() > 0;
+    textureLoader.Update();
+    textureStreamer.Update();
+
+    if (wasLoadingTextures && textureLoader.GetPendingCount() == 0)
+    {
+        Assets::TextureCacheStats stats = textureCache.GetStats();
+        std::cout << "TEXTURE_CACHE::IDLE " << stats.textureCount << " textures, " << stats.hits << " hits, "
+                  << stats.misses << " misses, " << static_cast<double>(stats.residentBytes) / (1024.0 * 1024.0)
+                  << " MB resident, " << static_cast<double>(stats.uncompressedBytes - stats.residentBytes) / (1024.0 * 1024.0)
+                  << " MB saved by block compression" << std::endl;
+    }
 }
 
-ShaderProgram * ResourceManager::CreateShaderProgram(const char *vertexPath, const char *geometryPath, const char *fragmentPath,
-    std::initializer_list<ShaderUniformBlock> uniformBlocks)
+void ResourceManager::ReloadModel(const std::string& modelPath, const std::weak_ptr<Geometry::Mesh>& mesh)
 {
-    mShaderProgramList.push_back(std::make_unique<ShaderProgram>(vertexPath, geometryPath, fragmentPath));
-    ShaderProgram* newShader = mShaderProgramList.back().get();
+    // Every copy of the model has been destroyed
+    std::shared_ptr<Geometry::Mesh> loadedMesh = mesh.lock();
+    if (!loadedMesh)
+        return;
 
-    int returnValue;
-    glGetProgramiv(newShader->mID, GL_ACTIVE_UNIFORM_BLOCKS, &returnValue);
+    auto reloadStart = std::chrono::steady_clock::now();
 
-    for (ShaderUniformBlock uniformBlock : uniformBlocks)
+    Geometry::ModelData importedModel = Geometry::Model::Import(modelPath.c_str());
+    if (importedModel.vertices.empty())
     {
-        int uniformBlockIndex = glGetUniformBlockIndex(newShader->mID, GetUniformBlockLayoutName(uniformBlock));
-        glUniformBlockBinding(newShader->mID, uniformBlockIndex, uniformBlock);
+        std::cout << "ERROR::MODEL::RELOAD_FAILED " << modelPath << " keeps its previous mesh" << std::endl;
+        return;
     }
 
-    return newShader;
+    Geometry::MeshCache::Write(modelPath.c_str(), importedModel);
+    loadedMesh->UpdateMesh(importedModel.vertices, importedModel.indices, importedModel.lods);
+
+    std::chrono::duration<double, std::milli> reloadTime = std::chrono::steady_clock::now() - reloadStart;
+    std::cout << "MODEL::RELOADED " << modelPath << " in " << reloadTime.count() << " ms, "
+              << loadedMesh->vertexCount << " vertices, ACMR " << importedModel.importedCacheStatistics.acmr << " -> "
+              << importedModel.optimizedCacheStatistics.acmr << std::endl;
 }
 
-Geometry::Model ResourceManager::LoadModel(const char *modelPath)
+unsigned int ResourceManager::AllocateMaterials(const std::size_t count)
 {
-    Geometry::Model newModel = Geometry::Model(modelPath, &mMaterials, mModelIndex++);
+    // First fit among the slots released models left, trailing ones are already gone
+    std::size_t runStart = 0;
+    for (std::size_t i = 0; i < mFreeMaterials.size() && count > 0; ++i)
+    {
+        if (!mFreeMaterials[i])
+        {
+            runStart = i + 1;
+            continue;
+        }
+
+        if (i + 1 - runStart == count)
+        {
+            std::fill(mFreeMaterials.begin() + runStart, mFreeMaterials.begin() + i + 1, false);
+            return static_cast<unsigned int>(runStart);
+        }
+    }
 
-    return newModel;
+    auto materialOffset = static_cast<unsigned int>(mMaterials.size());
+    mMaterials.resize(mMaterials.size() + count);
+    mFreeMaterials.resize(mMaterials.size(), false);
+    return materialOffset;
 }
 
-const char* ResourceManager::GetUniformBlockLayoutName(const ShaderUniformBlock uniformBlock)
+void ResourceManager::ReleaseModel(const unsigned int materialOffset, const std::size_t materialCount,
+                                   const std::vector<unsigned int>& textures, const unsigned int watchId)
 {
-    switch (uniformBlock)
+    fileWatcher.Unwatch(watchId);
+
+    for (unsigned int texture : textures)
+        textureCache.Release(texture);
+
+    for (std::size_t i = materialOffset; i < materialOffset + materialCount; ++i)
+    {
+        mMaterials[i] = {};
+        mFreeMaterials[i] = true;
+    }
+
+    while (!mFreeMaterials.empty() && mFreeMaterials.back())
     {
-        case Matrices:          return "Matrices";
-        case PointLights:       return "PointLights";
-        default:                return "";
+        mMaterials.pop_back();
+        mFreeMaterials.pop_back();
     }
 }
 
-void ResourceManager::SetMatrices(const glm::mat4& view, const glm::mat4& projection) const
+void ResourceManager::SetMatrices(const glm::mat4& view, const glm::mat4& projection)
 {
-    glm::mat4 matrices[] = { view, projection };
-    glBindBuffer(GL_UNIFORM_BUFFER, mUBOMatrices);
-    glBufferSubData(GL_UNIFORM_BUFFER, 0, 2 * sizeof(glm::mat4), matrices);
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    textureStreamer.SetView(view, projection);
+    clusterCuller.SetView(view, projection);
+    lodSelector.SetView(view, projection);
+
+    Shading::UniformBlocks::MatricesBlock matrices { view, projection };
+    mUniformBuffers[Matrices].Write(0, sizeof(matrices), &matrices);
 }
 
 void ResourceManager::SetViewMatrix(glm::mat4 view) const
 {
-    glBindBuffer(GL_UNIFORM_BUFFER, mUBOMatrices);
-    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(view));
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    mUniformBuffers[Matrices].Write(offsetof(Shading::UniformBlocks::MatricesBlock, view), sizeof(view), glm::value_ptr(view));
 }
 
 void ResourceManager::ApplyMaterials(const ShaderProgram* shader) const
 {
     shader->Use();
 
-    for (int i = 0; i < mMaterials.size(); ++i)
+    constexpr Shading::UniformName materials = "materials";
+    for (std::size_t i = 0; i < mMaterials.size(); ++i)
     {
-        std::string prefix = "materials[" + std::to_string(i) + "].";
-        shader->SetVec3(prefix + "ambientColor", mMaterials[i].ambientColor);
-        shader->SetVec3(prefix + "diffuseColor", mMaterials[i].diffuseColor);
-        shader->SetVec3(prefix + "specularColor", mMaterials[i].specularColor);
-        shader->SetVec3(prefix + "emissiveColor", mMaterials[i].emissiveColor);
+        Shading::UniformName material = materials[i];
+        shader->SetVec3(material.Member("ambientColor"), mMaterials[i].ambientColor);
+        shader->SetVec3(material.Member("diffuseColor"), mMaterials[i].diffuseColor);
+        shader->SetVec3(material.Member("specularColor"), mMaterials[i].specularColor);
+        shader->SetVec3(material.Member("emissiveColor"), mMaterials[i].emissiveColor);
 
-        shader->SetFloat(prefix + "shininess", mMaterials[i].shininess);
+        shader->SetFloat(material.Member("shininess"), mMaterials[i].shininess);
 
-        int textureIndex = i * 2;
+        int textureIndex = static_cast<int>(i) * 2;
         glActiveTexture(GL_TEXTURE0 + textureIndex);
         glBindTexture(GL_TEXTURE_2D, mMaterials[i].diffuseMap);
-        shader->SetInt(prefix + "diffuseMap", textureIndex);
-        shader->SetBool(prefix + "hasDiffuseMap", mMaterials[i].hasDiffuseMap);
+        shader->SetInt(material.Member("diffuseMap"), textureIndex);
+        shader->SetBool(material.Member("hasDiffuseMap"), mMaterials[i].hasDiffuseMap);
 
         ++textureIndex;
         glActiveTexture(GL_TEXTURE0 + textureIndex);
         glBindTexture(GL_TEXTURE_2D, mMaterials[i].specularMap);
-        shader->SetInt(prefix + "specularMap", textureIndex);
-        shader->SetBool(prefix + "hasSpecularMap", mMaterials[i].hasSpecularMap);
+        shader->SetInt(material.Member("specularMap"), textureIndex);
+        shader->SetBool(material.Member("hasSpecularMap"), mMaterials[i].hasSpecularMap);
     }
 }
 
@@ -147,11 +417,10 @@ void ResourceManager::UpdateDirectionalLight(const Shading::ShaderProgram *shade
     shader->Use();
 
     Shading::Lighting::DirectionalLight dirLight = lightManager.GetViewSpaceDirectionalLight(viewMatrix);
-    std::string prefix = "directionalLight.";
-    shader->SetVec4(prefix + "direction",   dirLight.direction);
-    shader->SetVec4(prefix + "ambient",     dirLight.ambient);
-    shader->SetVec4(prefix + "diffuse",     dirLight.diffuse);
-    shader->SetVec4(prefix + "specular",    dirLight.specular);
+    shader->SetVec4("directionalLight.direction",   dirLight.direction);
+    shader->SetVec4("directionalLight.ambient",     dirLight.ambient);
+    shader->SetVec4("directionalLight.diffuse",     dirLight.diffuse);
+    shader->SetVec4("directionalLight.specular",    dirLight.specular);
 }
 
 int ResourceManager::GetTextureCount() const
@@ -161,12 +430,13 @@ int ResourceManager::GetTextureCount() const
 
 void ResourceManager::UpdatePointLightsBuffer(const glm::mat4 &viewMatrix) const
 {
+    using Shading::UniformBlocks::PointLightsBlock;
+
     std::vector<Shading::Lighting::PointLight> pointLights = lightManager.GetViewSpacePointLights(viewMatrix);
     int numPointlights = lightManager.GetNumberOfPointLights();
 
-    unsigned int pointLightsArraySize = MAX_POINT_LIGHTS * sizeof(Shading::Lighting::PointLight);
-    glBindBuffer(GL_UNIFORM_BUFFER, mUBOPointLights);
-    glBufferSubData(GL_UNIFORM_BUFFER, 0, pointLightsArraySize, &pointLights[0]);
-    glBufferSubData(GL_UNIFORM_BUFFER, pointLightsArraySize, sizeof(int), static_cast<void*>(&numPointlights));
-    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    // The mirror's array stride is checked against every program, so only the lights in use are uploaded
+    const Shading::UniformBuffer& buffer = mUniformBuffers[PointLights];
+    buffer.Write(offsetof(PointLightsBlock, pointLights), numPointlights * sizeof(Shading::Lighting::PointLight), pointLights.data());
+    buffer.Write(offsetof(PointLightsBlock, numPointLights), sizeof(numPointlights), &numPointlights);
 }
\ No newline at end of file
@@ -1,11 +1,27 @@
 #pragma once
 
-#include <vector>
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include "shading/shader_program.h"
+#include "shading/uniform_blocks.h"
 #include "shading/lighting/light_manager.h"
 #include "geometry/model.h"
+#include "geometry/cluster_culler.h"
+#include "geometry/lod_selector.h"
+#include "geometry/mesh_cache.h"
+#include "assets/asset_pack.h"
+#include "assets/texture_loader.h"
+#include "assets/texture_cache.h"
+#include "assets/texture_streamer.h"
+#include "utility/file_watcher.h"
+#include "utility/task.h"
 
+// Blocks programs can bind, in the order of ResourceManager::UNIFORM_BLOCK_LAYOUTS
 enum ShaderUniformBlock
 {
     Matrices = 0,
@@ -17,14 +33,42 @@ class ResourceManager
 public:
     ResourceManager();
 
+    // Every program gets MAX_POINT_LIGHTS and MAX_MATERIALS defined, then its own defines. Asking for the same
+    // stages and defines again returns the program created the first time
     Shading::ShaderProgram* CreateShaderProgram(const char* vertexPath, const char* fragmentPath);
-    Shading::ShaderProgram* CreateShaderProgram(const char* vertexPath, const char* fragmentPath, std::initializer_list<ShaderUniformBlock> uniformBlocks);
+    Shading::ShaderProgram* CreateShaderProgram(const char* vertexPath, const char* fragmentPath, std::initializer_list<ShaderUniformBlock> uniformBlocks,
+                                                std::initializer_list<Shading::ShaderDefine> defines = {});
     Shading::ShaderProgram* CreateShaderProgram(const char* vertexPath, const char* geometryPath, const char* fragmentPath);
-    Shading::ShaderProgram* CreateShaderProgram(const char* vertexPath, const char* geometryPath, const char* fragmentPath, std::initializer_list<ShaderUniformBlock> uniformBlocks);
+    Shading::ShaderProgram* CreateShaderProgram(const char* vertexPath, const char* geometryPath, const char* fragmentPath, std::initializer_list<ShaderUniformBlock> uniformBlocks,
+                                                std::initializer_list<Shading::ShaderDefine> defines = {});
+    // POINT_LIGHT_COUNT for the point lights added so far, rounded up to a bucket so few variants exist. Lights
+    // added later past the bucket are not drawn by programs created with it
+    Shading::ShaderDefine GetPointLightCountDefine() const;
+
+    // The model's mesh is imported again whenever the model file is written, materials keep their first import.
+    // Cluster culled models are split into meshlets that draws test against the camera given to SetMatrices.
+    // Every model picks its level of detail against that camera too. Quantized models need a vertex shader that
+    // decodes them, default.vert (INSTANCED too) and light_space.vert do. The model's textures, materials and file
+    // watch are released with its last copy, which has to go before the ResourceManager
+    Geometry::Model LoadModel(const char* modelPath, bool isClusterCulled = false,
+                              Geometry::VertexFormat vertexFormat = Geometry::VertexFormat::Full);
+    // Reads or imports the model on the shared thread pool and creates it on the GL thread from Update, so
+    // independent loads overlap each other and texture decoding
+    Utility::Task<Geometry::Model> LoadModelAsync(std::string modelPath, bool isClusterCulled = false,
+                                                  Geometry::VertexFormat vertexFormat = Geometry::VertexFormat::Full);
 
-    Geometry::Model LoadModel(const char* modelPath);
+    // Call Update on the GL thread until the task has finished, or until every texture load has been uploaded
+    template<typename T>
+    T Wait(Utility::Task<T>& task);
+    void WaitForTextures();
+    // Finishes every program created so far and draws each once, so neither their link nor the driver's work
+    // at first draw stalls a frame. Programs finish on first use without it
+    void WaitForShaderPrograms();
 
-    void SetMatrices(const glm::mat4 &view, const glm::mat4 &projection) const;
+    // Per-frame housekeeping and hot reload of changed shaders, models and textures, call once per frame on the GL thread
+    void Update();
+
+    void SetMatrices(const glm::mat4 &view, const glm::mat4 &projection);
     void SetViewMatrix(glm::mat4 view) const;
     void ApplyMaterials(const Shading::ShaderProgram* shader) const;
     void UpdateDirectionalLight(const Shading::ShaderProgram* shader, const glm::mat4& viewMatrix) const;
@@ -33,18 +77,73 @@ public:
     int GetTextureCount() const;
 
 private:
-    static const char* GetUniformBlockLayoutName(ShaderUniformBlock uniformBlock);
+    // Everything of a model load that does not touch GL, either mapped from the mesh cache or freshly imported
+    struct ModelSource
+    {
+        std::optional<Geometry::MeshCache::CachedModel> cachedModel;
+        Geometry::ModelData importedModel;
+    };
+
+    static ModelSource ReadModelSource(const char* modelPath);
+    Geometry::Model CreateModel(const char* modelPath, ModelSource source, bool isClusterCulled, Geometry::VertexFormat vertexFormat,
+                                std::chrono::steady_clock::time_point loadStart);
+    Shading::ShaderProgram* AddShaderProgram(const char* vertexPath, const char* geometryPath, const char* fragmentPath,
+                                             const std::vector<ShaderUniformBlock>& uniformBlocks, std::vector<Shading::ShaderDefine> defines);
+    void ReloadModel(const std::string& modelPath, const std::weak_ptr<Geometry::Mesh>& mesh);
+    // Offset of count free slots in mMaterials, reusing those of released models before growing the list
+    unsigned int AllocateMaterials(std::size_t count);
+    void ReleaseModel(unsigned int materialOffset, std::size_t materialCount, const std::vector<unsigned int>& textures,
+                      unsigned int watchId);
+    void BindUniformBlocks(Shading::ShaderProgram* shader, const std::vector<ShaderUniformBlock>& uniformBlocks) const;
+    void WarmUpShaderPrograms();
 
     std::vector<std::unique_ptr<Shading::ShaderProgram>> mShaderProgramList;
+    std::unordered_map<std::uint64_t, Shading::ShaderProgram*> mShaderProgramVariants;
     std::vector<Geometry::Material> mMaterials;
+    // Slots of mMaterials released models left behind. Models keep their offset, so the list is never compacted
+    std::vector<bool> mFreeMaterials;
 
-    unsigned int mModelIndex;
-    unsigned int mUBOMatrices;
-    unsigned int mUBOPointLights;
+    unsigned int mModelIndex = 0;
+    // One per ShaderUniformBlock, in its order
+    std::vector<Shading::UniformBuffer> mUniformBuffers;
+    unsigned int mWarmUpVertexArray = 0;
+    std::size_t mWarmedUpProgramCount = 0;
 
-    static constexpr unsigned int MATRICES_COUNT = 2;
-    static constexpr unsigned int MAX_POINT_LIGHTS = 64;
+    static constexpr const Shading::UniformBlockLayout* UNIFORM_BLOCK_LAYOUTS[] =
+    {
+        &Shading::UniformBlocks::MATRICES,
+        &Shading::UniformBlocks::POINT_LIGHTS
+    };
+    static constexpr unsigned int MAX_POINT_LIGHTS = Shading::UniformBlocks::MAX_POINT_LIGHTS;
+    static constexpr unsigned int MIN_POINT_LIGHT_BUCKET = 4;
+    static constexpr unsigned int MAX_MATERIALS = 64;
+    static constexpr std::size_t MAX_MATERIAL_RANGES = Geometry::VertexQuantization::MAX_MATERIAL_RANGES;
+    static constexpr const char* ASSET_PACK_PATH = "assets.mpak";
+    static constexpr std::chrono::milliseconds WAIT_INTERVAL { 1 };
+    // Whole primitives for every geometry stage input, adjacency included
+    static constexpr int WARM_UP_VERTEX_COUNT = 12;
+
+    // Async loads continue here once their thread pool part is done
+    Utility::ResumeQueue mResumeQueue;
 
 public:
     Shading::Lighting::LightManager lightManager;
-};
\ No newline at end of file
+    Utility::FileWatcher fileWatcher;
+    Assets::TextureLoader textureLoader;
+    Assets::TextureCache textureCache;
+    Assets::TextureStreamer textureStreamer;
+    Geometry::ClusterCuller clusterCuller;
+    Geometry::LodSelector lodSelector;
+};
+
+template<typename T>
+T ResourceManager::Wait(Utility::Task<T>& task)
+{
+    while (!task.IsReady())
+    {
+        Update();
+        std::this_thread::sleep_for(WAIT_INTERVAL);
+    }
+
+    return std::move(task.GetResult());
+}
@@ -0,0 +1,62 @@
+#include "scene_layout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+std::vector<glm::mat4> SceneLayout::CreateAsteroidRing(const unsigned int amount, const float radius, const float offset,
+                                                       std::mt19937& randomEngine)
+{
+    std::uniform_int_distribution scaleDist(0, 19);
+    std::uniform_int_distribution rotationDist(0, 359);
+    std::uniform_int_distribution positionDist(0, static_cast<int>(2 * offset * 100));
+
+    std::vector<glm::mat4> modelMatrices(amount);
+    for (unsigned int i = 0; i < amount; ++i)
+    {
+        float angle = static_cast<float>(i) / static_cast<float>(amount) * 360.0f;
+        glm::mat4 model = glm::mat4(1.0f);
+
+        float displacement = positionDist(randomEngine) / 100.0f - offset;
+        float x = std::sin(angle) * radius + displacement;
+        displacement = positionDist(randomEngine) / 100.0f - offset;
+        float y = displacement * 0.02f;
+        displacement = positionDist(randomEngine) / 100.0f - offset;
+        float z = std::cos(angle) * radius + displacement;
+        model = glm::translate(model, glm::vec3(x, y, z));
+
+        float scale = scaleDist(randomEngine) / 100.0f + 0.05f;
+        model = glm::scale(model, glm::vec3(scale));
+
+        float rotAngle = rotationDist(randomEngine) % 360;
+        model = glm::rotate(model, rotAngle, glm::vec3(0.4, 0.6f, 0.8f));
+
+        modelMatrices[i] = model;
+    }
+
+    return modelMatrices;
+}
+
+void SceneLayout::SortBackToFront(const std::span<const glm::vec3> positions, const glm::vec3& cameraPosition,
+                                  std::vector<glm::vec3>& sorted)
+{
+    // Squared distances order the same and skip the square roots
+    std::vector<std::pair<float, glm::vec3>> distances;
+    distances.reserve(positions.size());
+    for (const glm::vec3& position : positions)
+    {
+        glm::vec3 toCamera = cameraPosition - position;
+        distances.emplace_back(glm::dot(toCamera, toCamera), position);
+    }
+
+    std::stable_sort(distances.begin(), distances.end(), [](const auto& a, const auto& b)
+    {
+        return a.first > b.first;
+    });
+
+    sorted.clear();
+    for (const auto& [distance, position] : distances)
+        sorted.push_back(position);
+}
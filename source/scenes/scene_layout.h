@@ -0,0 +1,18 @@
+#pragma once
+
+#include <random>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Placement and ordering of scene objects, kept free of GL so the benchmarks can run them
+namespace SceneLayout
+{
+    // Randomly displaced, scaled and rotated instances around a ring in the XZ plane, as in the space scene
+    std::vector<glm::mat4> CreateAsteroidRing(unsigned int amount, float radius, float offset, std::mt19937& randomEngine);
+
+    // Farthest first, the order transparent objects have to be blended in. Objects at the same distance keep
+    // their relative order
+    void SortBackToFront(std::span<const glm::vec3> positions, const glm::vec3& cameraPosition, std::vector<glm::vec3>& sorted);
+}
@@ -5,6 +5,7 @@
 
 #include "../../constants.h"
 #include "../../geometry/geometry_functions.h"
+#include "view_space.h"
 
 using Shading::Lighting::LightManager;
 
@@ -97,22 +98,14 @@ unsigned int LightManager::GetNumberOfPointLights() const
 std::vector<Shading::Lighting::PointLight> LightManager::GetViewSpacePointLights(const glm::mat4& viewMatrix) const
 {
     std::vector<PointLight> viewSpacePointLights = pointLights;
-
-    for (int i = 0; i < mNumPointLights; ++i)
-    {
-        glm::vec4 viewSpacePos = viewMatrix * viewSpacePointLights[i].position;
-        viewSpacePointLights[i].position = viewSpacePos;
-    }
+    ViewSpace::TransformPointLights(std::span(viewSpacePointLights).first(mNumPointLights), viewMatrix);
 
     return viewSpacePointLights;
 }
 
 Shading::Lighting::DirectionalLight LightManager::GetViewSpaceDirectionalLight(const glm::mat4& viewMatrix) const
 {
-    DirectionalLight viewSpaceDirLight = directionalLight;
-    viewSpaceDirLight.direction = viewMatrix * viewSpaceDirLight.direction;
-
-    return viewSpaceDirLight;
+    return ViewSpace::TransformDirectionalLight(directionalLight, viewMatrix);
 }
 
 glm::vec3 LightManager::GetDirectionalLightDirection() const
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <cstddef>
 #include <glm.hpp>
 
+#include "../std140.h"
+
 namespace Shading::Lighting
 {
-    struct PointLight
+    // Mirrors PointLight in point_lights.frag. std140 pads structs up to a vec4, alignas gives C++ the same size
+    struct alignas(Std140::VEC4_ALIGNMENT) PointLight
     {
         glm::vec4 position;
         glm::vec4 ambient;
@@ -14,9 +18,21 @@ namespace Shading::Lighting
         float constant;
         float linear;
         float quadratic;
-        float PADDING;
     };
 
+    inline constexpr Std140::Member POINT_LIGHT_MEMBERS[]
+    {
+        { "position",   Std140::Type::Vec4,     offsetof(PointLight, position) },
+        { "ambient",    Std140::Type::Vec4,     offsetof(PointLight, ambient) },
+        { "diffuse",    Std140::Type::Vec4,     offsetof(PointLight, diffuse) },
+        { "specular",   Std140::Type::Vec4,     offsetof(PointLight, specular) },
+        { "constant",   Std140::Type::Float,    offsetof(PointLight, constant) },
+        { "linear",     Std140::Type::Float,    offsetof(PointLight, linear) },
+        { "quadratic",  Std140::Type::Float,    offsetof(PointLight, quadratic) }
+    };
+    static_assert(Std140::IsLaidOut(POINT_LIGHT_MEMBERS), "PointLight members are not where std140 places them");
+    static_assert(sizeof(PointLight) == Std140::GetStructSize(POINT_LIGHT_MEMBERS), "PointLight size differs from std140");
+
     struct DirectionalLight
     {
         glm::vec4 direction;
@@ -0,0 +1,16 @@
+#include "view_space.h"
+
+void Shading::Lighting::ViewSpace::TransformPointLights(const std::span<PointLight> pointLights, const glm::mat4& viewMatrix)
+{
+    for (PointLight& pointLight : pointLights)
+        pointLight.position = viewMatrix * pointLight.position;
+}
+
+Shading::Lighting::DirectionalLight Shading::Lighting::ViewSpace::TransformDirectionalLight(const DirectionalLight& directionalLight,
+                                                                                           const glm::mat4& viewMatrix)
+{
+    DirectionalLight viewSpaceDirLight = directionalLight;
+    viewSpaceDirLight.direction = viewMatrix * viewSpaceDirLight.direction;
+
+    return viewSpaceDirLight;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <span>
+
+#include <glm.hpp>
+
+#include "light_structs.h"
+
+namespace Shading::Lighting
+{
+    // Per-frame light transforms, free of GL so the benchmarks can run them without a context
+    namespace ViewSpace
+    {
+        void TransformPointLights(std::span<PointLight> pointLights, const glm::mat4& viewMatrix);
+        DirectionalLight TransformDirectionalLight(const DirectionalLight& directionalLight, const glm::mat4& viewMatrix);
+    }
+}
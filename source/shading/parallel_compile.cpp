@@ -0,0 +1,65 @@
+#include "parallel_compile.h"
+
+#include <cstring>
+#include <iostream>
+
+#include <../../libraries/glad/include/glad/glad.h>
+
+namespace
+{
+    // Both extensions share their enums, the generated loader has neither
+    constexpr GLenum COMPLETION_STATUS = 0x91B1;
+    constexpr GLuint MAX_COMPILER_THREADS = 0xFFFFFFFF;
+
+    using MaxShaderCompilerThreadsProc = void (APIENTRYP)(GLuint count);
+
+    bool isAvailable = false;
+
+    bool HasExtension(const char* name)
+    {
+        int extensionCount = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+        for (int i = 0; i < extensionCount; ++i)
+        {
+            const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (extension != nullptr && std::strcmp(extension, name) == 0)
+                return true;
+        }
+
+        return false;
+    }
+}
+
+bool Shading::ParallelCompile::Initialize(void* (*loadProc)(const char* name))
+{
+    MaxShaderCompilerThreadsProc maxShaderCompilerThreads = nullptr;
+    if (HasExtension("GL_KHR_parallel_shader_compile"))
+        maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(loadProc("glMaxShaderCompilerThreadsKHR"));
+    else if (HasExtension("GL_ARB_parallel_shader_compile"))
+        maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsProc>(loadProc("glMaxShaderCompilerThreadsARB"));
+
+    isAvailable = maxShaderCompilerThreads != nullptr;
+    if (isAvailable)
+    {
+        // As many threads as the driver sees fit
+        maxShaderCompilerThreads(MAX_COMPILER_THREADS);
+    }
+
+    std::cout << "SHADER::PARALLEL_COMPILE " << (isAvailable ? "enabled" : "unavailable") << std::endl;
+    return isAvailable;
+}
+
+bool Shading::ParallelCompile::IsAvailable()
+{
+    return isAvailable;
+}
+
+bool Shading::ParallelCompile::IsProgramComplete(const unsigned int program)
+{
+    if (!isAvailable)
+        return false;
+
+    int isComplete = GL_FALSE;
+    glGetProgramiv(program, COMPLETION_STATUS, &isComplete);
+    return isComplete == GL_TRUE;
+}
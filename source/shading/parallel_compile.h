@@ -0,0 +1,19 @@
+#pragma once
+
+namespace Shading
+{
+    /*
+     * GL_KHR_parallel_shader_compile, or its ARB twin. Once enabled the driver compiles and links on its own
+     * threads, and programs can be asked whether they are done without waiting for them
+     */
+    namespace ParallelCompile
+    {
+        // Call once after GLAD is loaded. False when the driver offers neither extension
+        bool Initialize(void* (*loadProc)(const char* name));
+        bool IsAvailable();
+
+        // True once the driver has finished linking program. Always false without the extension, where only
+        // reading the link status can tell, and that waits
+        bool IsProgramComplete(unsigned int program);
+    }
+}
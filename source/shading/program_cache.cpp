@@ -0,0 +1,153 @@
+#include "program_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <../../libraries/glad/include/glad/glad.h>
+
+#include "../utility/atomic_file.h"
+#include "../utility/hash.h"
+#include "../utility/mapped_file.h"
+
+namespace
+{
+    constexpr char CACHE_MAGIC[4] = { 'M', 'P', 'R', 'G' };
+    constexpr std::uint32_t CACHE_VERSION = 1;
+    constexpr const char* CACHE_DIRECTORY = "shader_cache";
+
+    struct CacheHeader
+    {
+        char magic[4];
+        std::uint32_t version;
+        std::uint64_t key;
+        std::uint32_t binaryFormat;
+        std::uint32_t binarySize;
+    };
+
+    std::uint64_t HashDriver()
+    {
+        std::uint64_t hash = Utility::HASH_SEED;
+        for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+        {
+            const char* value = reinterpret_cast<const char*>(glGetString(name));
+            hash = Utility::Hash64(value != nullptr ? value : "", hash);
+            hash = Utility::Hash64("\n", hash);
+        }
+
+        return hash;
+    }
+}
+
+bool Shading::ProgramCache::IsSupported()
+{
+    // glGetProgramBinary is core since 4.1, drivers asked for 3.3 core usually hand out a newer context anyway
+    static const bool isSupported = []
+    {
+        if (glGetProgramBinary == nullptr || glProgramBinary == nullptr || glProgramParameteri == nullptr)
+            return false;
+
+        int formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        return formatCount > 0;
+    }();
+
+    return isSupported;
+}
+
+std::uint64_t Shading::ProgramCache::ComputeKey(const std::span<const std::string> sources)
+{
+    static const std::uint64_t driverHash = HashDriver();
+
+    std::uint64_t key = driverHash;
+    for (const std::string& source : sources)
+    {
+        // The length keeps text moved from the end of one stage to the start of the next from hashing the same
+        std::uint64_t length = source.size();
+        key = Utility::Hash64(std::string_view(reinterpret_cast<const char*>(&length), sizeof(length)), key);
+        key = Utility::Hash64(source, key);
+    }
+
+    return key;
+}
+
+std::string Shading::ProgramCache::GetCachePath(const std::span<const std::string> programNames)
+{
+    std::uint64_t pathHash = Utility::HASH_SEED;
+    for (const std::string& programName : programNames)
+        pathHash = Utility::Hash64("\n", Utility::Hash64(programName, pathHash));
+
+    char fileName[32];
+    std::snprintf(fileName, sizeof(fileName), "%016llx.mprog", static_cast<unsigned long long>(pathHash));
+    return (std::filesystem::path(CACHE_DIRECTORY) / fileName).string();
+}
+
+bool Shading::ProgramCache::Load(const unsigned int program, const std::span<const std::string> programNames,
+                                 const std::uint64_t key)
+{
+    if (!IsSupported())
+        return false;
+
+    std::string cachePath = GetCachePath(programNames);
+    Utility::MappedFile file(cachePath.c_str());
+    if (!file.IsOpen() || file.Size() < sizeof(CacheHeader))
+        return false;
+
+    CacheHeader header;
+    std::memcpy(&header, file.Data(), sizeof(CacheHeader));
+
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION
+        || header.key != key || sizeof(CacheHeader) + static_cast<std::uint64_t>(header.binarySize) > file.Size())
+        return false;
+
+    glProgramBinary(program, header.binaryFormat, file.Data() + sizeof(CacheHeader), static_cast<int>(header.binarySize));
+    return true;
+}
+
+bool Shading::ProgramCache::Write(const unsigned int program, const std::span<const std::string> programNames,
+                                  const std::uint64_t key)
+{
+    if (!IsSupported())
+        return false;
+
+    int binarySize = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+    if (binarySize <= 0)
+        return false;
+
+    std::vector<char> binary(static_cast<std::size_t>(binarySize));
+    GLenum binaryFormat;
+    glGetProgramBinary(program, binarySize, &binarySize, &binaryFormat, binary.data());
+
+    CacheHeader header {};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.binaryFormat = binaryFormat;
+    header.binarySize = static_cast<std::uint32_t>(binarySize);
+
+    std::string cachePath = GetCachePath(programNames);
+    std::error_code error;
+    std::filesystem::create_directories(CACHE_DIRECTORY, error);
+
+    bool isWritten = Utility::WriteFileAtomically(cachePath, [&](std::ofstream& cacheFile)
+    {
+        cacheFile.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
+        cacheFile.write(binary.data(), binarySize);
+        return true;
+    });
+
+    if (!isWritten)
+        std::cout << "ERROR::SHADER_CACHE::WRITE_FAILED " << cachePath << std::endl;
+
+    return isWritten;
+}
+
+void Shading::ProgramCache::PrepareForWrite(const unsigned int program)
+{
+    if (IsSupported())
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace Shading
+{
+    /*
+     * Linked programs stored as driver binaries in shader_cache/, one file per program, named by its stage paths
+     * and the defines of its variant. A file is only used when its key still matches: a hash of every stage's
+     * source and the driver's vendor, renderer and version strings, so edited shaders and driver updates both
+     * fall back to compiling
+     */
+    namespace ProgramCache
+    {
+        // False when the context offers no binary formats, every other call then does nothing
+        bool IsSupported();
+
+        // sources are the stage sources exactly as they are compiled, in stage order
+        std::uint64_t ComputeKey(std::span<const std::string> sources);
+        std::string GetCachePath(std::span<const std::string> programNames);
+
+        /*
+         * Hands the binary to the driver for program, which has to be freshly created. False when there is no
+         * matching file. Drivers may still refuse a binary whose key matches, after an update that kept the
+         * version string: the link status tells, and a refused program is left unlinked for a build from source
+         */
+        bool Load(unsigned int program, std::span<const std::string> programNames, std::uint64_t key);
+        bool Write(unsigned int program, std::span<const std::string> programNames, std::uint64_t key);
+
+        // Call before linking so the driver keeps a retrievable binary
+        void PrepareForWrite(unsigned int program);
+    }
+}
@@ -0,0 +1,151 @@
+#include "shader_preprocessor.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+
+#include "../assets/asset_pack.h"
+
+namespace
+{
+    std::string_view TrimWhitespace(std::string_view text)
+    {
+        std::size_t start = text.find_first_not_of(" \t\r");
+        if (start == std::string_view::npos)
+            return {};
+
+        std::size_t end = text.find_last_not_of(" \t\r");
+        return text.substr(start, end - start + 1);
+    }
+
+    // True when line is the directive, argument is then whatever follows it. Whitespace may surround the #
+    bool ReadDirective(std::string_view line, const std::string_view directive, std::string_view& argument)
+    {
+        line = TrimWhitespace(line);
+        if (line.empty() || line.front() != '#')
+            return false;
+
+        line = TrimWhitespace(line.substr(1));
+        if (!line.starts_with(directive))
+            return false;
+
+        // #includes is not #include
+        std::string_view rest = line.substr(directive.size());
+        if (!rest.empty() && rest.front() != ' ' && rest.front() != '\t' && rest.front() != '"')
+            return false;
+
+        argument = TrimWhitespace(rest);
+        return true;
+    }
+
+    void AppendLineDirective(std::string& source, const int line, const std::size_t fileIndex)
+    {
+        source += "#line " + std::to_string(line) + " " + std::to_string(fileIndex) + "\n";
+    }
+
+    // Copies text, numbered from firstLine, into source and expands its includes in place
+    bool Expand(const std::string_view text, const std::size_t fileIndex, const int firstLine, std::string& source,
+                std::vector<std::string>& files, const int depth)
+    {
+        if (depth > Shading::ShaderPreprocessor::MAX_INCLUDE_DEPTH)
+        {
+            std::cout << "ERROR::SHADER::INCLUDE_TOO_DEEP " << files[fileIndex] << std::endl;
+            return false;
+        }
+
+        int lineNumber = firstLine;
+        std::size_t lineStart = 0;
+        while (lineStart < text.size())
+        {
+            std::size_t lineEnd = text.find('\n', lineStart);
+            if (lineEnd == std::string_view::npos)
+                lineEnd = text.size();
+
+            std::string_view line = text.substr(lineStart, lineEnd - lineStart);
+            lineStart = lineEnd + 1;
+
+            std::string_view argument;
+            if (!ReadDirective(line, "include", argument))
+            {
+                source.append(line);
+                source += '\n';
+                ++lineNumber;
+                continue;
+            }
+
+            if (argument.size() < 2 || argument.front() != '"' || argument.back() != '"')
+            {
+                std::cout << "ERROR::SHADER::INVALID_INCLUDE " << files[fileIndex] << ":" << lineNumber << std::endl;
+                return false;
+            }
+
+            std::filesystem::path includePath = std::filesystem::path(files[fileIndex]).parent_path() / argument.substr(1, argument.size() - 2);
+            std::string includeFile = includePath.lexically_normal().generic_string();
+
+            // Each file is expanded once per stage, later includes of it are left empty
+            if (std::find(files.begin(), files.end(), includeFile) == files.end())
+            {
+                Assets::AssetFile file(includeFile);
+                if (!file.IsOpen())
+                {
+                    std::cout << "ERROR::SHADER::INCLUDE_NOT_FOUND " << includeFile << " in " << files[fileIndex] << std::endl;
+                    return false;
+                }
+
+                files.push_back(includeFile);
+                std::size_t includeIndex = files.size() - 1;
+
+                AppendLineDirective(source, 1, includeIndex);
+                if (!Expand(file.View(), includeIndex, 1, source, files, depth + 1))
+                    return false;
+            }
+
+            ++lineNumber;
+            AppendLineDirective(source, lineNumber, fileIndex);
+        }
+
+        return true;
+    }
+}
+
+bool Shading::ShaderPreprocessor::Process(const std::string& path, const std::span<const ShaderDefine> defines,
+                                          std::string& source, std::vector<std::string>& files)
+{
+    files = { path };
+    source.clear();
+
+    Assets::AssetFile file(path);
+    if (!file.IsOpen())
+    {
+        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ " << path << std::endl;
+        return false;
+    }
+
+    // GLSL wants #version before anything else, the defines follow it
+    std::string_view text = file.View();
+    std::size_t versionEnd = std::min(text.find('\n'), text.size());
+    std::string_view versionLine = text.substr(0, versionEnd);
+    std::string_view version;
+    if (!ReadDirective(versionLine, "version", version))
+    {
+        std::cout << "ERROR::SHADER::MISSING_VERSION " << path << std::endl;
+        return false;
+    }
+
+    source.append(versionLine);
+    source += '\n';
+    source += DescribeDefines(defines);
+    AppendLineDirective(source, 2, 0);
+
+    return Expand(text.substr(std::min(versionEnd + 1, text.size())), 0, 2, source, files, 0);
+}
+
+std::string Shading::ShaderPreprocessor::DescribeDefines(const std::span<const ShaderDefine> defines)
+{
+    std::string description;
+    for (const ShaderDefine& define : defines)
+        description += "#define " + define.name + " " + define.value + "\n";
+
+    return description;
+}
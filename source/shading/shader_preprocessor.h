@@ -0,0 +1,33 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Shading
+{
+    // Written as #define name value right after the #version line of every stage
+    struct ShaderDefine
+    {
+        std::string name;
+        std::string value = "1";
+    };
+
+    /*
+     * Expands #include "path" and injects defines, so shared GLSL lives in one file and one source compiles into
+     * specialized variants. Includes are resolved next to the including file and expanded once per stage. Every
+     * file gets its own #line source number, the index of its path in the returned file list, so compile errors
+     * can be traced back to it
+     */
+    namespace ShaderPreprocessor
+    {
+        constexpr int MAX_INCLUDE_DEPTH = 16;
+
+        // files receives path first, then every included file. False when a file is missing or has no #version
+        bool Process(const std::string& path, std::span<const ShaderDefine> defines, std::string& source,
+                     std::vector<std::string>& files);
+
+        // The defines as one line each, for cache keys and messages
+        std::string DescribeDefines(std::span<const ShaderDefine> defines);
+    }
+}
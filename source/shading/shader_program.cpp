@@ -1,9 +1,12 @@
 #include "shader_program.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <string>
-#include <fstream>
-#include <sstream>
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include <../../libraries/glm/glm.hpp>
 #include <../../libraries/glm/gtc/matrix_transform.hpp>
@@ -11,256 +14,674 @@
 
 #include <../../libraries/glad/include/glad/glad.h>
 
+#include "parallel_compile.h"
+#include "program_cache.h"
+#include "stage_cache.h"
+
+using Shading::ProgramBuildStats;
+using Shading::ShaderDefine;
 using Shading::ShaderProgram;
+using Shading::UniformBuffer;
+using Shading::UniformName;
+using Shading::UniformStats;
+using Shading::UniformType;
 
-ShaderProgram::ShaderProgram(const char* vertexPath, const char* fragmentPath)
+namespace
 {
-    /*
-
-        READ CODE FROM FILES
+    UniformStats uniformStats {};
+    ProgramBuildStats buildStats {};
 
-    */
-    std::string vertexCodeString;
-    std::string fragmentCodeString;
-    std::ifstream vertexShaderFile;
-    std::ifstream fragmentShaderFile;
+    // Stage i of a program with stageCount stages, the geometry stage sits in the middle when there is one
+    GLenum GetStageType(const std::size_t i, const std::size_t stageCount)
+    {
+        if (i == 0)
+            return GL_VERTEX_SHADER;
 
-    vertexShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fragmentShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        return i + 1 < stageCount ? GL_GEOMETRY_SHADER : GL_FRAGMENT_SHADER;
+    }
 
-    try
+    const char* GetStageName(const std::size_t i, const std::size_t stageCount)
     {
-        vertexShaderFile.open(vertexPath);
-        fragmentShaderFile.open(fragmentPath);
-        std::stringstream vertexShaderStream, fragmentShaderStream;
+        switch (GetStageType(i, stageCount))
+        {
+            case GL_VERTEX_SHADER:      return "VERTEX";
+            case GL_GEOMETRY_SHADER:    return "GEOMETRY";
+            default:                    return "FRAGMENT";
+        }
+    }
 
-        vertexShaderStream << vertexShaderFile.rdbuf();
-        fragmentShaderStream << fragmentShaderFile.rdbuf();
+    void ReleaseStages(const std::vector<unsigned int>& shaders)
+    {
+        for (unsigned int shader : shaders)
+            Shading::StageCache::Release(shader);
+    }
 
-        vertexShaderFile.close();
-        fragmentShaderFile.close();
+    // Number of components a uniform type holds and whether they are read and written as floats
+    struct UniformLayout
+    {
+        int componentCount;
+        bool isFloat;
+    };
 
-        vertexCodeString = vertexShaderStream.str();
-        fragmentCodeString = fragmentShaderStream.str();
-    }
-    catch (std::ifstream::failure& e)
+    UniformLayout GetUniformLayout(const GLenum type)
     {
-        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ" << std::endl;
+        switch (type)
+        {
+            case GL_FLOAT:          return { 1, true };
+            case GL_FLOAT_VEC2:     return { 2, true };
+            case GL_FLOAT_VEC3:     return { 3, true };
+            case GL_FLOAT_VEC4:     return { 4, true };
+            case GL_FLOAT_MAT2:     return { 4, true };
+            case GL_FLOAT_MAT3:     return { 9, true };
+            case GL_FLOAT_MAT4:     return { 16, true };
+            case GL_INT_VEC2:
+            case GL_BOOL_VEC2:      return { 2, false };
+            case GL_INT_VEC3:
+            case GL_BOOL_VEC3:      return { 3, false };
+            case GL_INT_VEC4:
+            case GL_BOOL_VEC4:      return { 4, false };
+            // Ints, bools and every sampler type
+            default:                return { 1, false };
+        }
     }
+}
 
-    const char* vertexShaderCodeCString = vertexCodeString.c_str();
-    const char* fragmentShaderCodeCString = fragmentCodeString.c_str();
+ShaderProgram::ShaderProgram(const char* vertexPath, const char* fragmentPath, std::vector<ShaderDefine> defines)
+    : mVertexPath(vertexPath), mFragmentPath(fragmentPath), mDefines(std::move(defines))
+{
+    mID = glCreateProgram();
+    if (!SubmitBuild(mID, mPendingBuild.emplace()))
+        mPendingBuild.reset();
+}
 
-    /*
+ShaderProgram::ShaderProgram(const char *vertexPath, const char *geometryPath, const char *fragmentPath,
+                             std::vector<ShaderDefine> defines)
+    : mVertexPath(vertexPath), mGeometryPath(geometryPath), mFragmentPath(fragmentPath), mDefines(std::move(defines))
+{
+    mID = glCreateProgram();
+    if (!SubmitBuild(mID, mPendingBuild.emplace()))
+        mPendingBuild.reset();
+}
 
-        COMPILE CODE
+ShaderProgram::~ShaderProgram()
+{
+    glDeleteProgram(mID);
 
-    */
-    unsigned int vertex, fragment;
-    int success;
-    char infoLog[512];
+    if (mPendingBuild)
+        ReleaseStages(mPendingBuild->shaders);
+    ReleaseStages(mStages);
+}
 
-    vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vertexShaderCodeCString, nullptr);
-    glCompileShader(vertex);
+bool ShaderProgram::Reload()
+{
+    // The values to carry over are those of a finished program
+    FinishBuild();
 
-    glGetShaderiv(vertex, GL_COMPILE_STATUS, &success);
-    if (!success)
+    unsigned int program = glCreateProgram();
+    PendingBuild build;
+    if (!SubmitBuild(program, build) || !CompleteBuild(program, build))
     {
-        glGetShaderInfoLog(vertex, 512, nullptr, infoLog);
-        std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-    };
+        glDeleteProgram(program);
+        ReleaseStages(build.shaders);
+        std::cout << "ERROR::SHADER::RELOAD_FAILED " << mVertexPath << " keeps its previous program" << std::endl;
+        return false;
+    }
 
-    fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fragmentShaderCodeCString, nullptr);
-    glCompileShader(fragment);
+    CopyUniforms(mID, program);
+    glDeleteProgram(mID);
+    ReleaseStages(mStages);
+    mID = program;
+    mStages = std::move(build.shaders);
+    ReflectUniforms();
+    ApplyUniformBlockBindings();
 
-    glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
-    if (!success)
+    std::cout << "SHADER::RELOADED " << mVertexPath << (mGeometryPath.empty() ? "" : ", " + mGeometryPath) << ", "
+              << mFragmentPath << std::endl;
+
+    return true;
+}
+
+std::vector<std::string> ShaderProgram::GetSourcePaths() const
+{
+    if (mGeometryPath.empty())
+        return { mVertexPath, mFragmentPath };
+
+    return { mVertexPath, mGeometryPath, mFragmentPath };
+}
+
+const std::vector<std::string>& ShaderProgram::GetDependencyPaths() const
+{
+    return mDependencyPaths;
+}
+
+bool ShaderProgram::IsBuildComplete() const
+{
+    return !mPendingBuild || Shading::ParallelCompile::IsProgramComplete(mID);
+}
+
+void ShaderProgram::FinishBuild() const
+{
+    if (!mPendingBuild)
+        return;
+
+    PendingBuild build = std::move(*mPendingBuild);
+    mPendingBuild.reset();
+
+    bool isComplete = CompleteBuild(mID, build);
+    mStages = std::move(build.shaders);
+    if (isComplete)
     {
-        glGetShaderInfoLog(vertex, 512, nullptr, infoLog);
-        std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
-    };
+        ReflectUniforms();
+        ApplyUniformBlockBindings();
+    }
+}
 
-    mID = glCreateProgram();
-    glAttachShader(mID, vertex);
-    glAttachShader(mID, fragment);
-    glLinkProgram(mID);
+bool ShaderProgram::IsLinked() const
+{
+    FinishBuild();
 
+    int success;
     glGetProgramiv(mID, GL_LINK_STATUS, &success);
-    if (!success)
+    return success;
+}
+
+void ShaderProgram::BindUniformBlock(const UniformBuffer& buffer)
+{
+    bool isBound = std::any_of(mUniformBlockBindings.begin(), mUniformBlockBindings.end(), [&](const auto& binding)
     {
-        glGetProgramInfoLog(mID, 512, nullptr, infoLog);
-        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
-    }
+        return binding.first == &buffer.GetLayout() && binding.second == buffer.GetBindingPoint();
+    });
+    if (isBound)
+        return;
+
+    mUniformBlockBindings.emplace_back(&buffer.GetLayout(), buffer.GetBindingPoint());
+    if (!mPendingBuild)
+        ApplyUniformBlockBindings();
+}
+
+void ShaderProgram::Use() const
+{
+    FinishBuild();
+    glUseProgram(mID);
+}
+
+UniformStats ShaderProgram::GetUniformStats()
+{
+    return uniformStats;
+}
 
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
+void ShaderProgram::ResetUniformStats()
+{
+    uniformStats = {};
+}
+
+ProgramBuildStats ShaderProgram::GetBuildStats()
+{
+    return buildStats;
+}
+
+void ShaderProgram::SetBool(const UniformName name, const bool value) const
+{
+    Upload(FindSlot(name, UniformType::Bool), value);
+}
+
+void ShaderProgram::SetInt(const UniformName name, const int value) const
+{
+    Upload(FindSlot(name, UniformType::Int), value);
+}
+
+void ShaderProgram::SetFloat(const UniformName name, const float value) const
+{
+    Upload(FindSlot(name, UniformType::Float), value);
+}
+
+void ShaderProgram::SetVec2(const UniformName name, const float x, const float y) const
+{
+    Upload(FindSlot(name, UniformType::Vec2), glm::vec2(x, y));
+}
+
+void ShaderProgram::SetVec2(const UniformName name, const glm::vec2 value) const
+{
+    Upload(FindSlot(name, UniformType::Vec2), value);
+}
+
+void ShaderProgram::SetVec3(const UniformName name, const float x, const float y, const float z) const
+{
+    Upload(FindSlot(name, UniformType::Vec3), glm::vec3(x, y, z));
 }
 
-ShaderProgram::ShaderProgram(const char *vertexPath, const char *geometryPath, const char *fragmentPath)
+void ShaderProgram::SetVec3(const UniformName name, const glm::vec3 value) const
 {
+    Upload(FindSlot(name, UniformType::Vec3), value);
+}
+
+void ShaderProgram::SetVec4(const UniformName name, const float x, const float y, const float z, const float w) const
+{
+    Upload(FindSlot(name, UniformType::Vec4), glm::vec4(x, y, z, w));
+}
+
+void ShaderProgram::SetVec4(const UniformName name, const glm::vec4 value) const
+{
+    Upload(FindSlot(name, UniformType::Vec4), value);
+}
+
+void ShaderProgram::SetMat4(const UniformName name, const glm::mat4& matrix) const
+{
+    Upload(FindSlot(name, UniformType::Mat4), matrix);
+}
+
+void ShaderProgram::SetIVec2Array(const UniformName name, const std::span<const glm::ivec2> values) const
+{
+    int slot = FindSlot(name, UniformType::IVec2);
+    if (slot < 0 || values.empty())
+        return;
+
+    // Elements past the end of the array are dropped, as GL does
+    const UniformSlot& uniform = mUniformSlots[slot];
+    std::size_t count = std::min(values.size(), static_cast<std::size_t>(uniform.count));
+    if (!UpdateShadowCopy(slot, values.data(), count * sizeof(glm::ivec2)))
+        return;
+
+    glUniform2iv(uniform.location, static_cast<int>(count), glm::value_ptr(values[0]));
+}
+
+bool ShaderProgram::SubmitBuild(const unsigned int program, PendingBuild& build)
+{
+    auto submitStart = std::chrono::steady_clock::now();
+
     /*
 
-        READ CODE FROM FILES
+        PREPROCESS EVERY STAGE
 
     */
-    std::string vertexCodeString;
-    std::string geometryCodeString;
-    std::string fragmentCodeString;
-    std::ifstream vertexShaderFile;
-    std::ifstream geometryShaderFile;
-    std::ifstream fragmentShaderFile;
-
-    vertexShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    geometryShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fragmentShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-    try
-    {
-        vertexShaderFile.open(vertexPath);
-        geometryShaderFile.open(geometryPath);
-        fragmentShaderFile.open(fragmentPath);
-        std::stringstream vertexShaderStream, geometryShaderStream, fragmentShaderStream;
-
-        vertexShaderStream << vertexShaderFile.rdbuf();
-        geometryShaderStream << geometryShaderFile.rdbuf();
-        fragmentShaderStream << fragmentShaderFile.rdbuf();
-
-        vertexShaderFile.close();
-        geometryShaderFile.close();
-        fragmentShaderFile.close();
-
-        vertexCodeString = vertexShaderStream.str();
-        geometryCodeString = geometryShaderStream.str();
-        fragmentCodeString = fragmentShaderStream.str();
-    }
-    catch (std::ifstream::failure& e)
+    build.stagePaths = GetSourcePaths();
+    build.sources.resize(build.stagePaths.size());
+    build.stageFiles.resize(build.stagePaths.size());
+
+    bool isRead = true;
+    for (std::size_t i = 0; i < build.stagePaths.size(); ++i)
+        isRead = Shading::ShaderPreprocessor::Process(build.stagePaths[i], mDefines, build.sources[i], build.stageFiles[i]) && isRead;
+
+    // Watched for hot reload, a missing include included
+    mDependencyPaths.clear();
+    for (const std::vector<std::string>& files : build.stageFiles)
     {
-        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ" << std::endl;
+        for (const std::string& file : files)
+        {
+            if (std::find(mDependencyPaths.begin(), mDependencyPaths.end(), file) == mDependencyPaths.end())
+                mDependencyPaths.push_back(file);
+        }
     }
 
-    const char* vertexShaderCodeCString = vertexCodeString.c_str();
-    const char* geometryShaderCodeCString = geometryCodeString.c_str();
-    const char* fragmentShaderCodeCString = fragmentCodeString.c_str();
+    if (!isRead)
+        return false;
+
+    build.cacheNames = build.stagePaths;
+    if (!mDefines.empty())
+        build.cacheNames.push_back(Shading::ShaderPreprocessor::DescribeDefines(mDefines));
 
     /*
 
-        COMPILE CODE
+        LOAD FROM THE BINARY CACHE OR COMPILE
 
     */
-    unsigned int vertex, geometry, fragment;
-    int success;
-    char infoLog[512];
+    build.cacheKey = Shading::ProgramCache::ComputeKey(build.sources);
+    build.isFromBinary = Shading::ProgramCache::Load(program, build.cacheNames, build.cacheKey);
+    if (!build.isFromBinary)
+        SubmitSourceBuild(program, build);
 
-    vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vertexShaderCodeCString, nullptr);
-    glCompileShader(vertex);
+    build.submitTime = std::chrono::steady_clock::now() - submitStart;
+    return true;
+}
 
-    glGetShaderiv(vertex, GL_COMPILE_STATUS, &success);
-    if (!success)
+void ShaderProgram::SubmitSourceBuild(const unsigned int program, PendingBuild& build) const
+{
+    // Stage paths are in stage order, with the geometry stage only when there is one
+    for (std::size_t i = 0; i < build.sources.size(); ++i)
     {
-        glGetShaderInfoLog(vertex, 512, nullptr, infoLog);
-        std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-    };
+        unsigned int shader = Shading::StageCache::Acquire(GetStageType(i, build.sources.size()), build.sources[i]);
+        glAttachShader(program, shader);
+        build.shaders.push_back(shader);
+    }
 
-    geometry = glCreateShader(GL_GEOMETRY_SHADER);
-    glShaderSource(geometry, 1, &geometryShaderCodeCString, nullptr);
-    glCompileShader(geometry);
+    Shading::ProgramCache::PrepareForWrite(program);
+    glLinkProgram(program);
+}
 
-    glGetShaderiv(geometry, GL_COMPILE_STATUS, &success);
-    if (!success)
+bool ShaderProgram::CompleteBuild(const unsigned int program, PendingBuild& build) const
+{
+    auto completeStart = std::chrono::steady_clock::now();
+    auto recordBuild = [&](unsigned int& programCount, double& milliseconds)
     {
-        glGetShaderInfoLog(geometry, 512, nullptr, infoLog);
-        std::cout << "ERROR::SHADER::GEOMETRY::COMPILATION_FAILED\n" << infoLog << std::endl;
+        programCount++;
+        milliseconds += std::chrono::duration<double, std::milli>(build.submitTime + (std::chrono::steady_clock::now() - completeStart)).count();
     };
 
-    fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fragmentShaderCodeCString, nullptr);
-    glCompileShader(fragment);
+    int success;
+    if (build.isFromBinary)
+    {
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (success)
+        {
+            recordBuild(buildStats.cachedPrograms, buildStats.cachedMilliseconds);
+            return true;
+        }
+
+        std::cout << "SHADER_CACHE::REJECTED " << Shading::ProgramCache::GetCachePath(build.cacheNames)
+                  << ", compiling from source" << std::endl;
+        build.isFromBinary = false;
+        SubmitSourceBuild(program, build);
+    }
 
-    glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
-    if (!success)
+    bool isCompiled = true;
+    for (std::size_t i = 0; i < build.shaders.size(); ++i)
     {
-        glGetShaderInfoLog(vertex, 512, nullptr, infoLog);
-        std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
-    };
+        if (Shading::StageCache::IsCompiled(build.shaders[i], GetStageName(i, build.shaders.size())))
+            continue;
 
-    mID = glCreateProgram();
-    glAttachShader(mID, vertex);
-    glAttachShader(mID, geometry);
-    glAttachShader(mID, fragment);
-    glLinkProgram(mID);
+        // Errors name files by their #line source number
+        std::cout << "ERROR::SHADER::SOURCE_FILES";
+        for (std::size_t file = 0; file < build.stageFiles[i].size(); ++file)
+            std::cout << (file > 0 ? ", " : " ") << file << " " << build.stageFiles[i][file];
+        std::cout << std::endl;
 
-    glGetProgramiv(mID, GL_LINK_STATUS, &success);
-    if (!success)
+        isCompiled = false;
+    }
+
+    /*
+
+        READ THE LINK RESULT
+
+    */
+    success = false;
+    if (isCompiled)
     {
-        glGetProgramInfoLog(mID, 512, nullptr, infoLog);
-        std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success)
+        {
+            char infoLog[512];
+            glGetProgramInfoLog(program, 512, nullptr, infoLog);
+            std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+        }
     }
 
-    glDeleteShader(vertex);
-    glDeleteShader(geometry);
-    glDeleteShader(fragment);
+    // The compiled stages belong to StageCache, other programs link them too
+    for (unsigned int shader : build.shaders)
+        glDetachShader(program, shader);
+
+    if (!success)
+        return false;
+
+    Shading::ProgramCache::Write(program, build.cacheNames, build.cacheKey);
+    recordBuild(buildStats.compiledPrograms, buildStats.compiledMilliseconds);
+    return true;
 }
 
-ShaderProgram::~ShaderProgram()
+void ShaderProgram::ApplyUniformBlockBindings() const
 {
-    glDeleteProgram(mID);
+    for (const auto& [layout, bindingPoint] : mUniformBlockBindings)
+    {
+        unsigned int blockIndex = glGetUniformBlockIndex(mID, layout->name);
+        if (blockIndex == GL_INVALID_INDEX)
+            continue;
+
+        // Bound regardless, the mismatch is reported with the program's sources to find it by
+        if (!Shading::ValidateUniformBlock(mID, blockIndex, *layout))
+            std::cout << "ERROR::SHADER::UNIFORM_BLOCK_LAYOUT " << mVertexPath << ", " << mFragmentPath << std::endl;
+
+        glUniformBlockBinding(mID, blockIndex, bindingPoint);
+    }
 }
 
-void ShaderProgram::Use() const
+void ShaderProgram::CopyUniforms(const unsigned int sourceProgram, const unsigned int destinationProgram)
 {
-    glUseProgram(mID);
+    /*
+     * Uniforms set once at setup, such as materials and sampler units, would reset to zero with a new
+     * program. Every active uniform both programs share with the same type is copied over
+     */
+    auto getActiveUniforms = [](const unsigned int program)
+    {
+        int uniformCount = 0;
+        glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+
+        std::vector<std::pair<std::string, std::pair<GLenum, int>>> uniforms;
+        for (int i = 0; i < uniformCount; ++i)
+        {
+            char name[256];
+            int size;
+            GLenum type;
+            glGetActiveUniform(program, i, sizeof(name), nullptr, &size, &type, name);
+            uniforms.emplace_back(name, std::make_pair(type, size));
+        }
+
+        return uniforms;
+    };
+
+    auto destinationUniforms = getActiveUniforms(destinationProgram);
+
+    int previousProgram;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+    glUseProgram(destinationProgram);
+
+    for (const auto& [name, typeAndSize] : getActiveUniforms(sourceProgram))
+    {
+        auto [type, size] = typeAndSize;
+        bool isShared = std::any_of(destinationUniforms.begin(), destinationUniforms.end(), [&](const auto& uniform)
+        {
+            return uniform.first == name && uniform.second.first == type;
+        });
+        if (!isShared)
+            continue;
+
+        // Arrays of plain types are reported once as name[0], their elements are located one by one
+        std::string baseName = name.ends_with("[0]") ? name.substr(0, name.size() - 3) : name;
+        UniformLayout layout = GetUniformLayout(type);
+
+        for (int element = 0; element < size; ++element)
+        {
+            std::string elementName = size > 1 ? baseName + "[" + std::to_string(element) + "]" : name;
+            int sourceLocation = glGetUniformLocation(sourceProgram, elementName.c_str());
+            int destinationLocation = glGetUniformLocation(destinationProgram, elementName.c_str());
+
+            // Members of uniform blocks have no location, their buffers are bound separately
+            if (sourceLocation < 0 || destinationLocation < 0)
+                continue;
+
+            if (layout.isFloat)
+            {
+                float values[16];
+                glGetUniformfv(sourceProgram, sourceLocation, values);
+
+                switch (type)
+                {
+                    case GL_FLOAT_MAT2:     glUniformMatrix2fv(destinationLocation, 1, GL_FALSE, values); break;
+                    case GL_FLOAT_MAT3:     glUniformMatrix3fv(destinationLocation, 1, GL_FALSE, values); break;
+                    case GL_FLOAT_MAT4:     glUniformMatrix4fv(destinationLocation, 1, GL_FALSE, values); break;
+                    case GL_FLOAT_VEC2:     glUniform2fv(destinationLocation, 1, values); break;
+                    case GL_FLOAT_VEC3:     glUniform3fv(destinationLocation, 1, values); break;
+                    case GL_FLOAT_VEC4:     glUniform4fv(destinationLocation, 1, values); break;
+                    default:                glUniform1fv(destinationLocation, 1, values); break;
+                }
+            }
+            else
+            {
+                int values[4];
+                glGetUniformiv(sourceProgram, sourceLocation, values);
+
+                switch (layout.componentCount)
+                {
+                    case 2:     glUniform2iv(destinationLocation, 1, values); break;
+                    case 3:     glUniform3iv(destinationLocation, 1, values); break;
+                    case 4:     glUniform4iv(destinationLocation, 1, values); break;
+                    default:    glUniform1iv(destinationLocation, 1, values); break;
+                }
+            }
+        }
+    }
+
+    // The source program is about to be deleted, a caller that had it bound continues with its replacement
+    glUseProgram(static_cast<unsigned int>(previousProgram) == sourceProgram ? destinationProgram : previousProgram);
+}
+
+void ShaderProgram::ReflectUniforms() const
+{
+    for (UniformSlot& slot : mUniformSlots)
+        slot = { -1, 0, 0, 0, 0 };
+    mUniformValues.clear();
+
+    auto assignSlot = [this](const std::uint64_t hash, const UniformSlot& uniform)
+    {
+        auto [slotIndex, isNew] = mUniformSlotIndices.try_emplace(hash, static_cast<int>(mUniformSlots.size()));
+        if (isNew)
+            mUniformSlots.push_back(uniform);
+        else
+            mUniformSlots[slotIndex->second] = uniform;
+    };
+
+    int uniformCount = 0;
+    glGetProgramiv(mID, GL_ACTIVE_UNIFORMS, &uniformCount);
+
+    for (int i = 0; i < uniformCount; ++i)
+    {
+        char name[256];
+        int size;
+        GLenum type;
+        glGetActiveUniform(mID, i, sizeof(name), nullptr, &size, &type, name);
+
+        // Members of uniform blocks have no location, their buffers are bound separately
+        if (glGetUniformLocation(mID, name) < 0)
+            continue;
+
+        // Arrays of plain types are reported once as name[0], every element gets a slot up to the end of the array
+        std::string_view fullName = name;
+        bool isArray = fullName.ends_with("[0]");
+        std::string_view baseName = isArray ? fullName.substr(0, fullName.size() - 3) : fullName;
+
+        UniformLayout layout = GetUniformLayout(type);
+        std::size_t elementSize = layout.componentCount * sizeof(float);
+        std::size_t valueOffset = mUniformValues.size();
+        mUniformValues.resize(valueOffset + size * elementSize);
+
+        for (int element = 0; element < size; ++element)
+        {
+            std::string elementName = isArray ? std::string(baseName) + "[" + std::to_string(element) + "]" : std::string(fullName);
+            UniformSlot uniform { glGetUniformLocation(mID, elementName.c_str()), size - element, type,
+                                  valueOffset + element * elementSize, elementSize };
+
+            // Values start as the program has them, zero or a GLSL initializer, or copied by Reload
+            unsigned char* value = mUniformValues.data() + uniform.valueOffset;
+            if (layout.isFloat)
+                glGetUniformfv(mID, uniform.location, reinterpret_cast<float*>(value));
+            else
+                glGetUniformiv(mID, uniform.location, reinterpret_cast<int*>(value));
+
+            assignSlot(Utility::Hash64(elementName), uniform);
+            if (isArray && element == 0)
+                assignSlot(Utility::Hash64(baseName), uniform);
+        }
+    }
 }
 
-void ShaderProgram::SetBool(const std::string& name, bool value) const
+int ShaderProgram::FindSlot(const UniformName name) const
 {
-    glUniform1i(glGetUniformLocation(mID, name.c_str()), (int)value);
+    FinishBuild();
+
+    auto slot = mUniformSlotIndices.find(name.GetHash());
+    if (slot == mUniformSlotIndices.end() || mUniformSlots[slot->second].location < 0)
+        return -1;
+
+    return slot->second;
 }
 
-void ShaderProgram::SetInt(const std::string& name, int value) const
+int ShaderProgram::FindSlot(const UniformName name, const UniformType type) const
 {
-    glUniform1i(glGetUniformLocation(mID, name.c_str()), value);
+    int slot = FindSlot(name);
+    if (slot < 0)
+        return -1;
+
+    GLenum uniformType = mUniformSlots[slot].type;
+    UniformLayout layout = GetUniformLayout(uniformType);
+    bool isMatching;
+    switch (type)
+    {
+        case UniformType::Bool:     isMatching = uniformType == GL_BOOL || uniformType == GL_INT; break;
+        // Samplers are set as ints
+        case UniformType::Int:      isMatching = !layout.isFloat && layout.componentCount == 1; break;
+        case UniformType::Float:    isMatching = uniformType == GL_FLOAT; break;
+        case UniformType::Vec2:     isMatching = uniformType == GL_FLOAT_VEC2; break;
+        case UniformType::Vec3:     isMatching = uniformType == GL_FLOAT_VEC3; break;
+        case UniformType::Vec4:     isMatching = uniformType == GL_FLOAT_VEC4; break;
+        case UniformType::Mat4:     isMatching = uniformType == GL_FLOAT_MAT4; break;
+        case UniformType::IVec2:    isMatching = uniformType == GL_INT_VEC2; break;
+        default:                    isMatching = false; break;
+    }
+
+    if (!isMatching)
+    {
+        std::cout << "ERROR::SHADER::UNIFORM_TYPE_MISMATCH " << mVertexPath << ", " << mFragmentPath << std::endl;
+        return -1;
+    }
+
+    return slot;
 }
 
-void ShaderProgram::SetFloat(const std::string& name, float value) const
+bool ShaderProgram::UpdateShadowCopy(const int slot, const void* value, const std::size_t size) const
 {
-    glUniform1f(glGetUniformLocation(mID, name.c_str()), value);
+    // A value larger than the uniform would spill into the next one's copy
+    const UniformSlot& uniform = mUniformSlots[slot];
+    if (size > uniform.elementSize * static_cast<std::size_t>(uniform.count))
+        return false;
+
+    unsigned char* shadowCopy = mUniformValues.data() + uniform.valueOffset;
+
+    if (std::memcmp(shadowCopy, value, size) == 0)
+    {
+        ++uniformStats.skippedCalls;
+        return false;
+    }
+
+    std::memcpy(shadowCopy, value, size);
+    ++uniformStats.issuedCalls;
+    return true;
 }
 
-void ShaderProgram::SetVec2(const std::string& name, float x, float y) const
+void ShaderProgram::Upload(const int slot, const bool value) const
 {
-    glUniform2f(glGetUniformLocation(mID, name.c_str()), x, y);
+    Upload(slot, static_cast<int>(value));
 }
 
-void ShaderProgram::SetVec2(const std::string& name, glm::vec2 value) const
+void ShaderProgram::Upload(const int slot, const int value) const
 {
-    glUniform2fv(glGetUniformLocation(mID, name.c_str()), 1, &value[0]);
+    if (slot >= 0 && UpdateShadowCopy(slot, &value, sizeof(value)))
+        glUniform1i(mUniformSlots[slot].location, value);
 }
 
-void ShaderProgram::SetVec3(const std::string& name, float x, float y, float z) const
+void ShaderProgram::Upload(const int slot, const float value) const
 {
-    glUniform3f(glGetUniformLocation(mID, name.c_str()), x, y, z);
+    if (slot >= 0 && UpdateShadowCopy(slot, &value, sizeof(value)))
+        glUniform1f(mUniformSlots[slot].location, value);
 }
 
-void ShaderProgram::SetVec3(const std::string& name, glm::vec3 value) const
+void ShaderProgram::Upload(const int slot, const glm::vec2& value) const
 {
-    glUniform3fv(glGetUniformLocation(mID, name.c_str()), 1, &value[0]);
+    if (slot >= 0 && UpdateShadowCopy(slot, glm::value_ptr(value), sizeof(value)))
+        glUniform2fv(mUniformSlots[slot].location, 1, glm::value_ptr(value));
 }
 
-void ShaderProgram::SetVec4(const std::string& name, float x, float y, float z, float w) const
+void ShaderProgram::Upload(const int slot, const glm::vec3& value) const
 {
-    glUniform4f(glGetUniformLocation(mID, name.c_str()), x, y, z, w);
+    if (slot >= 0 && UpdateShadowCopy(slot, glm::value_ptr(value), sizeof(value)))
+        glUniform3fv(mUniformSlots[slot].location, 1, glm::value_ptr(value));
 }
 
-void ShaderProgram::SetVec4(const std::string& name, glm::vec4 value) const
+void ShaderProgram::Upload(const int slot, const glm::vec4& value) const
 {
-    glUniform4fv(glGetUniformLocation(mID, name.c_str()), 1, &value[0]);
+    if (slot >= 0 && UpdateShadowCopy(slot, glm::value_ptr(value), sizeof(value)))
+        glUniform4fv(mUniformSlots[slot].location, 1, glm::value_ptr(value));
 }
 
-void ShaderProgram::SetMat4(const std::string& name, glm::mat4 matrix) const
+void ShaderProgram::Upload(const int slot, const glm::mat4& value) const
 {
-    unsigned int location = glGetUniformLocation(mID, name.c_str());
-    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+    if (slot >= 0 && UpdateShadowCopy(slot, glm::value_ptr(value), sizeof(value)))
+        glUniformMatrix4fv(mUniformSlots[slot].location, 1, GL_FALSE, glm::value_ptr(value));
 }
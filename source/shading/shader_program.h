@@ -1,34 +1,257 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 #include <../../libraries/glm/glm.hpp>
 
+#include "shader_preprocessor.h"
+#include "uniform_name.h"
+#include "uniform_buffer.h"
+#include "../utility/hash.h"
+
 namespace Shading
 {
+    enum class UniformType
+    {
+        Bool,
+        Int,
+        Float,
+        Vec2,
+        Vec3,
+        Vec4,
+        Mat4,
+        IVec2
+    };
+
+    template<typename T>
+    constexpr UniformType GetUniformType();
+
+    // A uniform of one program, resolved once. Handles stay valid across Reload, default constructed ones are ignored
+    template<typename T>
+    class UniformHandle
+    {
+    public:
+        UniformHandle() = default;
+
+        bool IsValid() const;
+
+    private:
+        friend class ShaderProgram;
+        explicit UniformHandle(int slot);
+
+        int mSlot = -1;
+    };
+
+    // glUniform calls made and left out because the program already had the value, across all programs
+    struct UniformStats
+    {
+        unsigned int issuedCalls;
+        unsigned int skippedCalls;
+    };
+
+    /*
+     * Programs built since startup, loaded from the binary cache or compiled from source. Times are what the
+     * calling thread spent submitting each build and later reading its result, failed builds are left out
+     */
+    struct ProgramBuildStats
+    {
+        unsigned int cachedPrograms;
+        unsigned int compiledPrograms;
+        double cachedMilliseconds;
+        double compiledMilliseconds;
+    };
+
     class ShaderProgram
     {
     public:
         unsigned int mID;
 
-        ShaderProgram(const char* vertexPath, const char* fragmentPath);
-        ShaderProgram(const char* vertexPath, const char* geometryPath, const char* fragmentPath);
+        /*
+         * The build is handed to the driver without waiting for it, so several programs compile at once and
+         * alongside other loading. It is finished on first use. Stages go through ShaderPreprocessor, every
+         * stage gets the defines
+         */
+        ShaderProgram(const char* vertexPath, const char* fragmentPath, std::vector<ShaderDefine> defines = {});
+        ShaderProgram(const char* vertexPath, const char* geometryPath, const char* fragmentPath,
+                      std::vector<ShaderDefine> defines = {});
         ~ShaderProgram();
 
+        // Rebuilds from the source files and swaps the new program in only when it links, uniform values carry
+        // over. On failure the previous program stays in use
+        bool Reload();
+        std::vector<std::string> GetSourcePaths() const;
+        // Stage paths and every file they include, as of the last build
+        const std::vector<std::string>& GetDependencyPaths() const;
+
+        // True once the driver is done with the build, without waiting for it. Needs parallel compiling, see
+        // ParallelCompile, otherwise only a finished build counts
+        bool IsBuildComplete() const;
+        // Waits for the build, reports its errors and finds the uniforms. Use and every setter call it first
+        void FinishBuild() const;
+        bool IsLinked() const;
+
+        // Applied whenever the program links, including after Reload, after checking the block against the
+        // buffer's mirror struct
+        void BindUniformBlock(const UniformBuffer& buffer);
+
         void Use() const;
 
-        void SetBool(const std::string& name, bool value) const;
-        void SetInt(const std::string& name, int value) const;
-        void SetFloat(const std::string& name, float value) const;
+        // Invalid when the program has no such uniform or its type does not match T
+        template<typename T>
+        UniformHandle<T> GetUniform(UniformName name) const;
+        template<typename T>
+        void Set(UniformHandle<T> handle, const T& value) const;
 
-        void SetVec2(const std::string& name, glm::vec2 value) const;
-        void SetVec2(const std::string& name, float x, float y) const;
+        /*
+         * Setters look the name up among the uniforms found after linking. Values equal to the program's current
+         * one make no GL call. Like glUniform, they write to the program in use. A uniform of another type is
+         * reported and left alone
+         */
+        void SetBool(UniformName name, bool value) const;
+        void SetInt(UniformName name, int value) const;
+        void SetFloat(UniformName name, float value) const;
 
-        void SetVec3(const std::string& name, glm::vec3 value) const;
-        void SetVec3(const std::string& name, float x, float y, float z) const;
+        void SetVec2(UniformName name, glm::vec2 value) const;
+        void SetVec2(UniformName name, float x, float y) const;
 
-        void SetVec4(const std::string& name, glm::vec4 value) const;
-        void SetVec4(const std::string& name, float x, float y, float z, float w) const;
+        void SetVec3(UniformName name, glm::vec3 value) const;
+        void SetVec3(UniformName name, float x, float y, float z) const;
 
-        void SetMat4(const std::string& name, glm::mat4 matrix) const;
+        void SetVec4(UniformName name, glm::vec4 value) const;
+        void SetVec4(UniformName name, float x, float y, float z, float w) const;
+
+        void SetMat4(UniformName name, const glm::mat4& matrix) const;
+
+        void SetIVec2Array(UniformName name, std::span<const glm::ivec2> values) const;
+
+        static UniformStats GetUniformStats();
+        // Call once per frame to get per-frame counts
+        static void ResetUniformStats();
+        static ProgramBuildStats GetBuildStats();
+
+    private:
+        // One uniform, or one array element and the ones after it
+        struct UniformSlot
+        {
+            int location;
+            int count;
+            unsigned int type;
+            // Of the shadow copy in mUniformValues
+            std::size_t valueOffset;
+            std::size_t elementSize;
+        };
+
+        // A build between being handed to the driver and its result being read
+        struct PendingBuild
+        {
+            std::vector<std::string> sources;
+            std::vector<std::string> stagePaths;
+            // Each stage's path and includes, in #line source number order
+            std::vector<std::vector<std::string>> stageFiles;
+            // Stage paths and defines, naming the program in ProgramCache
+            std::vector<std::string> cacheNames;
+            std::uint64_t cacheKey;
+            bool isFromBinary;
+            // Attached stages, shared through StageCache
+            std::vector<unsigned int> shaders;
+            std::chrono::steady_clock::duration submitTime;
+        };
+
+        /*
+         * Reads every stage and loads the program binary from ProgramCache when its key matches the current
+         * sources and driver, otherwise compiles and links. Nothing waits for the driver. False when a source
+         * is missing, program then stays unlinked but valid
+         */
+        bool SubmitBuild(unsigned int program, PendingBuild& build);
+        void SubmitSourceBuild(unsigned int program, PendingBuild& build) const;
+        // Reads the build's result, falling back to the sources when the driver refuses a binary, and stores
+        // the binary of a fresh link
+        bool CompleteBuild(unsigned int program, PendingBuild& build) const;
+        void ApplyUniformBlockBindings() const;
+        static void CopyUniforms(unsigned int sourceProgram, unsigned int destinationProgram);
+
+        // Finds every active uniform with a location and reads its current value. Names the previous program
+        // also had keep their slot, so handles survive a reload
+        void ReflectUniforms() const;
+        int FindSlot(UniformName name) const;
+        int FindSlot(UniformName name, UniformType type) const;
+        // False when the shadow copy already holds the value, otherwise the copy takes it
+        bool UpdateShadowCopy(int slot, const void* value, std::size_t size) const;
+
+        void Upload(int slot, bool value) const;
+        void Upload(int slot, int value) const;
+        void Upload(int slot, float value) const;
+        void Upload(int slot, const glm::vec2& value) const;
+        void Upload(int slot, const glm::vec3& value) const;
+        void Upload(int slot, const glm::vec4& value) const;
+        void Upload(int slot, const glm::mat4& value) const;
+
+        std::string mVertexPath;
+        std::string mGeometryPath;
+        std::string mFragmentPath;
+        std::vector<ShaderDefine> mDefines;
+        std::vector<std::string> mDependencyPaths;
+
+        // Filled in when the build finishes, which first use may trigger
+        mutable std::optional<PendingBuild> mPendingBuild;
+        // Stages the program in mID was compiled from, held in StageCache until it is deleted or replaced
+        mutable std::vector<unsigned int> mStages;
+        mutable std::vector<UniformSlot> mUniformSlots;
+        mutable std::unordered_map<std::uint64_t, int> mUniformSlotIndices;
+        mutable std::vector<unsigned char> mUniformValues;
+
+        std::vector<std::pair<const UniformBlockLayout*, unsigned int>> mUniformBlockBindings;
     };
-}
\ No newline at end of file
+
+    template<typename T>
+    constexpr UniformType GetUniformType()
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return UniformType::Bool;
+        else if constexpr (std::is_same_v<T, int>)
+            return UniformType::Int;
+        else if constexpr (std::is_same_v<T, float>)
+            return UniformType::Float;
+        else if constexpr (std::is_same_v<T, glm::vec2>)
+            return UniformType::Vec2;
+        else if constexpr (std::is_same_v<T, glm::vec3>)
+            return UniformType::Vec3;
+        else if constexpr (std::is_same_v<T, glm::vec4>)
+            return UniformType::Vec4;
+        else
+        {
+            static_assert(std::is_same_v<T, glm::mat4>, "No uniform type matches T");
+            return UniformType::Mat4;
+        }
+    }
+
+    template<typename T>
+    UniformHandle<T>::UniformHandle(const int slot) : mSlot(slot) {}
+
+    template<typename T>
+    bool UniformHandle<T>::IsValid() const
+    {
+        return mSlot >= 0;
+    }
+
+    template<typename T>
+    UniformHandle<T> ShaderProgram::GetUniform(const UniformName name) const
+    {
+        return UniformHandle<T>(FindSlot(name, GetUniformType<T>()));
+    }
+
+    template<typename T>
+    void ShaderProgram::Set(const UniformHandle<T> handle, const T& value) const
+    {
+        if (handle.IsValid())
+            Upload(handle.mSlot, value);
+    }
+}
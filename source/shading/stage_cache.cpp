@@ -0,0 +1,121 @@
+#include "stage_cache.h"
+
+#include <chrono>
+#include <iostream>
+#include <unordered_map>
+
+#include <../../libraries/glad/include/glad/glad.h>
+
+#include "../utility/hash.h"
+
+namespace
+{
+    struct CachedStage
+    {
+        unsigned int shader;
+        double compileMilliseconds;
+        // Acquires not yet released
+        unsigned int holders;
+        bool isChecked;
+        bool isCompiled;
+    };
+
+    std::unordered_map<std::uint64_t, CachedStage> cachedStages;
+    // Shader object to its key in cachedStages
+    std::unordered_map<unsigned int, std::uint64_t> stageKeys;
+    Shading::StageCacheStats stats {};
+
+    std::uint64_t GetStageKey(const unsigned int stageType, const std::string& source)
+    {
+        std::uint64_t key = Utility::Hash64(std::string_view(reinterpret_cast<const char*>(&stageType), sizeof(stageType)));
+        return Utility::Hash64(source, key);
+    }
+}
+
+unsigned int Shading::StageCache::Acquire(const unsigned int stageType, const std::string& source)
+{
+    std::uint64_t key = GetStageKey(stageType, source);
+    auto cachedStage = cachedStages.find(key);
+    if (cachedStage != cachedStages.end())
+    {
+        cachedStage->second.holders++;
+        stats.sharedStages++;
+        stats.savedMilliseconds += cachedStage->second.compileMilliseconds;
+        return cachedStage->second.shader;
+    }
+
+    auto compileStart = std::chrono::steady_clock::now();
+
+    unsigned int shader = glCreateShader(stageType);
+    const char* codeCString = source.c_str();
+    glShaderSource(shader, 1, &codeCString, nullptr);
+    glCompileShader(shader);
+
+    double compileMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compileStart).count();
+    cachedStages.emplace(key, CachedStage { shader, compileMilliseconds, 1, false, false });
+    stageKeys.emplace(shader, key);
+
+    stats.compiledStages++;
+    stats.compileMilliseconds += compileMilliseconds;
+    return shader;
+}
+
+void Shading::StageCache::Release(const unsigned int shader)
+{
+    auto stageKey = stageKeys.find(shader);
+    if (stageKey == stageKeys.end())
+        return;
+
+    auto cachedStage = cachedStages.find(stageKey->second);
+    if (--cachedStage->second.holders > 0)
+        return;
+
+    glDeleteShader(shader);
+    cachedStages.erase(cachedStage);
+    stageKeys.erase(stageKey);
+}
+
+bool Shading::StageCache::IsCompiled(const unsigned int shader, const char* stageName)
+{
+    auto stageKey = stageKeys.find(shader);
+    if (stageKey == stageKeys.end())
+        return false;
+
+    CachedStage& stage = cachedStages.at(stageKey->second);
+    if (stage.isChecked)
+        return stage.isCompiled;
+
+    // Without parallel compiling the driver usually compiles here, the wait counts as compile time
+    auto checkStart = std::chrono::steady_clock::now();
+
+    int success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        char infoLog[512];
+        glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+        std::cout << "ERROR::SHADER::" << stageName << "::COMPILATION_FAILED\n" << infoLog << std::endl;
+    }
+
+    double checkMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - checkStart).count();
+    stage.compileMilliseconds += checkMilliseconds;
+    stats.compileMilliseconds += checkMilliseconds;
+
+    stage.isChecked = true;
+    stage.isCompiled = success;
+    return stage.isCompiled;
+}
+
+void Shading::StageCache::Clear()
+{
+    for (const auto& [key, cachedStage] : cachedStages)
+        glDeleteShader(cachedStage.shader);
+
+    cachedStages.clear();
+    stageKeys.clear();
+}
+
+Shading::StageCacheStats Shading::StageCache::GetStats()
+{
+    return stats;
+}
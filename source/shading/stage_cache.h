@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Shading
+{
+    /*
+     * Stages compiled since startup, and how much compile time reusing a compiled stage instead has saved. Times
+     * are what the calling thread spent submitting a stage and waiting for its status
+     */
+    struct StageCacheStats
+    {
+        unsigned int compiledStages;
+        unsigned int sharedStages;
+        double compileMilliseconds;
+        double savedMilliseconds;
+    };
+
+    /*
+     * Compiled shader objects shared by every program that links the same stage. Stages are keyed by stage type
+     * and a hash of their source as compiled, so defines written into the source select their own entry and an
+     * edited file compiles again. Each Acquire holds the stage until a matching Release, a stage nothing holds
+     * any more is deleted
+     */
+    namespace StageCache
+    {
+        // The cached shader object, handed to the driver for compiling on first use without waiting for it.
+        // Detach the object after linking and leave deleting it to the cache
+        unsigned int Acquire(unsigned int stageType, const std::string& source);
+        // Call once the program holding the stage is deleted or replaced, stages unknown to the cache are ignored
+        void Release(unsigned int shader);
+        // Waits for the stage's first compile and reports its errors once. Stages that failed stay cached while
+        // held, the same source would only fail again
+        bool IsCompiled(unsigned int shader, const char* stageName);
+
+        // Deletes every cached shader object, held or not, call while the context is still current
+        void Clear();
+
+        StageCacheStats GetStats();
+    }
+}
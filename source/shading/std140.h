@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace Shading::Std140
+{
+    enum class Type
+    {
+        Int,
+        Float,
+        Vec2,
+        Vec3,
+        Vec4,
+        Mat4,
+        Struct
+    };
+
+    /*
+     * One member of a C++ struct mirroring a std140 GLSL block or struct. name is the GLSL member name, offset
+     * the C++ offsetof. Struct members list their own members, arrays give their element count
+     */
+    struct Member
+    {
+        const char* name;
+        Type type;
+        std::size_t offset;
+        std::size_t arraySize = 0;
+        std::span<const Member> structMembers = {};
+    };
+
+    constexpr std::size_t VEC4_ALIGNMENT = 16;
+
+    constexpr std::size_t AlignUp(const std::size_t value, const std::size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    constexpr std::size_t GetStructSize(std::span<const Member> members);
+
+    constexpr std::size_t GetElementSize(const Member& member)
+    {
+        switch (member.type)
+        {
+            case Type::Int:     return 4;
+            case Type::Float:   return 4;
+            case Type::Vec2:    return 8;
+            case Type::Vec3:    return 12;
+            case Type::Vec4:    return 16;
+            case Type::Mat4:    return 64;
+            case Type::Struct:  return GetStructSize(member.structMembers);
+        }
+
+        return 0;
+    }
+
+    // Structs and arrays align like a vec4, vec3 does too
+    constexpr std::size_t GetBaseAlignment(const Member& member)
+    {
+        if (member.arraySize > 0 || member.type == Type::Struct || member.type == Type::Vec3
+            || member.type == Type::Vec4 || member.type == Type::Mat4)
+            return VEC4_ALIGNMENT;
+
+        return member.type == Type::Vec2 ? 8 : 4;
+    }
+
+    // Array elements are padded to a vec4 each, a float[4] takes 64 bytes
+    constexpr std::size_t GetArrayStride(const Member& member)
+    {
+        return AlignUp(GetElementSize(member), VEC4_ALIGNMENT);
+    }
+
+    constexpr std::size_t GetSize(const Member& member)
+    {
+        return member.arraySize > 0 ? GetArrayStride(member) * member.arraySize : GetElementSize(member);
+    }
+
+    // Where the last member ends. Does not round up, a block may end mid-vec4
+    constexpr std::size_t GetEnd(const std::span<const Member> members)
+    {
+        return members.empty() ? 0 : members.back().offset + GetSize(members.back());
+    }
+
+    // A struct inside a block is padded up to a vec4, arrays of it have that stride
+    constexpr std::size_t GetStructSize(const std::span<const Member> members)
+    {
+        return AlignUp(GetEnd(members), VEC4_ALIGNMENT);
+    }
+
+    // True when every offset is where std140 places the member, each right after the previous one
+    constexpr bool IsLaidOut(const std::span<const Member> members)
+    {
+        std::size_t end = 0;
+        for (const Member& member : members)
+        {
+            if (member.offset != AlignUp(end, GetBaseAlignment(member)))
+                return false;
+            if (member.type == Type::Struct && !IsLaidOut(member.structMembers))
+                return false;
+
+            end = member.offset + GetSize(member);
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <glm.hpp>
+
+#include "std140.h"
+#include "uniform_buffer.h"
+#include "lighting/light_structs.h"
+
+/*
+ * C++ mirrors of the std140 uniform blocks the shaders share. A mirror that breaks std140 fails to compile, and
+ * ValidateUniformBlock checks the GLSL side every time a program binding the block links. A new block needs a
+ * mirror, its members and a layout here
+ */
+namespace Shading::UniformBlocks
+{
+    // Defined as MAX_POINT_LIGHTS in every shader
+    constexpr unsigned int MAX_POINT_LIGHTS = 64;
+
+    struct MatricesBlock
+    {
+        glm::mat4 view;
+        glm::mat4 projection;
+    };
+
+    inline constexpr Std140::Member MATRICES_MEMBERS[]
+    {
+        { "view",       Std140::Type::Mat4,     offsetof(MatricesBlock, view) },
+        { "projection", Std140::Type::Mat4,     offsetof(MatricesBlock, projection) }
+    };
+    static_assert(Std140::IsLaidOut(MATRICES_MEMBERS), "MatricesBlock members are not where std140 places them");
+    static_assert(sizeof(MatricesBlock) >= Std140::GetEnd(MATRICES_MEMBERS), "MatricesBlock is smaller than its block");
+
+    inline constexpr UniformBlockLayout MATRICES { "Matrices", sizeof(MatricesBlock), MATRICES_MEMBERS };
+
+    struct PointLightsBlock
+    {
+        Lighting::PointLight pointLights[MAX_POINT_LIGHTS];
+        int numPointLights;
+    };
+
+    inline constexpr Std140::Member POINT_LIGHTS_MEMBERS[]
+    {
+        { "pointLights",    Std140::Type::Struct,   offsetof(PointLightsBlock, pointLights), MAX_POINT_LIGHTS, Lighting::POINT_LIGHT_MEMBERS },
+        { "numPointLights", Std140::Type::Int,      offsetof(PointLightsBlock, numPointLights) }
+    };
+    static_assert(Std140::IsLaidOut(POINT_LIGHTS_MEMBERS), "PointLightsBlock members are not where std140 places them");
+    static_assert(sizeof(PointLightsBlock) >= Std140::GetEnd(POINT_LIGHTS_MEMBERS), "PointLightsBlock is smaller than its block");
+
+    inline constexpr UniformBlockLayout POINT_LIGHTS { "PointLights", sizeof(PointLightsBlock), POINT_LIGHTS_MEMBERS };
+}
@@ -0,0 +1,211 @@
+#include "uniform_buffer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <../../libraries/glad/include/glad/glad.h>
+
+using Shading::UniformBlockLayout;
+using Shading::UniformBuffer;
+
+namespace
+{
+    // Binding points are handed out in creation order and never reused
+    unsigned int nextBindingPoint = 0;
+
+    // What a reflected block member should look like according to the mirror
+    struct MirrorMember
+    {
+        std::size_t offset;
+        std::size_t arrayStride;
+        std::size_t matrixStride;
+        GLenum type;
+    };
+
+    GLenum GetGLType(const Shading::Std140::Type type)
+    {
+        switch (type)
+        {
+            case Shading::Std140::Type::Int:    return GL_INT;
+            case Shading::Std140::Type::Float:  return GL_FLOAT;
+            case Shading::Std140::Type::Vec2:   return GL_FLOAT_VEC2;
+            case Shading::Std140::Type::Vec3:   return GL_FLOAT_VEC3;
+            case Shading::Std140::Type::Vec4:   return GL_FLOAT_VEC4;
+            case Shading::Std140::Type::Mat4:   return GL_FLOAT_MAT4;
+            default:                            return GL_NONE;
+        }
+    }
+
+    /*
+     * Walks a reflected name such as "pointLights[5].position" through the mirror's members. Arrays of plain
+     * types are reflected once as name[0] and described by their stride. Empty when the mirror has no such
+     * member or the index is past its array
+     */
+    std::optional<MirrorMember> FindMirrorMember(std::span<const Shading::Std140::Member> members, std::string_view name)
+    {
+        std::size_t offset = 0;
+        while (true)
+        {
+            std::string_view memberName = name.substr(0, name.find_first_of("[."));
+            name.remove_prefix(memberName.size());
+
+            auto member = std::find_if(members.begin(), members.end(), [memberName](const Shading::Std140::Member& candidate)
+            {
+                return memberName == candidate.name;
+            });
+            if (member == members.end())
+                return std::nullopt;
+
+            offset += member->offset;
+
+            bool isArray = name.starts_with('[');
+            if (isArray)
+            {
+                std::size_t indexEnd = name.find(']');
+                std::size_t index = 0;
+                if (indexEnd == std::string_view::npos
+                    || std::from_chars(name.data() + 1, name.data() + indexEnd, index).ptr != name.data() + indexEnd
+                    || index >= member->arraySize)
+                    return std::nullopt;
+
+                offset += index * Shading::Std140::GetArrayStride(*member);
+                name.remove_prefix(indexEnd + 1);
+            }
+            else if (member->arraySize > 0)
+                return std::nullopt;
+
+            if (member->type != Shading::Std140::Type::Struct)
+            {
+                if (!name.empty())
+                    return std::nullopt;
+
+                std::size_t arrayStride = isArray ? Shading::Std140::GetArrayStride(*member) : 0;
+                std::size_t matrixStride = member->type == Shading::Std140::Type::Mat4 ? Shading::Std140::VEC4_ALIGNMENT : 0;
+                return MirrorMember { offset, arrayStride, matrixStride, GetGLType(member->type) };
+            }
+
+            if (!name.starts_with('.'))
+                return std::nullopt;
+
+            name.remove_prefix(1);
+            members = member->structMembers;
+        }
+    }
+}
+
+UniformBuffer::UniformBuffer(const UniformBlockLayout& layout) : mLayout(&layout), mBuffer(0), mBindingPoint(nextBindingPoint++)
+{
+    int maxBindingPoints = 0;
+    glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &maxBindingPoints);
+    if (mBindingPoint >= static_cast<unsigned int>(maxBindingPoints))
+        std::cout << "ERROR::UNIFORM_BUFFER::OUT_OF_BINDING_POINTS " << layout.name << " needs binding point "
+                  << mBindingPoint << ", the context has " << maxBindingPoints << std::endl;
+
+    glGenBuffers(1, &mBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, mBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(layout.size), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, mBindingPoint, mBuffer);
+}
+
+void UniformBuffer::Write(const std::size_t offset, const std::size_t size, const void* data) const
+{
+    glBindBuffer(GL_UNIFORM_BUFFER, mBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+const UniformBlockLayout& UniformBuffer::GetLayout() const
+{
+    return *mLayout;
+}
+
+unsigned int UniformBuffer::GetBindingPoint() const
+{
+    return mBindingPoint;
+}
+
+bool Shading::ValidateUniformBlock(const unsigned int program, const unsigned int blockIndex, const UniformBlockLayout& layout)
+{
+    if (blockIndex == GL_INVALID_INDEX)
+        return true;
+
+    bool isMatching = true;
+
+    int dataSize = 0;
+    glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+    if (static_cast<std::size_t>(dataSize) > layout.size)
+    {
+        std::cout << "ERROR::SHADER::UNIFORM_BLOCK_MISMATCH " << layout.name << " is " << dataSize
+                  << " bytes in GLSL, its C++ mirror " << layout.size << std::endl;
+        isMatching = false;
+    }
+
+    /*
+
+        COMPARE MEMBERS
+
+    */
+    int memberCount = 0;
+    glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &memberCount);
+    if (memberCount == 0)
+        return isMatching;
+
+    std::vector<int> memberIndices(memberCount);
+    glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, memberIndices.data());
+    const GLuint* indices = reinterpret_cast<const GLuint*>(memberIndices.data());
+
+    std::vector<int> offsets(memberCount), arrayStrides(memberCount), matrixStrides(memberCount), types(memberCount);
+    glGetActiveUniformsiv(program, memberCount, indices, GL_UNIFORM_OFFSET, offsets.data());
+    glGetActiveUniformsiv(program, memberCount, indices, GL_UNIFORM_ARRAY_STRIDE, arrayStrides.data());
+    glGetActiveUniformsiv(program, memberCount, indices, GL_UNIFORM_MATRIX_STRIDE, matrixStrides.data());
+    glGetActiveUniformsiv(program, memberCount, indices, GL_UNIFORM_TYPE, types.data());
+
+    // Arrays of structs reflect every element, a wrong member would repeat once per element
+    unsigned int mismatchCount = 0;
+    for (int i = 0; i < memberCount; ++i)
+    {
+        char name[256];
+        glGetActiveUniformName(program, indices[i], sizeof(name), nullptr, name);
+
+        // Instance named blocks prefix their members with the block name
+        std::string_view memberName = name;
+        if (memberName.starts_with(layout.name) && memberName.size() > std::strlen(layout.name)
+            && memberName[std::strlen(layout.name)] == '.')
+            memberName.remove_prefix(std::strlen(layout.name) + 1);
+
+        std::optional<MirrorMember> expected = FindMirrorMember(layout.members, memberName);
+        bool isMismatch = !expected
+            || static_cast<std::size_t>(offsets[i]) != expected->offset
+            || static_cast<std::size_t>(arrayStrides[i]) != expected->arrayStride
+            || static_cast<std::size_t>(matrixStrides[i]) != expected->matrixStride
+            || static_cast<GLenum>(types[i]) != expected->type;
+        if (!isMismatch)
+            continue;
+
+        if (mismatchCount++ > 0)
+            continue;
+
+        if (!expected)
+            std::cout << "ERROR::SHADER::UNIFORM_BLOCK_MISMATCH " << layout.name << "." << memberName
+                      << " has no member in the C++ mirror" << std::endl;
+        else
+            std::cout << "ERROR::SHADER::UNIFORM_BLOCK_MISMATCH " << layout.name << "." << memberName << " GLSL offset "
+                      << offsets[i] << ", array stride " << arrayStrides[i] << ", matrix stride " << matrixStrides[i]
+                      << ", type 0x" << std::hex << types[i] << std::dec << ", C++ mirror offset " << expected->offset
+                      << ", array stride " << expected->arrayStride << ", matrix stride " << expected->matrixStride
+                      << ", type 0x" << std::hex << expected->type << std::dec << std::endl;
+    }
+
+    if (mismatchCount > 1)
+        std::cout << "ERROR::SHADER::UNIFORM_BLOCK_MISMATCH " << layout.name << " " << mismatchCount - 1
+                  << " more mismatched members" << std::endl;
+
+    return isMatching && mismatchCount == 0;
+}
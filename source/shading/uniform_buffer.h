@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "std140.h"
+
+namespace Shading
+{
+    // A std140 uniform block as its C++ mirror struct lays it out. size is the mirror's sizeof
+    struct UniformBlockLayout
+    {
+        const char* name;
+        std::size_t size;
+        std::span<const Std140::Member> members;
+    };
+
+    /*
+     * The buffer behind one uniform block, sized by its mirror struct and bound to the next free binding point
+     * when created, so blocks need no hand-picked binding points. Programs link to it through
+     * ShaderProgram::BindUniformBlock
+     */
+    class UniformBuffer
+    {
+    public:
+        explicit UniformBuffer(const UniformBlockLayout& layout);
+
+        // offset and size come from the mirror struct, which matches the block in every program it is bound to
+        void Write(std::size_t offset, std::size_t size, const void* data) const;
+
+        const UniformBlockLayout& GetLayout() const;
+        unsigned int GetBindingPoint() const;
+
+    private:
+        const UniformBlockLayout* mLayout;
+        unsigned int mBuffer;
+        unsigned int mBindingPoint;
+    };
+
+    /*
+     * Compares the block as program linked it with layout: every active member's offset, array and matrix
+     * stride and type, and the block's size. Mismatches are reported and make it return false, a block the
+     * program does not use counts as matching
+     */
+    bool ValidateUniformBlock(unsigned int program, unsigned int blockIndex, const UniformBlockLayout& layout);
+}
@@ -0,0 +1,31 @@
+#include "uniform_name.h"
+
+#include <charconv>
+
+using Shading::UniformName;
+
+UniformName::UniformName(const std::string& name) : mHash(Utility::Hash64(name)) {}
+
+UniformName::UniformName(const std::string_view name) : mHash(Utility::Hash64(name)) {}
+
+UniformName::UniformName(const std::uint64_t hash, Hashed) : mHash(hash) {}
+
+UniformName UniformName::operator[](const unsigned int index) const
+{
+    char digits[16];
+    auto [end, error] = std::to_chars(digits, digits + sizeof(digits), index);
+
+    std::uint64_t hash = Utility::Hash64("[", mHash);
+    hash = Utility::Hash64(std::string_view(digits, end - digits), hash);
+    return { Utility::Hash64("]", hash), Hashed {} };
+}
+
+UniformName UniformName::Member(const std::string_view member) const
+{
+    return { Utility::Hash64(member, Utility::Hash64(".", mHash)), Hashed {} };
+}
+
+std::uint64_t UniformName::GetHash() const
+{
+    return mHash;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "../utility/hash.h"
+
+namespace Shading
+{
+    /*
+     * Hash of a uniform's full name, such as "materials[3].diffuseColor". String literals are hashed at compile
+     * time, and array elements and struct members extend a hash without building the longer name
+     */
+    class UniformName
+    {
+    public:
+        template<std::size_t N>
+        consteval UniformName(const char (&name)[N]) : mHash(Utility::Hash64(std::string_view(name, N - 1))) {}
+        UniformName(const std::string& name);
+        explicit UniformName(std::string_view name);
+
+        // name[index]
+        UniformName operator[](unsigned int index) const;
+        // name.member
+        UniformName Member(std::string_view member) const;
+
+        std::uint64_t GetHash() const;
+
+    private:
+        struct Hashed {};
+        UniformName(std::uint64_t hash, Hashed);
+
+        std::uint64_t mHash;
+    };
+}
@@ -0,0 +1,24 @@
+#include "atomic_file.h"
+
+#include <filesystem>
+
+bool Utility::WriteFileAtomically(const std::string& path, const std::function<bool(std::ofstream&)>& writer)
+{
+    std::string temporaryPath = path + ".tmp";
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+    bool isWritten = file.is_open() && writer(file);
+    file.close();
+
+    std::error_code error;
+    if (isWritten && !file.fail())
+        std::filesystem::rename(temporaryPath, path, error);
+
+    if (!isWritten || file.fail() || error)
+    {
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <fstream>
+#include <functional>
+#include <string>
+
+namespace Utility
+{
+    /*
+     * Writes path through a temporary file beside it, which replaces path only once writer returned true and
+     * every write succeeded, so a crash or failed write never leaves a truncated file behind. False otherwise,
+     * with the temporary file removed and path untouched. Reporting the failure is left to the caller
+     */
+    bool WriteFileAtomically(const std::string& path, const std::function<bool(std::ofstream&)>& writer);
+}
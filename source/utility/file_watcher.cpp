@@ -0,0 +1,180 @@
+#include "file_watcher.h"
+
+#include <filesystem>
+#include <iostream>
+#include <unordered_set>
+#include <utility>
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using Utility::FileWatcher;
+
+#ifdef __linux__
+
+FileWatcher::FileWatcher()
+{
+    mFileDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (mFileDescriptor < 0)
+        std::cout << "ERROR::FILE_WATCHER::INOTIFY_NOT_AVAILABLE hot reload is disabled" << std::endl;
+}
+
+FileWatcher::~FileWatcher()
+{
+    if (mFileDescriptor >= 0)
+        close(mFileDescriptor);
+}
+
+unsigned int FileWatcher::Watch(const std::string& path, std::function<void()> onChange)
+{
+    std::string canonicalPath = GetCanonicalPath(path);
+
+    // Adding a directory twice returns its existing descriptor, so every directory is watched once
+    if (mFileDescriptor >= 0)
+    {
+        std::string directory = std::filesystem::path(canonicalPath).parent_path().string();
+        int watchDescriptor = inotify_add_watch(mFileDescriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        // Files served from the asset pack have no directory on disk, there is nothing to reload them from
+        if (watchDescriptor >= 0)
+            mDirectories[watchDescriptor] = directory;
+        else if (errno != ENOENT)
+            std::cout << "ERROR::FILE_WATCHER::DIRECTORY_NOT_WATCHED " << directory << std::endl;
+    }
+
+    unsigned int watchId = mNextWatchId++;
+    mFiles.emplace(watchId, WatchedFile { canonicalPath, std::move(onChange), GetModifiedTime(canonicalPath) });
+
+    return watchId;
+}
+
+void FileWatcher::Poll()
+{
+    if (mFileDescriptor < 0)
+        return;
+
+    std::unordered_set<std::string> changedPaths;
+    bool hasOverflowed = false;
+
+    alignas(inotify_event) char buffer[4096];
+    while (true)
+    {
+        ssize_t length = read(mFileDescriptor, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        for (ssize_t offset = 0; offset < length;)
+        {
+            auto event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW)
+                hasOverflowed = true;
+
+            auto directory = mDirectories.find(event->wd);
+            if (event->len > 0 && directory != mDirectories.end())
+                changedPaths.insert((std::filesystem::path(directory->second) / event->name).string());
+        }
+    }
+
+    if (changedPaths.empty() && !hasOverflowed)
+        return;
+
+    // Callbacks may watch or unwatch files, so they run after the changed files have been collected. A close
+    // after writing without changing anything keeps the modification time and is not reported
+    std::vector<unsigned int> changedIds;
+    for (auto& [watchId, file] : mFiles)
+    {
+        if (!hasOverflowed && !changedPaths.contains(file.path))
+            continue;
+
+        std::int64_t modifiedTime = GetModifiedTime(file.path);
+        if (modifiedTime == file.modifiedTime)
+            continue;
+
+        file.modifiedTime = modifiedTime;
+        changedIds.push_back(watchId);
+    }
+
+    for (unsigned int watchId : changedIds)
+    {
+        auto file = mFiles.find(watchId);
+        if (file == mFiles.end())
+            continue;
+
+        std::function<void()> onChange = file->second.onChange;
+        onChange();
+    }
+}
+
+#else
+
+FileWatcher::FileWatcher() : mLastScanTime(std::chrono::steady_clock::now()) {}
+
+FileWatcher::~FileWatcher() = default;
+
+unsigned int FileWatcher::Watch(const std::string& path, std::function<void()> onChange)
+{
+    std::string canonicalPath = GetCanonicalPath(path);
+
+    unsigned int watchId = mNextWatchId++;
+    mFiles.emplace(watchId, WatchedFile { canonicalPath, std::move(onChange), GetModifiedTime(canonicalPath) });
+
+    return watchId;
+}
+
+void FileWatcher::Poll()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - mLastScanTime < SCAN_INTERVAL)
+        return;
+
+    mLastScanTime = now;
+
+    std::vector<unsigned int> changedIds;
+    for (auto& [watchId, file] : mFiles)
+    {
+        std::int64_t modifiedTime = GetModifiedTime(file.path);
+        if (modifiedTime == file.modifiedTime)
+            continue;
+
+        file.modifiedTime = modifiedTime;
+        changedIds.push_back(watchId);
+    }
+
+    for (unsigned int watchId : changedIds)
+    {
+        auto file = mFiles.find(watchId);
+        if (file == mFiles.end())
+            continue;
+
+        std::function<void()> onChange = file->second.onChange;
+        onChange();
+    }
+}
+
+#endif
+
+void FileWatcher::Unwatch(const unsigned int watchId)
+{
+    // Directory watches stay, events for files nobody watches any more are ignored
+    mFiles.erase(watchId);
+}
+
+std::string FileWatcher::GetCanonicalPath(const std::string& path)
+{
+    std::error_code error;
+    std::filesystem::path canonicalPath = std::filesystem::weakly_canonical(path, error);
+
+    return error ? std::filesystem::absolute(path, error).lexically_normal().string() : canonicalPath.string();
+}
+
+std::int64_t FileWatcher::GetModifiedTime(const std::string& path)
+{
+    std::error_code error;
+    std::int64_t modifiedTime = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+
+    return error ? 0 : modifiedTime;
+}
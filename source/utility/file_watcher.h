@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Utility
+{
+    /*
+     * Reports writes to watched files so assets are only rebuilt when their source changes. On Linux it
+     * watches the parent directories through inotify, which also catches editors that save by writing a
+     * temporary file and renaming it over the original. Elsewhere it compares modification times
+     */
+    class FileWatcher
+    {
+    public:
+        FileWatcher();
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        // onChange runs inside Poll, once per Poll no matter how many writes happened since the last one
+        unsigned int Watch(const std::string& path, std::function<void()> onChange);
+        void Unwatch(unsigned int watchId);
+
+        // Dispatches the changes seen since the last call without blocking, call once per frame
+        void Poll();
+
+    private:
+        struct WatchedFile
+        {
+            std::string path;
+            std::function<void()> onChange;
+            std::int64_t modifiedTime;
+        };
+
+        static std::string GetCanonicalPath(const std::string& path);
+        static std::int64_t GetModifiedTime(const std::string& path);
+
+        std::unordered_map<unsigned int, WatchedFile> mFiles;
+        unsigned int mNextWatchId = 1;
+
+#ifdef __linux__
+        int mFileDescriptor = -1;
+        // Directory watch descriptors and the directories they belong to
+        std::unordered_map<int, std::string> mDirectories;
+#else
+        std::chrono::steady_clock::time_point mLastScanTime;
+
+        static constexpr std::chrono::milliseconds SCAN_INTERVAL { 500 };
+#endif
+    };
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Utility
+{
+    constexpr std::uint64_t HASH_SEED = 0xcbf29ce484222325ull;
+
+    // 64-bit FNV-1a, usable at compile time. Chain calls by passing the previous hash as seed
+    constexpr std::uint64_t Hash64(const std::string_view data, std::uint64_t seed = HASH_SEED)
+    {
+        for (char character : data)
+        {
+            seed ^= static_cast<unsigned char>(character);
+            seed *= 0x100000001b3ull;
+        }
+
+        return seed;
+    }
+}
@@ -0,0 +1,340 @@
+#include "json.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+
+using Utility::JsonValue;
+
+namespace
+{
+    int ReadHexDigit(const char character)
+    {
+        if (character >= '0' && character <= '9')
+            return character - '0';
+        if (character >= 'a' && character <= 'f')
+            return character - 'a' + 10;
+        if (character >= 'A' && character <= 'F')
+            return character - 'A' + 10;
+
+        return -1;
+    }
+
+    bool ReadCodeUnit(std::string_view& source, std::uint32_t& codeUnit)
+    {
+        if (source.size() < 4)
+            return false;
+
+        codeUnit = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            int digit = ReadHexDigit(source[i]);
+            if (digit < 0)
+                return false;
+
+            codeUnit = codeUnit * 16 + static_cast<std::uint32_t>(digit);
+        }
+
+        source.remove_prefix(4);
+        return true;
+    }
+
+    void AppendUtf8(std::string& string, const std::uint32_t codePoint)
+    {
+        if (codePoint < 0x80)
+            string += static_cast<char>(codePoint);
+        else if (codePoint < 0x800)
+        {
+            string += static_cast<char>(0xC0 | (codePoint >> 6));
+            string += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000)
+        {
+            string += static_cast<char>(0xE0 | (codePoint >> 12));
+            string += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            string += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+            string += static_cast<char>(0xF0 | (codePoint >> 18));
+            string += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            string += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            string += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+}
+
+std::optional<JsonValue> JsonValue::Parse(std::string_view source)
+{
+    JsonValue document;
+    if (!ParseValue(source, document, 0))
+        return std::nullopt;
+
+    // Only whitespace may follow the document
+    SkipWhitespace(source);
+    if (!source.empty())
+        return std::nullopt;
+
+    return document;
+}
+
+JsonValue::Type JsonValue::GetType() const
+{
+    return mType;
+}
+
+bool JsonValue::IsArray() const
+{
+    return mType == Type::Array;
+}
+
+bool JsonValue::IsObject() const
+{
+    return mType == Type::Object;
+}
+
+const JsonValue* JsonValue::Find(const std::string_view key) const
+{
+    for (std::size_t i = 0; i < mKeys.size(); ++i)
+    {
+        if (mKeys[i] == key)
+            return &mElements[i];
+    }
+
+    return nullptr;
+}
+
+std::span<const JsonValue> JsonValue::GetElements() const
+{
+    return mElements;
+}
+
+std::size_t JsonValue::GetSize() const
+{
+    return mElements.size();
+}
+
+double JsonValue::GetNumber(const double fallback) const
+{
+    return mType == Type::Number ? mNumber : fallback;
+}
+
+int JsonValue::GetInt(const int fallback) const
+{
+    return mType == Type::Number ? static_cast<int>(mNumber) : fallback;
+}
+
+bool JsonValue::GetBoolean(const bool fallback) const
+{
+    return mType == Type::Boolean ? mBoolean : fallback;
+}
+
+std::string_view JsonValue::GetString() const
+{
+    return mType == Type::String ? std::string_view(mString) : std::string_view();
+}
+
+double JsonValue::GetNumber(const std::string_view key, const double fallback) const
+{
+    const JsonValue* member = Find(key);
+    return member != nullptr ? member->GetNumber(fallback) : fallback;
+}
+
+int JsonValue::GetInt(const std::string_view key, const int fallback) const
+{
+    const JsonValue* member = Find(key);
+    return member != nullptr ? member->GetInt(fallback) : fallback;
+}
+
+std::string_view JsonValue::GetString(const std::string_view key) const
+{
+    const JsonValue* member = Find(key);
+    return member != nullptr ? member->GetString() : std::string_view();
+}
+
+bool JsonValue::ParseValue(std::string_view& source, JsonValue& value, const int depth)
+{
+    if (depth > MAX_DEPTH)
+        return false;
+
+    SkipWhitespace(source);
+    if (source.empty())
+        return false;
+
+    switch (source.front())
+    {
+        case '{':
+        {
+            value.mType = Type::Object;
+            source.remove_prefix(1);
+            SkipWhitespace(source);
+            if (!source.empty() && source.front() == '}')
+            {
+                source.remove_prefix(1);
+                return true;
+            }
+
+            while (true)
+            {
+                SkipWhitespace(source);
+                std::string& key = value.mKeys.emplace_back();
+                if (!ParseString(source, key))
+                    return false;
+
+                SkipWhitespace(source);
+                if (source.empty() || source.front() != ':')
+                    return false;
+                source.remove_prefix(1);
+
+                if (!ParseValue(source, value.mElements.emplace_back(), depth + 1))
+                    return false;
+
+                SkipWhitespace(source);
+                if (source.empty())
+                    return false;
+                if (source.front() == '}')
+                {
+                    source.remove_prefix(1);
+                    return true;
+                }
+                if (source.front() != ',')
+                    return false;
+                source.remove_prefix(1);
+            }
+        }
+        case '[':
+        {
+            value.mType = Type::Array;
+            source.remove_prefix(1);
+            SkipWhitespace(source);
+            if (!source.empty() && source.front() == ']')
+            {
+                source.remove_prefix(1);
+                return true;
+            }
+
+            while (true)
+            {
+                if (!ParseValue(source, value.mElements.emplace_back(), depth + 1))
+                    return false;
+
+                SkipWhitespace(source);
+                if (source.empty())
+                    return false;
+                if (source.front() == ']')
+                {
+                    source.remove_prefix(1);
+                    return true;
+                }
+                if (source.front() != ',')
+                    return false;
+                source.remove_prefix(1);
+            }
+        }
+        case '"':
+            value.mType = Type::String;
+            return ParseString(source, value.mString);
+        case 't':
+            value.mType = Type::Boolean;
+            value.mBoolean = true;
+            return ParseLiteral(source, "true");
+        case 'f':
+            value.mType = Type::Boolean;
+            return ParseLiteral(source, "false");
+        case 'n':
+            return ParseLiteral(source, "null");
+        default:
+            value.mType = Type::Number;
+            return ParseNumber(source, value.mNumber);
+    }
+}
+
+bool JsonValue::ParseString(std::string_view& source, std::string& string)
+{
+    if (source.empty() || source.front() != '"')
+        return false;
+    source.remove_prefix(1);
+
+    while (!source.empty())
+    {
+        // Copy the run up to the next quote or escape in one go
+        std::size_t runLength = source.find_first_of("\"\\");
+        if (runLength == std::string_view::npos)
+            return false;
+
+        string.append(source.substr(0, runLength));
+        char terminator = source[runLength];
+        source.remove_prefix(runLength + 1);
+
+        if (terminator == '"')
+            return true;
+        if (source.empty())
+            return false;
+
+        char escape = source.front();
+        source.remove_prefix(1);
+        switch (escape)
+        {
+            case '"':   string += '"';  break;
+            case '\\':  string += '\\'; break;
+            case '/':   string += '/';  break;
+            case 'b':   string += '\b'; break;
+            case 'f':   string += '\f'; break;
+            case 'n':   string += '\n'; break;
+            case 'r':   string += '\r'; break;
+            case 't':   string += '\t'; break;
+            case 'u':
+            {
+                std::uint32_t codePoint;
+                if (!ReadCodeUnit(source, codePoint))
+                    return false;
+
+                // A high surrogate has to be followed by an escaped low one
+                if (codePoint >= 0xD800 && codePoint < 0xDC00)
+                {
+                    std::uint32_t lowSurrogate;
+                    if (source.size() < 2 || source[0] != '\\' || source[1] != 'u')
+                        return false;
+                    source.remove_prefix(2);
+                    if (!ReadCodeUnit(source, lowSurrogate) || lowSurrogate < 0xDC00 || lowSurrogate >= 0xE000)
+                        return false;
+
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                }
+
+                AppendUtf8(string, codePoint);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+
+    return false;
+}
+
+bool JsonValue::ParseNumber(std::string_view& source, double& number)
+{
+    // from_chars takes no leading plus, which JSON does not allow either
+    auto [end, error] = std::from_chars(source.data(), source.data() + source.size(), number);
+    if (error != std::errc() || !std::isfinite(number))
+        return false;
+
+    source.remove_prefix(static_cast<std::size_t>(end - source.data()));
+    return true;
+}
+
+bool JsonValue::ParseLiteral(std::string_view& source, const std::string_view literal)
+{
+    if (!source.starts_with(literal))
+        return false;
+
+    source.remove_prefix(literal.size());
+    return true;
+}
+
+void JsonValue::SkipWhitespace(std::string_view& source)
+{
+    std::size_t length = source.find_first_not_of(" \t\n\r");
+    source.remove_prefix(length == std::string_view::npos ? source.size() : length);
+}
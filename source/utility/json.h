@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Utility
+{
+    // Node of a parsed JSON document. Object members keep their file order and are found by a linear search,
+    // which suits the small objects of asset descriptions
+    class JsonValue
+    {
+    public:
+        enum class Type
+        {
+            Null,
+            Boolean,
+            Number,
+            String,
+            Array,
+            Object
+        };
+
+        // Nothing on malformed input or nesting deeper than MAX_DEPTH
+        static std::optional<JsonValue> Parse(std::string_view source);
+
+        Type GetType() const;
+        bool IsArray() const;
+        bool IsObject() const;
+
+        // Member of an object, nullptr when this is not an object or has no such member
+        const JsonValue* Find(std::string_view key) const;
+        // Elements of an array or member values of an object, empty for anything else
+        std::span<const JsonValue> GetElements() const;
+        std::size_t GetSize() const;
+
+        // The fallback when the value has another type
+        double GetNumber(double fallback = 0.0) const;
+        int GetInt(int fallback = 0) const;
+        bool GetBoolean(bool fallback = false) const;
+        std::string_view GetString() const;
+
+        // Shorthands for a member of an object, the fallback also covers a missing member
+        double GetNumber(std::string_view key, double fallback) const;
+        int GetInt(std::string_view key, int fallback) const;
+        std::string_view GetString(std::string_view key) const;
+
+        static constexpr int MAX_DEPTH = 64;
+
+    private:
+        static bool ParseValue(std::string_view& source, JsonValue& value, int depth);
+        static bool ParseString(std::string_view& source, std::string& string);
+        static bool ParseNumber(std::string_view& source, double& number);
+        static bool ParseLiteral(std::string_view& source, std::string_view literal);
+        static void SkipWhitespace(std::string_view& source);
+
+        Type mType = Type::Null;
+        bool mBoolean = false;
+        double mNumber = 0.0;
+        std::string mString;
+        std::vector<JsonValue> mElements;
+        // Parallel to mElements for objects
+        std::vector<std::string> mKeys;
+    };
+}
@@ -0,0 +1,178 @@
+#include "mapped_file.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using Utility::MappedFile;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const char* path)
+{
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    mFileHandle = file;
+    mSize = static_cast<std::size_t>(fileSize.QuadPart);
+    mIsOpen = true;
+
+    if (mSize == 0)
+        return;
+
+    mMappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mMappingHandle != nullptr)
+        mData = static_cast<const char*>(MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0));
+
+    if (mData == nullptr)
+        Close();
+}
+
+void MappedFile::Close()
+{
+    if (mData != nullptr)
+        UnmapViewOfFile(mData);
+    if (mMappingHandle != nullptr)
+        CloseHandle(mMappingHandle);
+    if (mFileHandle != nullptr)
+        CloseHandle(mFileHandle);
+
+    mData = nullptr;
+    mMappingHandle = nullptr;
+    mFileHandle = nullptr;
+    mSize = 0;
+    mIsOpen = false;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mData(std::exchange(other.mData, nullptr)), mSize(std::exchange(other.mSize, 0)),
+      mIsOpen(std::exchange(other.mIsOpen, false)),
+      mFileHandle(std::exchange(other.mFileHandle, nullptr)), mMappingHandle(std::exchange(other.mMappingHandle, nullptr))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+        mIsOpen = std::exchange(other.mIsOpen, false);
+        mFileHandle = std::exchange(other.mFileHandle, nullptr);
+        mMappingHandle = std::exchange(other.mMappingHandle, nullptr);
+    }
+
+    return *this;
+}
+
+#else
+
+MappedFile::MappedFile(const char* path)
+{
+    int fileDescriptor = open(path, O_RDONLY);
+    if (fileDescriptor < 0)
+        return;
+
+    struct stat fileStats {};
+    if (fstat(fileDescriptor, &fileStats) != 0)
+    {
+        close(fileDescriptor);
+        return;
+    }
+
+    mFileDescriptor = fileDescriptor;
+    mSize = static_cast<std::size_t>(fileStats.st_size);
+    mIsOpen = true;
+
+    if (mSize == 0)
+        return;
+
+    void* mapping = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, mFileDescriptor, 0);
+    if (mapping == MAP_FAILED)
+    {
+        Close();
+        return;
+    }
+
+    madvise(mapping, mSize, MADV_SEQUENTIAL);
+    mData = static_cast<const char*>(mapping);
+}
+
+void MappedFile::Close()
+{
+    if (mData != nullptr)
+        munmap(const_cast<char*>(mData), mSize);
+    if (mFileDescriptor >= 0)
+        close(mFileDescriptor);
+
+    mData = nullptr;
+    mFileDescriptor = -1;
+    mSize = 0;
+    mIsOpen = false;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mData(std::exchange(other.mData, nullptr)), mSize(std::exchange(other.mSize, 0)),
+      mIsOpen(std::exchange(other.mIsOpen, false)), mFileDescriptor(std::exchange(other.mFileDescriptor, -1))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+        mIsOpen = std::exchange(other.mIsOpen, false);
+        mFileDescriptor = std::exchange(other.mFileDescriptor, -1);
+    }
+
+    return *this;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::IsOpen() const
+{
+    return mIsOpen;
+}
+
+const char* MappedFile::Data() const
+{
+    return mData;
+}
+
+std::size_t MappedFile::Size() const
+{
+    return mSize;
+}
+
+std::string_view MappedFile::View() const
+{
+    return mData != nullptr ? std::string_view(mData, mSize) : std::string_view();
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace Utility
+{
+    // Read-only memory mapping of a whole file. The view stays valid for the lifetime of the object.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const char* path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool IsOpen() const;
+        const char* Data() const;
+        std::size_t Size() const;
+        std::string_view View() const;
+
+    private:
+        void Close();
+
+        const char* mData = nullptr;
+        std::size_t mSize = 0;
+        bool mIsOpen = false;
+
+#ifdef _WIN32
+        void* mFileHandle = nullptr;
+        void* mMappingHandle = nullptr;
+#else
+        int mFileDescriptor = -1;
+#endif
+    };
+}
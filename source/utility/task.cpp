@@ -0,0 +1,22 @@
+#include "task.h"
+
+using Utility::ResumeQueue;
+
+void ResumeQueue::Post(const std::coroutine_handle<> handle)
+{
+    std::lock_guard lock(mMutex);
+    mHandles.push_back(handle);
+}
+
+void ResumeQueue::ResumeAll()
+{
+    // Coroutines posting again while they run wait for the next call
+    std::vector<std::coroutine_handle<>> handles;
+    {
+        std::lock_guard lock(mMutex);
+        handles.swap(mHandles);
+    }
+
+    for (std::coroutine_handle<> handle : handles)
+        handle.resume();
+}
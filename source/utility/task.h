@@ -0,0 +1,180 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.h"
+
+namespace Utility
+{
+    // Coroutines waiting to continue on the thread that owns the queue, usually the GL thread
+    class ResumeQueue
+    {
+    public:
+        // Safe from any thread
+        void Post(std::coroutine_handle<> handle);
+        // Continues every coroutine posted before the call, on the calling thread
+        void ResumeAll();
+
+    private:
+        std::mutex mMutex;
+        std::vector<std::coroutine_handle<>> mHandles;
+    };
+
+    /*
+     * Result of a coroutine that starts running as soon as it is called. Awaiting it from another coroutine
+     * continues that coroutine on whichever thread the task finishes on. The task owns the coroutine frame, so
+     * it has to outlive the coroutine's last suspension
+     */
+    template<typename T>
+    class Task
+    {
+    public:
+        struct promise_type;
+
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+            void await_resume() const noexcept {}
+        };
+
+        struct promise_type
+        {
+            std::optional<T> result;
+            std::exception_ptr exception;
+            std::coroutine_handle<> continuation;
+
+            Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_never initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+            void unhandled_exception() { exception = std::current_exception(); }
+
+            template<typename Value>
+            void return_value(Value&& value) { result.emplace(std::forward<Value>(value)); }
+        };
+
+        Task(Task&& other) noexcept : mHandle(std::exchange(other.mHandle, nullptr)) {}
+        Task& operator=(Task&& other) noexcept;
+        ~Task();
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        bool IsReady() const;
+        // Rethrows what escaped the coroutine, only valid once IsReady
+        T& GetResult();
+
+        auto operator co_await() noexcept;
+
+    private:
+        explicit Task(const std::coroutine_handle<promise_type> handle) : mHandle(handle) {}
+
+        std::coroutine_handle<promise_type> mHandle;
+    };
+
+    // Runs function on the shared thread pool, the awaiting coroutine continues from the queue with its result
+    template<typename Function>
+    class ThreadPoolAwaitable
+    {
+    public:
+        using Result = std::invoke_result_t<Function>;
+
+        ThreadPoolAwaitable(ResumeQueue& resumeQueue, Function function)
+            : mResumeQueue(resumeQueue), mFunction(std::move(function)) {}
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        Result await_resume() { return std::move(*mResult); }
+
+    private:
+        ResumeQueue& mResumeQueue;
+        Function mFunction;
+        std::optional<Result> mResult;
+    };
+
+    template<typename Function>
+    ThreadPoolAwaitable<Function> RunOnThreadPool(ResumeQueue& resumeQueue, Function function)
+    {
+        return ThreadPoolAwaitable<Function>(resumeQueue, std::move(function));
+    }
+
+    template<typename T>
+    std::coroutine_handle<> Task<T>::FinalAwaiter::await_suspend(const std::coroutine_handle<promise_type> handle) noexcept
+    {
+        std::coroutine_handle<> continuation = handle.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+    }
+
+    template<typename T>
+    Task<T>& Task<T>::operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (mHandle)
+                mHandle.destroy();
+            mHandle = std::exchange(other.mHandle, nullptr);
+        }
+
+        return *this;
+    }
+
+    template<typename T>
+    Task<T>::~Task()
+    {
+        if (mHandle)
+            mHandle.destroy();
+    }
+
+    template<typename T>
+    bool Task<T>::IsReady() const
+    {
+        return mHandle && mHandle.done();
+    }
+
+    template<typename T>
+    T& Task<T>::GetResult()
+    {
+        if (mHandle.promise().exception)
+            std::rethrow_exception(mHandle.promise().exception);
+
+        return *mHandle.promise().result;
+    }
+
+    template<typename T>
+    auto Task<T>::operator co_await() noexcept
+    {
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return handle.done(); }
+            void await_suspend(const std::coroutine_handle<> awaiting) const noexcept { handle.promise().continuation = awaiting; }
+
+            T await_resume() const
+            {
+                if (handle.promise().exception)
+                    std::rethrow_exception(handle.promise().exception);
+
+                return std::move(*handle.promise().result);
+            }
+        };
+
+        return Awaiter { mHandle };
+    }
+
+    template<typename Function>
+    void ThreadPoolAwaitable<Function>::await_suspend(const std::coroutine_handle<> handle)
+    {
+        ThreadPool::GetShared().Submit([this, handle]
+        {
+            mResult.emplace(mFunction());
+            mResumeQueue.Post(handle);
+        });
+    }
+}
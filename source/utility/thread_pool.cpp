@@ -0,0 +1,109 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+
+using Utility::ThreadPool;
+
+ThreadPool::ThreadPool(const unsigned int threadCount)
+{
+    unsigned int workerCount = std::max(1u, threadCount);
+    mWorkers.reserve(workerCount);
+
+    for (unsigned int i = 0; i < workerCount; ++i)
+        mWorkers.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(mMutex);
+        mIsStopping = true;
+    }
+    mCondition.notify_all();
+
+    for (std::thread& worker : mWorkers)
+        worker.join();
+}
+
+void ThreadPool::ParallelFor(const std::size_t count, const std::function<void(std::size_t)>& function)
+{
+    if (count == 0)
+        return;
+
+    // Helpers that start after the caller has drained every index simply find no work,
+    // so the shared state must outlive this call
+    struct ParallelForState
+    {
+        std::function<void(std::size_t)> function;
+        std::size_t count;
+        std::atomic<std::size_t> nextIndex = 0;
+        std::atomic<std::size_t> completedCount = 0;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    auto state = std::make_shared<ParallelForState>();
+    state->function = function;
+    state->count = count;
+
+    auto work = [state]
+    {
+        for (std::size_t i = state->nextIndex++; i < state->count; i = state->nextIndex++)
+        {
+            state->function(i);
+
+            if (++state->completedCount == state->count)
+            {
+                std::lock_guard lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    std::size_t helperCount = std::min<std::size_t>(count - 1, mWorkers.size());
+    {
+        std::lock_guard lock(mMutex);
+        for (std::size_t i = 0; i < helperCount; ++i)
+            mTasks.emplace_back(work);
+    }
+    mCondition.notify_all();
+
+    work();
+
+    std::unique_lock lock(state->mutex);
+    state->finished.wait(lock, [&state] { return state->completedCount == state->count; });
+}
+
+unsigned int ThreadPool::GetThreadCount() const
+{
+    return static_cast<unsigned int>(mWorkers.size());
+}
+
+ThreadPool& ThreadPool::GetShared()
+{
+    static ThreadPool sharedPool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+
+    return sharedPool;
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock lock(mMutex);
+            mCondition.wait(lock, [this] { return mIsStopping || !mTasks.empty(); });
+
+            if (mIsStopping && mTasks.empty())
+                return;
+
+            task = std::move(mTasks.front());
+            mTasks.pop_front();
+        }
+
+        task();
+    }
+}
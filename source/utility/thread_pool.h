@@ -0,0 +1,61 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Utility
+{
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(unsigned int threadCount);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        template<typename Function>
+        std::future<std::invoke_result_t<Function>> Submit(Function&& function);
+
+        // Runs function(i) for every i in [0, count) and blocks until all calls have returned
+        void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& function);
+
+        unsigned int GetThreadCount() const;
+
+        // Engine-wide pool sized to the hardware, created on first use
+        static ThreadPool& GetShared();
+
+    private:
+        void WorkerLoop();
+
+        std::vector<std::thread> mWorkers;
+        std::deque<std::function<void()>> mTasks;
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        bool mIsStopping = false;
+    };
+
+    template<typename Function>
+    std::future<std::invoke_result_t<Function>> ThreadPool::Submit(Function&& function)
+    {
+        using Result = std::invoke_result_t<Function>;
+
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+        std::future<Result> result = task->get_future();
+
+        {
+            std::lock_guard lock(mMutex);
+            mTasks.emplace_back([task] { (*task)(); });
+        }
+        mCondition.notify_one();
+
+        return result;
+    }
+}
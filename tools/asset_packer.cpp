@@ -0,0 +1,19 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../source/assets/asset_pack.h"
+
+// Usage: MarsEngineAssetPacker <pack path> <root> <directory>...
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        std::cout << "Usage: " << argv[0] << " <pack path> <root> <directory>..." << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> directories(argv + 3, argv + argc);
+
+    return Assets::AssetPack::Build(argv[1], argv[2], directories) ? 0 : 1;
+}